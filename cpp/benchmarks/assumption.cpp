@@ -0,0 +1,296 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/columnar.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+typedef FloatWrapperHolderAssumption::Id Id;
+typedef FloatWrapperHolderAssumption::Index Index;
+typedef FloatWrapperHolderAssumption::Array Array;
+typedef FloatWrapperHolderAssumption::WrapperArray WrapperArray;
+typedef FloatWrapperHolderAssumption::HolderPtr HolderPtr;
+
+namespace
+{
+
+const Index ArraySize = 8;
+
+//! The ordered container layout the assumption used before the hash table
+/*! One ordered container for each of the id set, the value arrays,
+ *  the wrapper arrays and the holders.
+ */
+class MapLayout
+{
+public:
+  void insert(const Id& id, Array& a, WrapperArray& wrapper, HolderPtr& holder)
+  {
+    this->id_set_.insert(id);
+    this->array_map_[id] = std::move(a);
+    this->wrapper_array_map_[id] = std::move(wrapper);
+    this->holder_map_[id] = std::move(holder);
+  }
+  bool has(const Id& id)
+  {
+    return this->id_set_.find(id) != this->id_set_.end();
+  }
+  float& value(const Id& id, const Index& index)
+  {
+    return this->array_map_[id][index];
+  }
+  FloatWrapper& wrapper(const Id& id, const Index& index)
+  {
+    return this->wrapper_array_map_[id][index];
+  }
+  FloatHolder& holder(const Id& id) { return *this->holder_map_[id]; }
+private:
+  std::map<Id, Array> array_map_;
+  std::map<Id, WrapperArray> wrapper_array_map_;
+  std::map<Id, HolderPtr> holder_map_;
+  std::set<Id> id_set_;
+};
+
+std::vector<Id> make_ids(const size_t& count)
+{
+  std::vector<Id> ids;
+  ids.reserve(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    ids.push_back("sensor/" + std::to_string(i) + "/value");
+  }
+  return ids;
+}
+
+template<typename A> void populate(A& assumption, const std::vector<Id>& ids)
+{
+  for (const Id& id : ids)
+  {
+    Array a = std::make_unique<float[]>(ArraySize);
+    WrapperArray wrapper = std::make_unique<FloatWrapper[]>(ArraySize);
+    HolderPtr holder = std::make_unique<FloatHolder>(ArraySize);
+    assumption.insert(id, a, wrapper, holder);
+  }
+}
+
+template<typename A> void BM_Register(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  for (auto _ : state)
+  {
+    A assumption;
+    populate(assumption, ids);
+    benchmark::DoNotOptimize(&assumption);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Create(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  for (auto _ : state)
+  {
+    FloatWrapperHolderAssumption assumption;
+    for (const Id& id : ids)
+    {
+      assumption.create(id, ArraySize);
+    }
+    benchmark::DoNotOptimize(&assumption);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CreateMany(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  FloatWrapperHolderAssumption::Batch batch;
+  for (const Id& id : ids)
+  {
+    batch.push_back(FloatWrapperHolderAssumption::Entry(id, ArraySize));
+  }
+  for (auto _ : state)
+  {
+    FloatWrapperHolderAssumption assumption;
+    assumption.create_many(batch);
+    benchmark::DoNotOptimize(&assumption);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename A> void BM_Has(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  A assumption;
+  populate(assumption, ids);
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(assumption.has(ids[i]));
+    if (++i == ids.size())
+    {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/* Reading both a value and its wrapper is the common access pattern */
+template<typename A> void BM_ValueAndWrapper(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  A assumption;
+  populate(assumption, ids);
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const Id& id = ids[i];
+    benchmark::DoNotOptimize(assumption.value(id, 3));
+    benchmark::DoNotOptimize(assumption.wrapper(id, 3).is_set());
+    if (++i == ids.size())
+    {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ValueAndWrapperByHandle(benchmark::State& state)
+{
+  typedef FloatWrapperHolderAssumption::Handle Handle;
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  FloatWrapperHolderAssumption assumption;
+  populate(assumption, ids);
+  std::vector<Handle> handles;
+  for (const Id& id : ids)
+  {
+    handles.push_back(assumption.resolve(id));
+  }
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    const Handle& handle = handles[i];
+    benchmark::DoNotOptimize(assumption.value(handle, 3));
+    benchmark::DoNotOptimize(assumption.wrapper(handle, 3).is_set());
+    if (++i == handles.size())
+    {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template<typename A> void BM_Holder(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  A assumption;
+  populate(assumption, ids);
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(assumption.holder(ids[i]).size());
+    if (++i == ids.size())
+    {
+      i = 0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/* Sum every set value of every id */
+void BM_ScanWrappers(benchmark::State& state)
+{
+  typedef FloatWrapperHolderAssumption::Handle Handle;
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  FloatWrapperHolderAssumption assumption;
+  FloatWrapperHolderAssumption::Batch batch;
+  for (const Id& id : ids)
+  {
+    batch.push_back(FloatWrapperHolderAssumption::Entry(id, ArraySize));
+  }
+  assumption.create_many(batch);
+  std::vector<Handle> handles;
+  for (const Id& id : ids)
+  {
+    handles.push_back(assumption.resolve(id));
+    assumption.wrapper(handles.back(), 1) = FloatWrapper(1.0f);
+  }
+  for (auto _ : state)
+  {
+    float sum = 0.0f;
+    for (const Handle& handle : handles)
+    {
+      for (Index i = 0; i < ArraySize; i++)
+      {
+        const FloatWrapper& wrapper = assumption.wrapper(handle, i);
+        if (wrapper.is_set())
+        {
+          sum += wrapper.value();
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * ArraySize);
+}
+
+void BM_ScanColumns(benchmark::State& state)
+{
+  typedef gos::assumption::ColumnarAssumption<float> Columns;
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  Columns columns;
+  Columns::Batch batch;
+  for (const Id& id : ids)
+  {
+    batch.push_back(Columns::Entry(id, ArraySize));
+  }
+  columns.create_many(batch);
+  for (const Id& id : ids)
+  {
+    columns.set(columns.resolve(id), 1, 1.0f);
+  }
+  for (auto _ : state)
+  {
+    /* Unset values are zero so the set flags need not be consulted */
+    float sum = 0.0f;
+    for (const float& value : columns.arena())
+    {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * ArraySize);
+}
+
+} /* namespace */
+
+BENCHMARK_TEMPLATE(BM_Register, MapLayout)
+  ->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Register, FloatWrapperHolderAssumption)
+  ->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Create)
+  ->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CreateMany)
+  ->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Has, MapLayout)
+  ->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Has, FloatWrapperHolderAssumption)
+  ->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_ValueAndWrapper, MapLayout)
+  ->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_ValueAndWrapper, FloatWrapperHolderAssumption)
+  ->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(BM_ValueAndWrapperByHandle)
+  ->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(BM_ScanWrappers)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(BM_ScanColumns)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Holder, MapLayout)
+  ->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Holder, FloatWrapperHolderAssumption)
+  ->RangeMultiplier(10)->Range(10, 1000000);
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/concurrent.h>
+#include <gos/assumption/snapshot.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::ConcurrentAssumption<float, FloatWrapper, FloatHolder>
+  ConcurrentFloatAssumption;
+typedef gos::assumption::SnapshotAssumption<float, FloatWrapper, FloatHolder>
+  SnapshotFloatAssumption;
+
+namespace
+{
+
+const size_t Count = 100000;
+const ConcurrentFloatAssumption::Size ArraySize = 8;
+
+//! An assumption behind one global reader writer lock for comparison
+class GlobalLock
+{
+public:
+  typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+    Assumption;
+  void create_many(const Assumption::Batch& batch)
+  {
+    std::unique_lock<std::shared_mutex> lock(this->mutex_);
+    this->assumption_.create_many(batch);
+  }
+  float value(const Assumption::Key& id, const Assumption::Index& index) const
+  {
+    std::shared_lock<std::shared_mutex> lock(this->mutex_);
+    const float* value = this->assumption_.find_value(id, index);
+    return value != nullptr ? *value : 0.0f;
+  }
+  bool set_value(
+    const Assumption::Key& id,
+    const Assumption::Index& index,
+    const float& value)
+  {
+    std::unique_lock<std::shared_mutex> lock(this->mutex_);
+    float* target = this->assumption_.find_value(id, index);
+    if (target != nullptr)
+    {
+      *target = value;
+    }
+    return target != nullptr;
+  }
+private:
+  mutable std::shared_mutex mutex_;
+  Assumption assumption_;
+};
+
+const std::vector<std::string>& ids()
+{
+  static const std::vector<std::string> ids = []()
+  {
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < Count; i++)
+    {
+      ids.push_back("rig/" + std::to_string(i) + "/hookload");
+    }
+    return ids;
+  }();
+  return ids;
+}
+
+/* The ids are visited in a shuffled order so the insertion order of the
+ * records does not favour either layout */
+const std::vector<size_t>& order()
+{
+  static const std::vector<size_t> order = []()
+  {
+    std::vector<size_t> order(Count);
+    for (size_t i = 0; i < Count; i++)
+    {
+      order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(Count));
+    return order;
+  }();
+  return order;
+}
+
+template<typename A> A& registry()
+{
+  static A* registry = []()
+  {
+    A* registry = new A();
+    ConcurrentFloatAssumption::Batch batch;
+    for (const std::string& id : ids())
+    {
+      batch.push_back(ConcurrentFloatAssumption::Entry(id, ArraySize));
+    }
+    registry->create_many(batch);
+    return registry;
+  }();
+  return *registry;
+}
+
+/* The argument is the percentage of reads, the rest are writes */
+template<typename A> void BM_Mixed(benchmark::State& state)
+{
+  A& assumption = registry<A>();
+  const std::vector<std::string>& keys = ids();
+  const std::vector<size_t>& visits = order();
+  const int reads = static_cast<int>(state.range(0));
+  /* Every thread starts at its own place in the visiting order */
+  size_t i = static_cast<size_t>(state.thread_index()) * (Count / 16);
+  int operation = 0;
+  for (auto _ : state)
+  {
+    const std::string& id = keys[visits[i % Count]];
+    if (operation < reads)
+    {
+      benchmark::DoNotOptimize(assumption.value(id, 1));
+    }
+    else
+    {
+      assumption.set_value(id, 1, static_cast<float>(i));
+    }
+    operation = operation == 99 ? 0 : operation + 1;
+    i++;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/* Read only lookups, a snapshot is taken for every lookup */
+void BM_SnapshotRead(benchmark::State& state)
+{
+  static SnapshotFloatAssumption* registry = []()
+  {
+    SnapshotFloatAssumption* registry = new SnapshotFloatAssumption(256);
+    SnapshotFloatAssumption::Batch batch;
+    for (const std::string& id : ids())
+    {
+      batch.push_back(SnapshotFloatAssumption::Entry(id, ArraySize));
+    }
+    registry->create_many(batch);
+    return registry;
+  }();
+  const std::vector<std::string>& keys = ids();
+  const std::vector<size_t>& visits = order();
+  SnapshotFloatAssumption::Reader reader = registry->reader();
+  size_t i = static_cast<size_t>(state.thread_index()) * (Count / 16);
+  for (auto _ : state)
+  {
+    SnapshotFloatAssumption::Snapshot snapshot = reader.snapshot();
+    benchmark::DoNotOptimize(
+      snapshot.find_value(keys[visits[i % Count]], 1));
+    i++;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+int max_threads()
+{
+  return static_cast<int>(std::max(4u, std::thread::hardware_concurrency()));
+}
+
+} /* namespace */
+
+BENCHMARK_TEMPLATE(BM_Mixed, GlobalLock)
+  ->Arg(50)->Arg(90)->Arg(99)->Arg(100)
+  ->ThreadRange(1, max_threads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Mixed, ConcurrentFloatAssumption)
+  ->Arg(50)->Arg(90)->Arg(99)->Arg(100)
+  ->ThreadRange(1, max_threads())->UseRealTime();
+BENCHMARK(BM_SnapshotRead)->ThreadRange(1, max_threads())->UseRealTime();
@@ -0,0 +1,109 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef FloatHolder::Index Index;
+
+namespace
+{
+
+//! Wrappers where every other one is set
+std::unique_ptr<FloatWrapper[]> make_wrappers(const size_t& count)
+{
+  std::unique_ptr<FloatWrapper[]> wrappers =
+    std::make_unique<FloatWrapper[]>(count);
+  for (size_t i = 0; i < count; i += 2)
+  {
+    wrappers[i] = FloatWrapper(static_cast<float>(i + 1));
+  }
+  return wrappers;
+}
+
+//! The set check of every wrapper in an array
+/*! The cost depends on the set check option the library is built with */
+void BM_WrapperIsSet(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::unique_ptr<FloatWrapper[]> wrappers = make_wrappers(count);
+  for (auto _ : state)
+  {
+    size_t set = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      set += wrappers[i].is_set();
+    }
+    benchmark::DoNotOptimize(set);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! The value of every set wrapper in an array
+void BM_WrapperValue(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::unique_ptr<FloatWrapper[]> wrappers = make_wrappers(count);
+  for (auto _ : state)
+  {
+    float sum = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      if (wrappers[i].is_set())
+      {
+        sum += wrappers[i].value();
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Every item of an array holder by index
+void BM_ArrayHolderGet(benchmark::State& state)
+{
+  const Index count = static_cast<Index>(state.range(0));
+  FloatHolder holder(count);
+  for (Index i = 0; i < count; i += 2)
+  {
+    holder.get(i) = FloatWrapper(static_cast<float>(i + 1));
+  }
+  for (auto _ : state)
+  {
+    float sum = 0;
+    for (Index i = 0; i < holder.size(); i++)
+    {
+      sum += holder.get(i).value();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Every item of an array holder through the pointer of the first item
+void BM_ArrayHolderPointer(benchmark::State& state)
+{
+  const Index count = static_cast<Index>(state.range(0));
+  FloatHolder holder(count);
+  for (auto _ : state)
+  {
+    const FloatWrapper* wrapper = holder.pointer(0);
+    float sum = 0;
+    for (Index i = 0; i < count; i++)
+    {
+      sum += wrapper[i].value();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} /* namespace */
+
+BENCHMARK(BM_WrapperIsSet)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_WrapperValue)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_ArrayHolderGet)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_ArrayHolderPointer)->RangeMultiplier(16)->Range(16, 1 << 20);
@@ -0,0 +1,233 @@
+#include <cstdint>
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+#include <boost/endian/conversion.hpp>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/endian.h>
+#include <gos/assumption/view.h>
+
+namespace
+{
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+namespace endian = ::boost::endian;
+
+/* The array helpers of the boost tests, one value at a time. The spirit
+ * endian functions the tests use were replaced by Boost.Endian in newer
+ * boost versions, the loads and stores are the same */
+
+void* store_big_endian_array(void* pointer, const float* values, size_t count)
+{
+  char* local = (char*)pointer;
+  for (size_t i = 0; i < count; i++)
+  {
+    endian::endian_store<float, sizeof(float), endian::order::big>(
+      (unsigned char*)local, values[i]);
+    local += sizeof(float);
+  }
+  return (void*)local;
+}
+
+void* load_little_endian_array(const void* pointer, float* values, size_t count)
+{
+  char* local = (char*)pointer;
+  for (size_t i = 0; i < count; i++)
+  {
+    *values = endian::endian_load<float, sizeof(float),
+      endian::order::little>((const unsigned char*)local);
+    local += sizeof(float);
+    values++;
+  }
+  return (void*)local;
+}
+
+void* load_big_endian_array(const void* pointer, float* values, size_t count)
+{
+  char* local = (char*)pointer;
+  for (size_t i = 0; i < count; i++)
+  {
+    *values = endian::endian_load<float, sizeof(float),
+      endian::order::big>((const unsigned char*)local);
+    local += sizeof(float);
+    values++;
+  }
+  return (void*)local;
+}
+
+#endif
+
+template<typename T> std::vector<T> make_values(const size_t& count)
+{
+  std::vector<T> values(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    values[i] = static_cast<T>(i * 3);
+  }
+  return values;
+}
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+void BM_StoreBigEndianArray(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::vector<float> values = make_values<float>(count);
+  std::vector<char> buffer(count * sizeof(float));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+      store_big_endian_array(buffer.data(), values.data(), count));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * sizeof(float));
+}
+
+void BM_LoadBigEndianArray(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<float> values = make_values<float>(count);
+  std::vector<char> buffer(count * sizeof(float));
+  store_big_endian_array(buffer.data(), values.data(), count);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+      load_big_endian_array(buffer.data(), values.data(), count));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * sizeof(float));
+}
+
+void BM_LoadLittleEndianArray(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<float> values = make_values<float>(count);
+  std::vector<char> buffer(count * sizeof(float));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+      load_little_endian_array(buffer.data(), values.data(), count));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * sizeof(float));
+}
+
+#endif
+
+//! Load big endian values with the detected kernel
+template<typename T> void BM_LoadBigEndian(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<T> values = make_values<T>(count);
+  /* One byte in to measure the unaligned case a frame usually is */
+  std::vector<unsigned char> buffer(1 + count * sizeof(T));
+  gos::assumption::endian::store_big_endian_array(
+    buffer.data() + 1, values.data(), count);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(gos::assumption::endian::load_big_endian_array(
+      buffer.data() + 1, values.data(), count));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+
+//! Swap values in place with a chosen kernel
+template<typename T, gos::assumption::endian::Kernel K>
+void BM_Swap(benchmark::State& state)
+{
+  if (!gos::assumption::endian::supports(K))
+  {
+    state.SkipWithError("The kernel is not supported");
+    return;
+  }
+  const size_t count = static_cast<size_t>(state.range(0));
+  std::vector<T> values = make_values<T>(count);
+  for (auto _ : state)
+  {
+    gos::assumption::endian::swap<T>(values.data(), values.data(), count, K);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+
+//! The size of the frame fields are read from
+const size_t FrameSize = 64 * 1024;
+//! The fields read out of a frame
+const size_t Fields[] = { 3, 17, 512, 4000, 9001, 12345, 16000, 16383 };
+
+//! Read a few fields of a frame by converting the whole frame first
+void BM_FrameFieldsConvert(benchmark::State& state)
+{
+  const size_t count = FrameSize / sizeof(float);
+  std::vector<float> values = make_values<float>(count);
+  std::vector<unsigned char> frame(FrameSize);
+  gos::assumption::endian::store_big_endian_array(
+    frame.data(), values.data(), count);
+  for (auto _ : state)
+  {
+    gos::assumption::endian::load_big_endian_array(
+      frame.data(), values.data(), count);
+    float sum = 0;
+    for (const size_t& field : Fields)
+    {
+      sum += values[field];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(Fields));
+}
+
+//! Read a few fields of a frame through a view
+void BM_FrameFieldsView(benchmark::State& state)
+{
+  const size_t count = FrameSize / sizeof(float);
+  const std::vector<float> values = make_values<float>(count);
+  std::vector<unsigned char> frame(FrameSize);
+  gos::assumption::endian::store_big_endian_array(
+    frame.data(), values.data(), count);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(frame.data());
+    const gos::assumption::endian::View<float,
+      gos::assumption::endian::Order::Big> view(frame.data(), count);
+    float sum = 0;
+    for (const size_t& field : Fields)
+    {
+      sum += view[field];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * std::size(Fields));
+}
+
+} /* namespace */
+
+using gos::assumption::endian::Kernel;
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+BENCHMARK(BM_StoreBigEndianArray)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_LoadBigEndianArray)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_LoadLittleEndianArray)->RangeMultiplier(16)->Range(16, 1 << 20);
+#endif
+BENCHMARK_TEMPLATE(BM_LoadBigEndian, float)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LoadBigEndian, double)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LoadBigEndian, std::int16_t)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LoadBigEndian, std::int32_t)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Swap, std::uint32_t, Kernel::Scalar)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Swap, std::uint32_t, Kernel::Ssse3)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Swap, std::uint32_t, Kernel::Avx2)
+  ->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_FrameFieldsConvert);
+BENCHMARK(BM_FrameFieldsView);
@@ -0,0 +1,87 @@
+#include <cstdint>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/frame.h>
+#include <gos/assumption/machine.h>
+
+namespace ga = ::gos::assumption;
+namespace gsm = ::gos::assumption::state_machine;
+
+namespace
+{
+
+//! The floats of a decoded frame
+const size_t Values = 256;
+
+//! Start engines and take them to the stage waiting for data
+void start(std::vector<gsm::TableEngine>& engines)
+{
+  gsm::Stage stage;
+  for (gsm::TableEngine& engine : engines)
+  {
+    engine.start();
+    engine.process_event(gsm::events::Started(__FILE__, __LINE__, stage));
+  }
+}
+
+//! Fan out a pooled frame by reference to a number of engines
+void BM_FrameFanOut(benchmark::State& state)
+{
+  ga::FramePool pool(4, Values * sizeof(float));
+  std::vector<gsm::TableEngine> engines(static_cast<size_t>(state.range(0)));
+  start(engines);
+  uint64_t sequence = 0;
+  float sum = 0.0f;
+  for (auto _ : state)
+  {
+    ga::Frame frame = pool.acquire();
+    ga::Span<float> values = frame.values<float>(Values);
+    for (size_t i = 0; i < Values; i++)
+    {
+      values[i] = static_cast<float>(i);
+    }
+    frame.sequence(++sequence);
+    for (gsm::TableEngine& engine : engines)
+    {
+      /* Every engine takes the frame by reference and reads it in place */
+      const gsm::events::NovosDataAvailable event(frame);
+      engine.process_event(event);
+      sum += event.Data.values<float>()[Values - 1];
+      engine.process_event(gsm::events::NovosDataUnavailable());
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+//! Fan out a decoded payload by copying it to a number of engines
+void BM_FrameCopy(benchmark::State& state)
+{
+  std::vector<gsm::TableEngine> engines(static_cast<size_t>(state.range(0)));
+  start(engines);
+  std::vector<float> decoded(Values);
+  float sum = 0.0f;
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < Values; i++)
+    {
+      decoded[i] = static_cast<float>(i);
+    }
+    for (gsm::TableEngine& engine : engines)
+    {
+      /* Every engine takes its own copy along with an event without data */
+      const std::vector<float> copy(decoded);
+      engine.process_event(gsm::events::NovosDataAvailable());
+      sum += copy[Values - 1];
+      engine.process_event(gsm::events::NovosDataUnavailable());
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} /* namespace */
+
+BENCHMARK(BM_FrameFanOut)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(BM_FrameCopy)->Arg(1)->Arg(4)->Arg(16);
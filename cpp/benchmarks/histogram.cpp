@@ -0,0 +1,63 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/histogram.h>
+
+namespace gah = ::gos::assumption::histogram;
+
+namespace
+{
+
+//! Record a spread of values to one histogram
+void BM_HistogramRecord(benchmark::State& state)
+{
+  gah::Histogram histogram;
+  uint64_t value = 1;
+  for (auto _ : state)
+  {
+    histogram.record(value);
+    value = value * 6364136223846793005ull + 1442695040888963407ull;
+    value >>= 40;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//! Record a transition latency with the clock read of the engines
+void BM_LatenciesRecord(benchmark::State& state)
+{
+  gah::Latencies latencies(12);
+  uint64_t entered = gah::Latencies::now();
+  uint16_t from = 0;
+  for (auto _ : state)
+  {
+    const uint64_t now = gah::Latencies::now();
+    const uint16_t to = static_cast<uint16_t>((from + 1) % 12);
+    latencies.record(from, to, now - entered);
+    entered = now;
+    from = to;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//! Query a snapshot and its tail percentiles
+void BM_HistogramSnapshot(benchmark::State& state)
+{
+  gah::Histogram histogram;
+  for (uint64_t value = 1; value < 100000; value += 7)
+  {
+    histogram.record(value);
+  }
+  for (auto _ : state)
+  {
+    const gah::Snapshot snapshot = histogram.snapshot();
+    benchmark::DoNotOptimize(snapshot.percentile(0.99));
+    benchmark::DoNotOptimize(snapshot.percentile(0.999));
+  }
+}
+
+} /* namespace */
+
+BENCHMARK(BM_HistogramRecord);
+BENCHMARK(BM_LatenciesRecord)->ThreadRange(1, 4);
+BENCHMARK(BM_HistogramSnapshot);
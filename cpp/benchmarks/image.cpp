@@ -0,0 +1,132 @@
+#include <filesystem>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/image.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+namespace gai = ::gos::assumption::image;
+
+namespace
+{
+
+//! 1M values in ids of 100 values
+const unsigned int Ids = 10000;
+const unsigned int ArraySize = 100;
+
+std::string make_id(const unsigned int& i)
+{
+  return "sensor/" + std::to_string(i) + "/value";
+}
+
+//! Build a registry from scratch the way a restart without an image does
+void build(FloatWrapperHolderAssumption& assumption)
+{
+  FloatWrapperHolderAssumption::Batch batch;
+  batch.reserve(Ids);
+  for (unsigned int i = 0; i < Ids; i++)
+  {
+    batch.emplace_back(make_id(i), ArraySize);
+  }
+  assumption.create_many(batch);
+  for (unsigned int i = 0; i < Ids; i++)
+  {
+    const FloatWrapperHolderAssumption::Handle handle =
+      assumption.resolve(make_id(i));
+    for (unsigned int j = 0; j < ArraySize; j++)
+    {
+      assumption.value(handle, j) = static_cast<float>(i + j);
+      assumption.wrapper(handle, j) = FloatWrapper(static_cast<float>(j));
+    }
+  }
+}
+
+const std::string& image_path()
+{
+  static const std::string path = (std::filesystem::temp_directory_path() /
+    "gos_assumption_benchmark_image").string();
+  return path;
+}
+
+void BM_ImageRebuild(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    FloatWrapperHolderAssumption assumption;
+    build(assumption);
+    benchmark::DoNotOptimize(assumption.size());
+  }
+  state.SetItemsProcessed(state.iterations() * Ids * ArraySize);
+}
+
+void BM_ImageSave(benchmark::State& state)
+{
+  FloatWrapperHolderAssumption assumption;
+  build(assumption);
+  for (auto _ : state)
+  {
+    if (gai::save(assumption, image_path()) != gai::Status::Ok)
+    {
+      state.SkipWithError("The image can't be written");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * Ids * ArraySize);
+}
+
+//! Map and check the image, the values are then used in place
+void BM_ImageOpen(benchmark::State& state)
+{
+  {
+    FloatWrapperHolderAssumption assumption;
+    build(assumption);
+    gai::save(assumption, image_path());
+  }
+  for (auto _ : state)
+  {
+    gai::Image<float> image;
+    if (image.open(image_path()) != gai::Status::Ok)
+    {
+      state.SkipWithError("The image can't be opened");
+      break;
+    }
+    benchmark::DoNotOptimize(image.values(make_id(Ids - 1))[0]);
+  }
+  state.SetItemsProcessed(state.iterations() * Ids * ArraySize);
+}
+
+//! Map and check the image and hydrate a registry from it
+void BM_ImageLoad(benchmark::State& state)
+{
+  {
+    FloatWrapperHolderAssumption assumption;
+    build(assumption);
+    gai::save(assumption, image_path());
+  }
+  for (auto _ : state)
+  {
+    gai::Image<float> image;
+    FloatWrapperHolderAssumption assumption;
+    if (image.open(image_path()) != gai::Status::Ok ||
+      gai::load(image, assumption) != gai::Status::Ok)
+    {
+      state.SkipWithError("The image can't be loaded");
+      break;
+    }
+    benchmark::DoNotOptimize(assumption.size());
+  }
+  state.SetItemsProcessed(state.iterations() * Ids * ArraySize);
+}
+
+} /* namespace */
+
+BENCHMARK(BM_ImageRebuild)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ImageSave)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ImageOpen)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ImageLoad)->Unit(benchmark::kMillisecond);
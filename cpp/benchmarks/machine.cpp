@@ -0,0 +1,83 @@
+#include <iostream>
+#include <streambuf>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/machine.h>
+
+namespace gsm = ::gos::assumption::state_machine;
+namespace events = ::gos::assumption::state_machine::events;
+
+namespace
+{
+
+//! A stream buffer dropping everything written to it
+class NullBuffer : public std::streambuf
+{
+protected:
+  int overflow(int c) { return c; }
+  std::streamsize xsputn(const char*, std::streamsize count) { return count; }
+};
+
+//! Silences the standard output the engine writes with the cout option
+class Silence
+{
+public:
+  Silence() : previous_(std::cout.rdbuf(&this->null_)) {}
+  ~Silence() { std::cout.rdbuf(this->previous_); }
+private:
+  NullBuffer null_;
+  std::streambuf* previous_;
+};
+
+//! The nanoseconds per event of a benchmark
+benchmark::Counter per_event(const benchmark::State& state, const int& events)
+{
+  return benchmark::Counter(
+    static_cast<double>(state.iterations()) * events,
+    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+//! A cycle through the control states, four transitions per iteration
+void BM_TableDispatch(benchmark::State& state)
+{
+  Silence silence;
+  gsm::TableEngine engine;
+  engine.start();
+  gsm::Stage stage;
+  events::Started started(__FILE__, __LINE__, stage);
+  engine.process_event(started);
+  engine.process_event(events::NovosDataAvailable());
+  engine.process_event(events::ItgDataAvailable());
+  engine.process_event(events::HoistConstrainstActivityBecomesAvailable());
+  for (auto _ : state)
+  {
+    engine.process_event(events::ControlRequested());
+    engine.process_event(events::Granted());
+    engine.process_event(events::ControlRelinquished());
+    engine.process_event(events::ControlLost());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 4);
+  state.counters["event"] = per_event(state, 4);
+}
+
+//! An event without a transition from the current state
+void BM_TableNoTransition(benchmark::State& state)
+{
+  Silence silence;
+  gsm::TableEngine engine;
+  engine.start();
+  for (auto _ : state)
+  {
+    engine.process_event(events::Granted());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["event"] = per_event(state, 1);
+}
+
+} /* namespace */
+
+BENCHMARK(BM_TableDispatch);
+BENCHMARK(BM_TableNoTransition);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+/* The options the library was built with are written into the context of
+ * the results so runs of different option combinations can be told apart */
+static const char* set_check()
+{
+#if defined(_GOS_ASSUMPTION_SET_CHECK_WITH_VARIABLE_)
+  return "variable";
+#elif defined(_GOS_ASSUMPTION_SET_CHECK_FROM_DEFAULT_)
+  return "default";
+#else
+  return "none";
+#endif
+}
+
+static const char* enabled(const bool& option)
+{
+  return option ? "on" : "off";
+}
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return 1;
+  }
+  benchmark::AddCustomContext("set_check", set_check());
+  benchmark::AddCustomContext("compare_with_friend", enabled(
+#if defined(_GOS_ASSUMPTION_COMPARE_WITH_FRIEND_)
+    true
+#else
+    false
+#endif
+  ));
+  benchmark::AddCustomContext("fast", enabled(
+#if defined(_GOS_ASSUMPTION_FAST_)
+    true
+#else
+    false
+#endif
+  ));
+  benchmark::AddCustomContext("boost_state_machine", enabled(
+#if defined(_GOS_ASSUMPTION_BOOST_STATE_MACHINE_)
+    true
+#else
+    false
+#endif
+  ));
+  benchmark::AddCustomContext("trace", enabled(
+#if defined(_GOS_ASSUMPTION_TRACE_)
+    true
+#else
+    false
+#endif
+  ));
+  benchmark::AddCustomContext("histogram", enabled(
+#if defined(_GOS_ASSUMPTION_HISTOGRAM_)
+    true
+#else
+    false
+#endif
+  ));
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+typedef FloatWrapperHolderAssumption::Id Id;
+typedef FloatWrapperHolderAssumption::Size Size;
+
+namespace
+{
+
+const Size ArraySize = 8;
+
+//! The memory resources a registry is benchmarked with
+enum class Resource
+{
+  Heap,
+  Pool,
+  Monotonic
+};
+
+std::vector<Id> make_ids(const size_t& count)
+{
+  std::vector<Id> ids;
+  ids.reserve(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    ids.push_back("sensor/" + std::to_string(i) + "/value");
+  }
+  return ids;
+}
+
+//! The upstream of the pool and the monotonic resource
+/*! Keeps the arena memory between iterations like a long lived process */
+std::pmr::memory_resource* upstream()
+{
+  static std::pmr::unsynchronized_pool_resource pool(
+    std::pmr::new_delete_resource());
+  return &pool;
+}
+
+//! Build a registry and destroy it
+/*! Construction and teardown are timed separately, the counters report the
+ *  time of each part per id.
+ */
+template<Resource R> void BM_ConstructTeardown(benchmark::State& state)
+{
+  const std::vector<Id> ids = make_ids(static_cast<size_t>(state.range(0)));
+  std::pmr::unsynchronized_pool_resource pool(upstream());
+  std::pmr::monotonic_buffer_resource monotonic(upstream());
+  std::pmr::memory_resource* resource = std::pmr::new_delete_resource();
+  if (R == Resource::Pool)
+  {
+    resource = &pool;
+  }
+  if (R == Resource::Monotonic)
+  {
+    resource = &monotonic;
+  }
+
+  typedef std::chrono::steady_clock Clock;
+  typedef std::chrono::duration<double> Seconds;
+  double construction = 0;
+  double teardown = 0;
+  for (auto _ : state)
+  {
+    const Clock::time_point start = Clock::now();
+    std::unique_ptr<FloatWrapperHolderAssumption> assumption =
+      std::make_unique<FloatWrapperHolderAssumption>(resource);
+    for (const Id& id : ids)
+    {
+      assumption->create(id, ArraySize);
+    }
+    benchmark::DoNotOptimize(assumption.get());
+    const Clock::time_point built = Clock::now();
+    assumption.reset();
+    monotonic.release();
+    construction += Seconds(built - start).count();
+    teardown += Seconds(Clock::now() - built).count();
+  }
+  state.counters["construction"] = benchmark::Counter(
+    construction / state.range(0),
+    benchmark::Counter::kAvgIterations);
+  state.counters["teardown"] = benchmark::Counter(
+    teardown / state.range(0),
+    benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} /* namespace */
+
+BENCHMARK_TEMPLATE(BM_ConstructTeardown, Resource::Heap)
+  ->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ConstructTeardown, Resource::Pool)
+  ->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ConstructTeardown, Resource::Monotonic)
+  ->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
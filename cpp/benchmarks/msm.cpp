@@ -0,0 +1,227 @@
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/boost.h>
+#include <gos/assumption/pump.h>
+#ifdef _GOS_ASSUMPTION_TRACE_
+#include <gos/assumption/trace.h>
+#endif
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+
+namespace gas = ::gos::assumption::state_machine_boost_msm;
+namespace events = ::gos::assumption::state_machine_boost_msm::events;
+
+namespace
+{
+
+//! A stream buffer dropping everything written to it
+class NullBuffer : public std::streambuf
+{
+protected:
+  int overflow(int c) { return c; }
+  std::streamsize xsputn(const char*, std::streamsize count) { return count; }
+};
+
+//! Silences the standard output the engine writes with the cout option
+/*! The formatting of the output is still part of the measurement. With
+ *  the trace option the records are drained in the background like they
+ *  would be in production, the draining is on another thread.
+ */
+class Silence
+{
+public:
+  Silence() :
+    previous_(std::cout.rdbuf(&this->null_))
+#ifdef _GOS_ASSUMPTION_TRACE_
+    , os_(&this->null_),
+    drainer_(gos::assumption::trace::Tracer::instance(), this->os_,
+      gos::assumption::trace::Format::Text,
+      gos::assumption::trace::Names{ gas::stage_name, gas::event_name },
+      std::chrono::milliseconds(1))
+#endif
+  {}
+  ~Silence() { std::cout.rdbuf(this->previous_); }
+private:
+  NullBuffer null_;
+  std::streambuf* previous_;
+#ifdef _GOS_ASSUMPTION_TRACE_
+  std::ostream os_;
+  gos::assumption::trace::Drainer drainer_;
+#endif
+};
+
+//! A cycle through the control states, four transitions per iteration
+void BM_EngineDispatch(benchmark::State& state)
+{
+  Silence silence;
+  gas::StateEngine engine;
+  engine.start();
+  gas::Stage stage;
+  events::Started started(__FILE__, __LINE__, stage);
+  engine.process_event(started);
+  engine.process_event(events::NovosDataAvailable());
+  engine.process_event(events::ItgDataAvailable());
+  engine.process_event(events::HoistConstrainstActivityBecomesAvailable());
+  for (auto _ : state)
+  {
+    engine.process_event(events::ControlRequested());
+    engine.process_event(events::Granted());
+    engine.process_event(events::ControlRelinquished());
+    engine.process_event(events::ControlLost());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 4);
+  state.counters["event"] = benchmark::Counter(
+    static_cast<double>(state.iterations()) * 4,
+    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+//! An event without a transition from the current state
+void BM_EngineNoTransition(benchmark::State& state)
+{
+  Silence silence;
+  gas::StateEngine engine;
+  engine.start();
+  for (auto _ : state)
+  {
+    engine.process_event(events::Granted());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["event"] = benchmark::Counter(
+    static_cast<double>(state.iterations()),
+    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+//! The current stage by visiting the current states
+void BM_EngineVisitStage(benchmark::State& state)
+{
+  Silence silence;
+  gas::StateEngine engine;
+  engine.start();
+  gas::visitors::SomeVisitor visitor;
+  for (auto _ : state)
+  {
+    gas::Stage stage = gas::Stage::Undefined;
+    engine.visit_current_states(::boost::ref(visitor), stage);
+    benchmark::DoNotOptimize(visitor.GetLastState());
+  }
+}
+
+//! The current stage published by the engine
+void BM_EngineStageQuery(benchmark::State& state)
+{
+  gas::StateEngine engine;
+  engine.start();
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(engine.stage());
+    benchmark::DoNotOptimize(engine.transitions());
+  }
+}
+
+//! The events posted by each producer in one iteration
+const size_t ProducerEvents = 10000;
+
+//! The availability of the NOVOS data toggled by a producer
+gas::events::EventId toggle(const size_t& i)
+{
+  return i % 2 == 0 ?
+    gas::events::EventId::NovosDataAvailable :
+    gas::events::EventId::NovosDataUnavailable;
+}
+
+//! Producer threads post to a pump dispatched in batches by this thread
+void BM_PumpProducers(benchmark::State& state)
+{
+  Silence silence;
+  const size_t producers = static_cast<size_t>(state.range(0));
+  gas::StateEngine engine;
+  gas::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  gas::EventPump pump(engine, 1024, gas::Policy::Reject);
+  for (auto _ : state)
+  {
+    std::vector<std::thread> threads;
+    for (size_t producer = 0; producer < producers; producer++)
+    {
+      threads.emplace_back([&pump]()
+      {
+        for (size_t i = 0; i < ProducerEvents; i++)
+        {
+          while (pump.post(toggle(i)) != gas::Posted::Queued)
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    size_t dispatched = 0;
+    while (dispatched < producers * ProducerEvents)
+    {
+      const size_t count = pump.dispatch();
+      if (count == 0)
+      {
+        std::this_thread::yield();
+      }
+      dispatched += count;
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * producers * ProducerEvents);
+}
+
+//! Producer threads process their events serialized on a mutex
+void BM_MutexProducers(benchmark::State& state)
+{
+  Silence silence;
+  const size_t producers = static_cast<size_t>(state.range(0));
+  gas::StateEngine engine;
+  gas::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  std::mutex mutex;
+  for (auto _ : state)
+  {
+    std::vector<std::thread> threads;
+    for (size_t producer = 0; producer < producers; producer++)
+    {
+      threads.emplace_back([&engine, &mutex]()
+      {
+        for (size_t i = 0; i < ProducerEvents; i++)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          gas::process(engine, toggle(i));
+        }
+      });
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * producers * ProducerEvents);
+}
+
+} /* namespace */
+
+BENCHMARK(BM_EngineDispatch);
+BENCHMARK(BM_EngineNoTransition);
+BENCHMARK(BM_EngineVisitStage);
+BENCHMARK(BM_EngineStageQuery);
+BENCHMARK(BM_PumpProducers)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_MutexProducers)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+#endif
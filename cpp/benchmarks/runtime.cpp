@@ -0,0 +1,110 @@
+#include <cstdint>
+
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/runtime.h>
+
+namespace gsm = ::gos::assumption::state_machine;
+
+namespace
+{
+
+typedef gsm::events::EventId Id;
+typedef gsm::Runtime::Instance Instance;
+
+//! The number of engines of the runtime
+const Instance Instances = 4096;
+//! The control cycles of every instance in one iteration
+const size_t Cycles = 16;
+
+void post(gsm::Runtime& runtime, const Instance& instance, const Id& id)
+{
+  while (!runtime.post(instance, id))
+  {
+    std::this_thread::yield();
+  }
+}
+
+void wait(const gsm::Runtime& runtime, const uint64_t& processed)
+{
+  while (runtime.processed() < processed)
+  {
+    std::this_thread::yield();
+  }
+}
+
+//! The instances of a block posted to by one producer thread
+void produce(gsm::Runtime& runtime, const Instance& first,
+  const Instance& last, const Id* ids, const size_t& count)
+{
+  for (size_t cycle = 0; cycle < Cycles; cycle++)
+  {
+    for (Instance i = first; i < last; i++)
+    {
+      for (size_t j = 0; j < count; j++)
+      {
+        post(runtime, i, ids[j]);
+      }
+    }
+  }
+}
+
+//! Control cycles of every engine on a number of shards and producers
+/*! Each producer posts to a block of instances spread over every shard,
+ *  the items per second are the transitions of every shard together.
+ */
+void BM_RuntimeShards(benchmark::State& state)
+{
+  const size_t shards = static_cast<size_t>(state.range(0));
+  gsm::Runtime runtime(Instances, shards);
+  runtime.start();
+  const Id Available[] = {
+    Id::Started,
+    Id::NovosDataAvailable,
+    Id::ItgDataAvailable,
+    Id::HoistConstrainstActivityBecomesAvailable
+  };
+  const Id Control[] = {
+    Id::ControlRequested,
+    Id::Granted,
+    Id::ControlRelinquished,
+    Id::ControlLost
+  };
+  for (Instance i = 0; i < Instances; i++)
+  {
+    for (const Id& id : Available)
+    {
+      post(runtime, i, id);
+    }
+  }
+  uint64_t processed = Instances * 4;
+  wait(runtime, processed);
+  for (auto _ : state)
+  {
+    std::vector<std::thread> threads;
+    for (size_t producer = 0; producer < shards; producer++)
+    {
+      threads.emplace_back(produce, std::ref(runtime),
+        static_cast<Instance>(producer * Instances / shards),
+        static_cast<Instance>((producer + 1) * Instances / shards),
+        Control, size_t(4));
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+    processed += Instances * Cycles * 4;
+    wait(runtime, processed);
+  }
+  runtime.stop();
+  state.SetItemsProcessed(
+    static_cast<int64_t>(runtime.transitions() - Instances * 4));
+}
+
+} /* namespace */
+
+BENCHMARK(BM_RuntimeShards)->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+  ->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,134 @@
+#include <cstdint>
+
+#include <vector>
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+#include <boost/spirit/include/qi_binary.hpp>
+#include <boost/spirit/include/qi_parse.hpp>
+#include <boost/spirit/include/qi_parse_attr.hpp>
+#include <boost/spirit/include/qi_sequence.hpp>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/schema.h>
+
+namespace
+{
+
+namespace gs = ::gos::assumption::schema;
+
+//! A fixed layout record of a market data like frame
+struct Tick
+{
+  std::uint16_t id;
+  std::uint32_t sequence;
+  float price;
+  double volume;
+  std::int16_t flags;
+};
+
+typedef gs::Schema<
+  gs::Field<&Tick::id, gs::Order::Big, 0>,
+  gs::Field<&Tick::sequence, gs::Order::Big, 2>,
+  gs::Field<&Tick::price, gs::Order::Big, 6>,
+  gs::Field<&Tick::volume, gs::Order::Big, 10>,
+  gs::Field<&Tick::flags, gs::Order::Big, 18>> TickSchema;
+
+std::vector<unsigned char> make_frame(const size_t& count)
+{
+  std::vector<Tick> ticks(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    ticks[i].id = static_cast<std::uint16_t>(i);
+    ticks[i].sequence = static_cast<std::uint32_t>(i * 3);
+    ticks[i].price = static_cast<float>(i) * 0.25f;
+    ticks[i].volume = static_cast<double>(i) * 100.0;
+    ticks[i].flags = static_cast<std::int16_t>(i & 0xff);
+  }
+  std::vector<unsigned char> frame(count * TickSchema::Bytes);
+  TickSchema::encode(frame.data(), frame.size(), ticks.data(), count);
+  return frame;
+}
+
+//! Decode a frame of records into structs with the schema
+void BM_SchemaDecode(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::vector<unsigned char> frame = make_frame(count);
+  std::vector<Tick> ticks(count);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(TickSchema::decode(
+      frame.data(), frame.size(), ticks.data(), count));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+
+//! Decode a frame of records into array holder columns with the schema
+void BM_SchemaDecodeColumns(benchmark::State& state)
+{
+  typedef gos::assumption::ArrayHolder<std::uint16_t> Ids;
+  typedef gos::assumption::ArrayHolder<std::uint32_t> Sequences;
+  typedef gos::assumption::ArrayHolder<float> Prices;
+  typedef gos::assumption::ArrayHolder<double> Volumes;
+  typedef gos::assumption::ArrayHolder<std::int16_t> Flags;
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::vector<unsigned char> frame = make_frame(count);
+  Ids ids(count);
+  Sequences sequences(count);
+  Prices prices(count);
+  Volumes volumes(count);
+  Flags flags(count);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(TickSchema::decode_columns(
+      frame.data(), frame.size(), TickSchema::Bytes,
+      ids, sequences, prices, volumes, flags));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+//! Decode a frame of records with the equivalent Spirit Qi grammar
+void BM_QiDecode(benchmark::State& state)
+{
+  namespace qi = ::boost::spirit::qi;
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::vector<unsigned char> frame = make_frame(count);
+  std::vector<Tick> ticks(count);
+  for (auto _ : state)
+  {
+    const unsigned char* first = frame.data();
+    const unsigned char* last = frame.data() + frame.size();
+    bool result = true;
+    for (size_t i = 0; i < count && result; i++)
+    {
+      Tick& tick = ticks[i];
+      std::uint16_t flags = 0;
+      result = qi::parse(first, last,
+        qi::big_word >> qi::big_dword >> qi::big_bin_float >>
+        qi::big_bin_double >> qi::big_word,
+        tick.id, tick.sequence, tick.price, tick.volume, flags);
+      tick.flags = static_cast<std::int16_t>(flags);
+    }
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * frame.size());
+}
+#endif
+
+} /* namespace */
+
+BENCHMARK(BM_SchemaDecode)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(BM_SchemaDecodeColumns)->RangeMultiplier(16)->Range(16, 1 << 16);
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+BENCHMARK(BM_QiDecode)->RangeMultiplier(16)->Range(16, 1 << 16);
+#endif
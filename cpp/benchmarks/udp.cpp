@@ -0,0 +1,82 @@
+#include <cstdint>
+
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/udp.h>
+
+namespace
+{
+
+namespace gu = ::gos::assumption::udp;
+
+typedef boost::asio::ip::udp::endpoint Endpoint;
+
+//! The datagrams queued on the socket before each drain
+/*! Kept small enough for the default socket receive buffer so nothing is
+ *  dropped by the kernel, the drops counter shows if it was */
+const size_t Queued = 128;
+//! The floats of every datagram
+const uint16_t Floats = 16;
+
+//! Drain datagrams from a loopback socket into an array holder
+/*! Only the draining is timed, so the result is the packets per second one
+ *  core receives and decodes. The argument is the receive batch size. */
+void BM_UdpReceive(benchmark::State& state)
+{
+  typedef gos::assumption::Wrapper<float> FloatWrapper;
+  typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+  typedef gu::Receiver<FloatWrapper> Receiver;
+
+  const size_t batch = static_cast<size_t>(state.range(0));
+  FloatHolder holder(1024);
+  boost::asio::io_context context;
+  Receiver receiver(context,
+    Endpoint(boost::asio::ip::address_v4::loopback(), 0),
+    Receiver::Items(holder.pointer(0), holder.size()), batch);
+  boost::system::error_code error;
+  receiver.socket().set_option(
+    boost::asio::socket_base::receive_buffer_size(4 << 20), error);
+  boost::asio::ip::udp::socket sender(
+    context, Endpoint(boost::asio::ip::udp::v4(), 0));
+  const Endpoint destination = receiver.endpoint();
+
+  float values[Floats];
+  for (uint16_t i = 0; i < Floats; i++)
+  {
+    values[i] = static_cast<float>(i);
+  }
+  unsigned char datagram[gu::DatagramCapacity];
+  uint32_t sequence = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    for (size_t i = 0; i < Queued; i++)
+    {
+      const uint16_t first = static_cast<uint16_t>((sequence * Floats) % 1024);
+      const size_t size = gu::encode(datagram, sizeof(datagram),
+        gu::Header{ sequence++, first, Floats }, values);
+      sender.send_to(boost::asio::buffer(datagram, size), destination);
+    }
+    state.ResumeTiming();
+    size_t received = 0;
+    while (received < Queued)
+    {
+      received += receiver.poll();
+    }
+  }
+  const gu::Counters& counters = receiver.counters();
+  state.SetItemsProcessed(static_cast<int64_t>(counters.packets));
+  state.SetBytesProcessed(static_cast<int64_t>(counters.bytes));
+  state.counters["batches"] = static_cast<double>(counters.batches);
+  state.counters["drops"] = static_cast<double>(counters.drops);
+  state.counters["errors"] = static_cast<double>(counters.errors);
+}
+
+} /* namespace */
+
+BENCHMARK(BM_UdpReceive)->Arg(1)->Arg(8)->Arg(64);
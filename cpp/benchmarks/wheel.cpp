@@ -0,0 +1,96 @@
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+#include <boost/asio.hpp>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption/wheel.h>
+
+namespace
+{
+
+typedef gos::assumption::TimingWheel<size_t> Wheel;
+
+//! Arm and cancel a timeout among a number of armed ones
+/*! Like an engine requesting control and being granted in time */
+void BM_WheelArmCancel(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  Wheel wheel(count + 1);
+  for (size_t i = 0; i < count; i++)
+  {
+    wheel.arm(i % 5000 + 1, i);
+  }
+  for (auto _ : state)
+  {
+    const Wheel::Handle handle = wheel.arm(1000, count);
+    benchmark::DoNotOptimize(wheel.cancel(handle));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+//! Advance a tick at a time while the armed timeouts expire
+void BM_WheelExpire(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  Wheel wheel(count);
+  size_t fired = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    for (size_t i = 0; i < count; i++)
+    {
+      wheel.arm(i % 1000 + 1, i);
+    }
+    state.ResumeTiming();
+    while (!wheel.empty())
+    {
+      wheel.advance(1, [&](const Wheel::Batch& batch)
+      {
+        fired += batch.size();
+      });
+    }
+  }
+  benchmark::DoNotOptimize(fired);
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+//! Arm and cancel a timeout with one asio timer per engine
+void BM_SteadyTimerArmCancel(benchmark::State& state)
+{
+  const size_t count = static_cast<size_t>(state.range(0));
+  boost::asio::io_context context;
+  std::vector<std::unique_ptr<boost::asio::steady_timer>> timers;
+  for (size_t i = 0; i <= count; i++)
+  {
+    timers.push_back(std::make_unique<boost::asio::steady_timer>(context));
+    if (i < count)
+    {
+      timers[i]->expires_after(std::chrono::seconds(i % 5000 + 1));
+      timers[i]->async_wait([](const boost::system::error_code&) {});
+    }
+  }
+  boost::asio::steady_timer& timer = *timers[count];
+  for (auto _ : state)
+  {
+    timer.expires_after(std::chrono::seconds(1));
+    timer.async_wait([](const boost::system::error_code&) {});
+    benchmark::DoNotOptimize(timer.cancel());
+    context.poll();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+#endif
+
+} /* namespace */
+
+BENCHMARK(BM_WheelArmCancel)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(BM_WheelExpire)->RangeMultiplier(16)->Range(16, 1 << 16);
+#ifdef _GOS_ASSUMPTION_BOOST_HEADER_
+BENCHMARK(BM_SteadyTimerArmCancel)->RangeMultiplier(16)->Range(16, 1 << 16);
+#endif
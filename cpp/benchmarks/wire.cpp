@@ -0,0 +1,211 @@
+#include <cstdint>
+#include <cstdlib>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/wire.h>
+#include <gos/assumption/yaml.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+namespace gaw = ::gos::assumption::wire;
+typedef gos::assumption::StringHolder StringHolder;
+
+namespace
+{
+
+const int Groups = 1000;
+
+gaw::Group make_group(const int& i)
+{
+  gaw::Group group;
+  group.type = i % 2 == 0 ? gaw::Type::B : gaw::Type::A;
+  group.id = StringHolder("sensor/" + std::to_string(i));
+  group.item.name = StringHolder("item" + std::to_string(i));
+  if (group.type == gaw::Type::A)
+  {
+    group.item.text = StringHolder("value " + std::to_string(i));
+  }
+  group.item.number = i;
+  return group;
+}
+
+std::vector<unsigned char> make_messages()
+{
+  std::vector<unsigned char> result;
+  for (int i = 0; i < Groups; i++)
+  {
+    gaw::encode(result, make_group(i));
+  }
+  return result;
+}
+
+//! The documents the Java side dumps with SnakeYAML, one after another
+std::vector<std::string> make_documents()
+{
+  std::vector<std::string> result;
+  for (int i = 0; i < Groups; i++)
+  {
+    const gaw::Group group = make_group(i);
+    result.push_back("id: " + group.id.text() + "\nitem: {name: " +
+      group.item.name.text() + ", value: " +
+      (group.type == gaw::Type::A ?
+        group.item.text.text() : std::to_string(group.item.number)) +
+      "}\ntype: " + (group.type == gaw::Type::A ? "A" : "B") + "\n");
+  }
+  return result;
+}
+
+/* The value of a key in a line or a flow mapping up to a delimiter */
+std::string_view scan(
+  const std::string_view& text,
+  const std::string_view& key,
+  const char& end)
+{
+  const std::size_t start = text.find(key);
+  if (start == std::string_view::npos)
+  {
+    return std::string_view();
+  }
+  const std::size_t from = start + key.size();
+  return text.substr(from, text.find(end, from) - from);
+}
+
+//! The least a YAML reader does for a document, a lower bound of its cost
+/*! Only the flow style SnakeYAML dumps is read, without quoting, escapes,
+ *  anchors or a document model.
+ */
+bool scan_document(const std::string_view& text, gaw::Group& group)
+{
+  const std::string_view type = scan(text, "type: ", '\n');
+  if (type.empty())
+  {
+    return false;
+  }
+  group.type = type == "A" ? gaw::Type::A : gaw::Type::B;
+  group.id = StringHolder(std::string(scan(text, "id: ", '\n')));
+  const std::string_view item = scan(text, "item: {", '}');
+  group.item.name = StringHolder(std::string(scan(item, "name: ", ',')));
+  const std::string_view value = scan(item, "value: ", '}');
+  if (group.type == gaw::Type::A)
+  {
+    group.item.text = StringHolder(std::string(value));
+  }
+  else
+  {
+    group.item.number = std::atoi(std::string(value).c_str());
+  }
+  return true;
+}
+
+void BM_WireEncode(benchmark::State& state)
+{
+  std::vector<gaw::Group> groups;
+  for (int i = 0; i < Groups; i++)
+  {
+    groups.push_back(make_group(i));
+  }
+  std::vector<unsigned char> buffer;
+  for (auto _ : state)
+  {
+    buffer.clear();
+    for (const gaw::Group& group : groups)
+    {
+      gaw::encode(buffer, group);
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * Groups);
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void BM_WireDecode(benchmark::State& state)
+{
+  const std::vector<unsigned char> buffer = make_messages();
+  gaw::Group group;
+  for (auto _ : state)
+  {
+    for (size_t used = 0; used < buffer.size();)
+    {
+      used += gaw::decode(buffer.data() + used, buffer.size() - used, group);
+    }
+    benchmark::DoNotOptimize(group.item.number);
+  }
+  state.SetItemsProcessed(state.iterations() * Groups);
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void BM_WireYamlScan(benchmark::State& state)
+{
+  const std::vector<std::string> documents = make_documents();
+  size_t bytes = 0;
+  for (const std::string& document : documents)
+  {
+    bytes += document.size();
+  }
+  gaw::Group group;
+  for (auto _ : state)
+  {
+    for (const std::string& document : documents)
+    {
+      scan_document(document, group);
+    }
+    benchmark::DoNotOptimize(group.item.number);
+  }
+  state.SetItemsProcessed(state.iterations() * Groups);
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+//! Read the documents as one stream
+void BM_WireYamlRead(benchmark::State& state)
+{
+  std::string stream;
+  for (const std::string& document : make_documents())
+  {
+    stream += "---\n" + document;
+  }
+  gos::assumption::yaml::Reader reader;
+  std::int64_t sum = 0;
+  auto handler = [&sum](const gaw::Group& group,
+    const gos::assumption::yaml::Names::Symbol&)
+  {
+    sum += group.item.number;
+  };
+  for (auto _ : state)
+  {
+    reader.feed(stream.data(), stream.size(), handler);
+    reader.finish(handler);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * Groups);
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+//! Decode the groups into a new Assumption
+void BM_WireLoad(benchmark::State& state)
+{
+  const std::vector<unsigned char> buffer = make_messages();
+  for (auto _ : state)
+  {
+    FloatWrapperHolderAssumption assumption;
+    gaw::load(buffer.data(), buffer.size(), assumption);
+    benchmark::DoNotOptimize(assumption.size());
+  }
+  state.SetItemsProcessed(state.iterations() * Groups);
+}
+
+} /* namespace */
+
+BENCHMARK(BM_WireEncode);
+BENCHMARK(BM_WireDecode);
+BENCHMARK(BM_WireYamlScan);
+BENCHMARK(BM_WireYamlRead);
+BENCHMARK(BM_WireLoad);
@@ -4,15 +4,25 @@
 #include <cstdio>
 #include <cassert>
 
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <iostream>
-#include <map>
-#include <set>
 
 #include <gos/assumption/interfaces.h>
+#include <gos/assumption/memory.h>
+#include <gos/assumption/table.h>
 
-#define _GOS_ASSUMPTION_FAST_ "fast"
+/* The fast mode is selected by defining _GOS_ASSUMPTION_FAST_. The Wrapper,
+ * Holder, ArrayHolder and Assumption classes are then final and implement
+ * static interfaces instead of the virtual ones so calls are direct and can
+ * be inlined. Code that needs the virtual interfaces uses the adapters found
+ * in gos/assumption/polymorphic.h */
+/* The thread safe mode is gos::assumption::ConcurrentAssumption found in
+ * gos/assumption/concurrent.h */
 #define _GOS_ASSUMPTION_THREAD_SAFE_ "threadsafe"
 
 /* https://google.github.io/styleguide/cppguide.html#Variable_Names */
@@ -53,8 +63,12 @@ private:
 };
 
 //! A simple wrapper template
-template<typename T> class Wrapper :
-  public gos::interfaces::Wrapper<T>
+template<typename T> class Wrapper
+#if defined(_GOS_ASSUMPTION_FAST_)
+  final : public gos::interfaces::StaticWrapper<Wrapper<T>, T>
+#else
+  : public gos::interfaces::Wrapper<T>
+#endif
 {
 public:
   //! The interface type
@@ -138,10 +152,14 @@ private:
 };
 
 //! A simple holder class
-template<typename T> class Holder :
-  public gos::interfaces::CopyableHolder<T>,
+template<typename T> class Holder
+#if defined(_GOS_ASSUMPTION_FAST_)
+  final : public gos::interfaces::StaticHolder<Holder<T>, T>
+#else
+  : public gos::interfaces::CopyableHolder<T>,
   public gos::interfaces::ReferencableHolder<T>,
   public gos::interfaces::PointeredHolder<T>
+#endif
 {
 public:
   //! A type for a unique pointer to the contained value
@@ -162,7 +180,12 @@ private:
 };
 
 //! A array holding class
-template<typename T> class ArrayHolder : public gos::interfaces::ArrayHolder<T>
+template<typename T> class ArrayHolder
+#if defined(_GOS_ASSUMPTION_FAST_)
+  final : public gos::interfaces::StaticArrayHolder<ArrayHolder<T>, T>
+#else
+  : public gos::interfaces::ArrayHolder<T>
+#endif
 {
 public:
   //! The index type
@@ -170,10 +193,16 @@ public:
   //! The size type
   typedef typename gos::interfaces::ArrayHolder<T>::Size Size;
   ArrayHolder() : size_(0) {}
-  //! A Constructor that creates an array on the heap with make unique
-  ArrayHolder(const Size& size) : size_(size)
+  //! A Constructor that creates an array from a memory resource
+  /*! The items are zeroed or default constructed. The default resource
+   *  allocates on the heap with new.
+   */
+  ArrayHolder(
+    const Size& size,
+    MemoryResource* resource = std::pmr::get_default_resource()) :
+    array_(detail::make_array<T>(resource, size)),
+    size_(size)
   {
-    this->array_ = std::make_unique<T[]>(this->size_);
     assert(this->array_);
   }
   ~ArrayHolder()
@@ -196,7 +225,7 @@ public:
   /*! The internal state of the object stays unchanged by constant guard */
   const Size& size() const { return this->size_; }
 private:
-  typedef std::unique_ptr<T[]> Array;
+  typedef std::unique_ptr<T[], detail::ArrayDeleter<T>> Array;
   Array array_;
   Size size_;
 };
@@ -214,6 +243,13 @@ public:
   const char* string() const { return this->string_.c_str(); }
   //! Access to a copy of the string
   const std::string text() const { return this->string_; }
+  //! Access to a view of the string without copying it
+  std::string_view view() const { return this->string_; }
+  //! Replace the string, reusing its storage when it is large enough
+  void assign(const std::string_view& text)
+  {
+    this->string_.assign(text.data(), text.size());
+  }
 private:
   std::string string_;
 };
@@ -270,7 +306,7 @@ template<typename T>
 class DefaultingHolder : public gos::interfaces::ReferencableHolder<T>
 {
 public:
-  DefaultingHolder() : ReferencableHolder(T()) {}
+  DefaultingHolder() {}
 };
 
 //! A simple constant holder class
@@ -329,9 +365,34 @@ private:
   Collection collection_;
 };
 
+namespace detail
+{
+
+//! Checks if a holder knows the size of the arrays it was created for
+template<typename H, typename = void>
+struct HasSize : std::false_type {};
+template<typename H>
+struct HasSize<H, std::void_t<decltype(std::declval<const H&>().size())>> :
+  std::true_type {};
+
+} /* namespace detail */
+
 //! The Assumption class
-template<typename T, typename W, typename H>
-class Assumption : public gos::interfaces::Assumption<T, W, H>
+/*! Every id is kept in a single record holding the value array, the wrapper
+ *  array and the holder of the id. The records are looked up through an open
+ *  addressing hash table so each access costs one hash and one probe.
+ *  The table and the items created by the object are allocated from the
+ *  memory resource given at construction. With a monotonic buffer resource
+ *  the memory of a whole registry is released at once by clearing the object
+ *  and releasing the resource. Items inserted by the caller keep the heap
+ *  allocation they were created with.
+ */
+template<typename T, typename W, typename H> class Assumption
+#if defined(_GOS_ASSUMPTION_FAST_)
+  final : public gos::interfaces::StaticAssumption<Assumption<T, W, H>, T, W, H>
+#else
+  : public gos::interfaces::Assumption<T, W, H>
+#endif
 {
 public:
   //! The interface type
@@ -346,8 +407,25 @@ public:
   typedef typename Interface::WrapperArray WrapperArray;
   //! The holder unique pointer type
   typedef typename Interface::HolderPtr HolderPtr;
+  //! The id view type
+  typedef typename Interface::Key Key;
+  //! The handle type
+  typedef typename Interface::Handle Handle;
   //! The size type
   typedef Index Size;
+  //! The type of an id and the array size to create for it
+  typedef std::pair<Id, Size> Entry;
+  //! The type of a batch of ids to create in bulk
+  typedef std::vector<Entry> Batch;
+
+  //! The handle returned when resolving an id that is not contained
+  static const Handle NoHandle = ::gos::interfaces::NoHandle;
+
+  //! A Constructor that takes the memory resource to allocate from
+  /*! The resource must outlive the object */
+  Assumption(MemoryResource* resource = std::pmr::get_default_resource()) :
+    resource_(resource), table_(resource), blocks_(resource)
+  {}
 
   //! The constant array size
   const Size ArraySize = 8;
@@ -369,53 +447,301 @@ public:
       a[i] = T(); /* This will zero int, double, float etc */
     }
 
-    std::string id = UniqueId;
-
-    const size_t ExpectedSize = 1;
-
-    this->id_set_.insert(id);
-    assert(this->id_set_.size() == ExpectedSize);
-    this->array_map_[id] = std::move(a);
+    this->insert(UniqueId, a, wrapper, holder);
     assert(!(bool)a);
-    assert(this->array_map_.size() == ExpectedSize);
-    this->wrapper_array_map_[id] = std::move(wrapper);
     assert(!(bool)wrapper);
-    assert(this->wrapper_array_map_.size() == ExpectedSize);
-    this->holder_map_[id] = std::move(holder);
     assert(!(bool)holder);
-    assert(this->holder_map_.size() == ExpectedSize);
+    assert(this->has(UniqueId));
+  }
+  //! Insert the items for an id
+  /*! The arrays and the holder are moved into the object by the move function.
+   *  That will leave the referenced pointers un-set afterwards. The items of
+   *  an id that is already contained in the object are replaced.
+   */
+  void insert(const Id& id, Array& a, WrapperArray& wrapper, HolderPtr& holder)
+  {
+    Record& record = this->table_.at(this->table_.insert(id).first);
+    /* Adopted with the default deleters which delete with the heap */
+    record.values = Values(a.release());
+    record.wrappers = Wrappers(wrapper.release());
+    record.holder = Holder(holder.release());
+    record.size = this->holder_size(record.holder.get());
+  }
+  //! Create the items for an id
+  /*! The values are zeroed and the wrappers are default constructed. The
+   *  items of an id that is already contained in the object are replaced.
+   */
+  void create(const Key& id, const Size& size)
+  {
+    Values values = detail::make_array<T>(this->resource_, size);
+    Wrappers wrappers = detail::make_array<W>(this->resource_, size);
+    Holder holder = this->make_holder(size);
+    Record& record = this->table_.at(this->table_.insert(id).first);
+    record.values = std::move(values);
+    record.wrappers = std::move(wrappers);
+    record.holder = std::move(holder);
+    record.size = size;
+  }
+  //! Create the items for a batch of ids
+  /*! The table is grown once for the whole batch and the values and the
+   *  wrappers of all the ids are allocated from one contiguous block each.
+   *  The blocks are kept until the object is destroyed, also when some of
+   *  the ids are removed.
+   */
+  void create_many(const Batch& batch)
+  {
+    size_t total = 0;
+    for (const Entry& entry : batch)
+    {
+      total += entry.second;
+    }
+    this->table_.reserve(this->table_.size() + batch.size());
+
+    Block block;
+    block.values = detail::make_array<T>(this->resource_, total);
+    block.wrappers = detail::make_array<W>(this->resource_, total);
+
+    T* value = block.values.get();
+    W* wrapper = block.wrappers.get();
+    for (const Entry& entry : batch)
+    {
+      Record& record = this->table_.at(this->table_.insert(entry.first).first);
+      /* The records borrow their part of the block */
+      record.values = Values(value, detail::ArrayDeleter<T>::borrowed());
+      record.wrappers = Wrappers(wrapper, detail::ArrayDeleter<W>::borrowed());
+      record.holder = this->make_holder(entry.second);
+      record.size = entry.second;
+      value += entry.second;
+      wrapper += entry.second;
+    }
+
+    this->blocks_.push_back(std::move(block));
   }
   //! Check if the id is contained in the object
-  /*! Returns true if the id is is contained in the object, otherwise false */
-  bool has(const Id& id)
+  /*! Returns true if the id is is contained in the object, otherwise false.
+   *  Like the other lookups by id it takes a view so a literal or a part of
+   *  a larger string is looked up without a temporary id.
+   */
+  bool has(const Key& id) const
   {
-    return this->id_set_.find(id) != this->id_set_.end();
+    return this->table_.find(id) != Table::Npos;
   }
   //! Returns a reference to a value from an array by id and index
-  T& value(const Id& id, const Index& index)
+  /*! The id must be contained in the object, use find_value otherwise */
+  T& value(const Key& id, const Index& index)
   {
-    return this->array_map_[id][index];
+    return this->record(id).values[index];
   }
   //! Returns a reference to a wrapper from an array by id and index
-  W& wrapper(const Id& id, const Index& index)
+  /*! The id must be contained in the object, use find_wrapper otherwise */
+  W& wrapper(const Key& id, const Index& index)
   {
-    return this->wrapper_array_map_[id][index];
+    return this->record(id).wrappers[index];
   }
   //! Returns a reference to a holder by id
-  H& holder(const Id& id) { return *this->holder_map_[id]; }
+  /*! The id must be contained in the object, use find_holder otherwise */
+  H& holder(const Key& id) { return *this->record(id).holder; }
+  //! Find a value from an array by id and index
+  /*! Returns a null pointer if the id is not contained in the object.
+   *  A lookup never inserts the id and never allocates.
+   */
+  T* find_value(const Key& id, const Index& index)
+  {
+    Record* record = this->find(id);
+    return record != nullptr ? &record->values[index] : nullptr;
+  }
+  //! Find a constant value from an array by id and index
+  /*! The internal state of the object stays unchanged by constant guard */
+  const T* find_value(const Key& id, const Index& index) const
+  {
+    const Record* record = this->find(id);
+    return record != nullptr ? &record->values[index] : nullptr;
+  }
+  //! Find a wrapper from an array by id and index
+  /*! Returns a null pointer if the id is not contained in the object.
+   *  A lookup never inserts the id and never allocates.
+   */
+  W* find_wrapper(const Key& id, const Index& index)
+  {
+    Record* record = this->find(id);
+    return record != nullptr ? &record->wrappers[index] : nullptr;
+  }
+  //! Find a constant wrapper from an array by id and index
+  /*! The internal state of the object stays unchanged by constant guard */
+  const W* find_wrapper(const Key& id, const Index& index) const
+  {
+    const Record* record = this->find(id);
+    return record != nullptr ? &record->wrappers[index] : nullptr;
+  }
+  //! Find a holder by id
+  /*! Returns a null pointer if the id is not contained in the object.
+   *  A lookup never inserts the id and never allocates.
+   */
+  H* find_holder(const Key& id)
+  {
+    Record* record = this->find(id);
+    return record != nullptr ? record->holder.get() : nullptr;
+  }
+  //! Find a constant holder by id
+  /*! The internal state of the object stays unchanged by constant guard */
+  const H* find_holder(const Key& id) const
+  {
+    const Record* record = this->find(id);
+    return record != nullptr ? record->holder.get() : nullptr;
+  }
+  //! Resolve an id into a handle
+  /*! The handle stays valid while the id is contained in the object.
+   *  Returns NoHandle if the id is not contained. Takes a view so a literal
+   *  or a part of a larger string can be resolved without a temporary id.
+   */
+  Handle resolve(const Key& id) const
+  {
+    return static_cast<Handle>(this->table_.find(id));
+  }
+  //! Returns a reference to a value from an array by handle and index
+  T& value(const Handle& handle, const Index& index)
+  {
+    return this->record(handle).values[index];
+  }
+  //! Returns a reference to a wrapper from an array by handle and index
+  W& wrapper(const Handle& handle, const Index& index)
+  {
+    return this->record(handle).wrappers[index];
+  }
+  //! Returns a reference to a holder by handle
+  H& holder(const Handle& handle) { return *this->record(handle).holder; }
+  //! The size of the arrays of an id by handle
+  /*! The size of the items inserted by the caller is the size of their
+   *  holder, zero if the holder has no size.
+   */
+  Size array_size(const Handle& handle) const
+  {
+    return this->record(handle).size;
+  }
+  //! Remove an id and release its items
+  /*! Handles of the removed id become invalid, handles of other ids stay
+   *  valid. Returns true if the id was contained in the object.
+   */
+  bool remove(const Key& id) { return this->table_.erase(id); }
+  //! Remove every id and release all items
+  /*! The capacity of the table is kept. When the object allocates from a
+   *  monotonic buffer resource the resource can be released afterwards.
+   */
+  void clear()
+  {
+    this->table_.clear();
+    this->blocks_.clear();
+  }
+  //! The number of ids contained in the object
+  size_t size() const { return this->table_.size(); }
+  //! Call a function with every id, its values, its wrappers and their size
+  /*! The ids are visited in handle order. The size of the items inserted
+   *  by the caller is the size of their holder, zero if the holder has no
+   *  size.
+   */
+  template<typename F> void for_each(F&& f) const
+  {
+    this->table_.for_each([&f](const Record& record)
+    {
+      f(record.id, record.values.get(), record.wrappers.get(), record.size);
+    });
+  }
+  //! The memory resource the object allocates from
+  MemoryResource* resource() const { return this->resource_; }
 
 private:
-  typedef std::map<Id, Array> ArrayMap;
-  typedef std::map<Id, WrapperArray> WrapperArrayMap;
-  typedef std::map<Id, HolderPtr> HolderMap;
-  typedef std::set<Id> IdSet;
-
-  ArrayMap array_map_;
-  WrapperArrayMap wrapper_array_map_;
-  HolderMap holder_map_;
-  IdSet id_set_;
+  /* https://google.github.io/styleguide/cppguide.html#Structs_vs._Classes */
+  /* The deleters know if the items came from the heap, from the resource or
+   * are borrowed from a block */
+  typedef std::unique_ptr<T[], detail::ArrayDeleter<T>> Values;
+  typedef std::unique_ptr<W[], detail::ArrayDeleter<W>> Wrappers;
+  typedef std::unique_ptr<H, detail::ObjectDeleter<H>> Holder;
+
+  struct Record
+  {
+    Id id;
+    Values values;
+    Wrappers wrappers;
+    Holder holder;
+    Size size = 0;
+  };
+
+  /* The arrays of all the ids created by one create_many */
+  struct Block
+  {
+    Values values;
+    Wrappers wrappers;
+  };
+
+  typedef detail::RecordTable<Record> Table;
+  typedef std::pmr::vector<Block> Blocks;
+
+  static_assert(static_cast<Handle>(Table::Npos) == NoHandle,
+    "A handle is a record index");
+
+  Record& record(const Key& id)
+  {
+    typename Table::Index index = this->table_.find(id);
+    assert(index != Table::Npos);
+    return this->table_.at(index);
+  }
+  Record& record(const Handle& handle)
+  {
+    const typename Table::Index index =
+      static_cast<typename Table::Index>(handle);
+    assert(this->table_.live(index));
+    return this->table_.at(index);
+  }
+  const Record& record(const Handle& handle) const
+  {
+    const typename Table::Index index =
+      static_cast<typename Table::Index>(handle);
+    assert(this->table_.live(index));
+    return this->table_.at(index);
+  }
+  Record* find(const Key& id)
+  {
+    typename Table::Index index = this->table_.find(id);
+    return index != Table::Npos ? &this->table_.at(index) : nullptr;
+  }
+  const Record* find(const Key& id) const
+  {
+    typename Table::Index index = this->table_.find(id);
+    return index != Table::Npos ? &this->table_.at(index) : nullptr;
+  }
+  /* A holder that can allocate is handed the resource as well */
+  Holder make_holder(const Size& size)
+  {
+    if constexpr (std::is_constructible<H, Size, MemoryResource*>::value)
+    {
+      return detail::make_object<H>(this->resource_, size, this->resource_);
+    }
+    else
+    {
+      return detail::make_object<H>(this->resource_, size);
+    }
+  }
+
+  static Size holder_size(const H* holder)
+  {
+    if constexpr (detail::HasSize<H>::value)
+    {
+      return holder != nullptr ? static_cast<Size>(holder->size()) : 0;
+    }
+    else
+    {
+      return 0;
+    }
+  }
+
+  MemoryResource* resource_;
+  Table table_;
+  Blocks blocks_;
 };
 
+template<typename T, typename W, typename H>
+const typename Assumption<T, W, H>::Handle Assumption<T, W, H>::NoHandle;
+
 } /* namespace assumption */
 } /* namespace gos */
 
@@ -1,6 +1,11 @@
 #ifndef _GOS_ASSUMPTION_BOOST_H_
 #define _GOS_ASSUMPTION_BOOST_H_
 
+#include <cstdint>
+
+#include <iostream>
+#include <typeinfo>
+
 #include <boost/asio.hpp>
 
 #ifdef _WIN32
@@ -12,6 +17,10 @@
 #ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
 #include <boost/msm/back/state_machine.hpp>
 #include <boost/msm/front/state_machine_def.hpp>
+#include <gos/assumption/machine.h>
+#ifdef _GOS_ASSUMPTION_TRACE_
+#include <gos/assumption/trace.h>
+#endif
 /* Moved to the CMake file */
 #ifndef BOOST_MPL_LIMIT_VECTOR_SIZE
 #define BOOST_MPL_LIMIT_VECTOR_SIZE 30
@@ -27,52 +36,11 @@ namespace assumption
 namespace state_machine_boost_msm
 {
 
-enum class Stage
-{
-  Undefined,
-  Starting,
-  NoData,
-  NoNovosData,
-  NoItgData,
-  HoistConstrainstActivityUnavailable,
-  ActivitiesAvailable,
-  RequestingControl,
-  RelinquishingControl,
-  InControl,
-  Exiting,
-  Out
-};
-
-namespace events
-{
-struct Fundament
-{
-  Fundament(const char* file, const int& line, Stage& stage) :
-    File(file), Line(line), State(stage)
-  {}
-  const char* File;
-  int Line;
-  Stage State;
-};
-struct Started : Fundament
-{
-  Started(const char* file, const int& line, Stage& stage) :
-    Fundament(file, line, stage) { }
-};
-struct NovosDataAvailable {};
-struct NovosDataUnavailable {};
-struct ItgDataAvailable {};
-struct ItgDataUnavailable {};
-struct HoistConstrainstActivityBecomesAvailable {};
-struct HoistConstrainstActivityBecomesUnavailable {};
-struct ControlRequested {};
-struct ControlRelinquished {};
-struct ControlLost {};
-struct Granted {};
-struct Timeout {};
-struct Quit {};
-struct Exited {};
-} // namespace events
+// The stages and the events are shared with the table engine
+typedef ::gos::assumption::state_machine::Stage Stage;
+namespace events = ::gos::assumption::state_machine::events;
+using ::gos::assumption::state_machine::stage_name;
+using ::gos::assumption::state_machine::event_name;
 
 namespace visitors
 {
@@ -96,8 +64,12 @@ public:
   template <class T>
   void visit_state(T* astate, Stage& state)
   {
+#ifdef _GOS_ASSUMPTION_COUT_
     std::cout << "visiting state:" << typeid(*astate).name()
       << " with data:" << state << std::endl;
+#else
+    (void)astate;
+#endif
     this->last_state_ = state;
   }
   const Stage& GetLastState() const
@@ -129,19 +101,100 @@ class Engine_ : public bnf::state_machine_def<Engine_, v::my_visitable_state>
 {
 private:
   Stage last_stage_;
+  ::gos::assumption::state_machine::Published published_;
+  std::uint64_t novos_sequence_;
+  std::uint64_t itg_sequence_;
+  bool novos_accepted_;
+  bool itg_accepted_;
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+  std::uint64_t entered_;
+#endif
 protected:
   void SetLastStage(const Stage& stage) { this->last_stage_ = stage; }
   const Stage GetLastStage() const { return this->last_stage_; }
+  //! Record the entry of a stage from the last stage
+  /*! The entries are printed with the cout option, recorded to the trace
+   *  ring of the thread with the trace option and their latencies to the
+   *  histograms with the histogram option, none costs anything when the
+   *  option is off.
+   */
+  template<class Event>
+  void Enter(const Stage& stage, Event const&, const char* text)
+  {
+#ifdef _GOS_ASSUMPTION_COUT_
+    std::cout << "entering: " << text << std::endl;
+#else
+    (void)text;
+#endif
+#ifdef _GOS_ASSUMPTION_TRACE_
+    ::gos::assumption::trace::Tracer::instance().record(
+      ::gos::assumption::trace::Kind::Entry,
+      static_cast<std::uint16_t>(this->last_stage_),
+      static_cast<std::uint16_t>(stage),
+      static_cast<std::uint16_t>(events::Id<Event>::value));
+#endif
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+    const std::uint64_t now = ::gos::assumption::histogram::Latencies::now();
+    if (this->last_stage_ != Stage::Undefined)
+    {
+      ::gos::assumption::state_machine::latencies().record(
+        static_cast<std::uint16_t>(this->last_stage_),
+        static_cast<std::uint16_t>(stage), now - this->entered_);
+    }
+    this->entered_ = now;
+#endif
+    this->published_.publish(stage, this->last_stage_ != Stage::Undefined);
+    this->last_stage_ = stage;
+  }
+  void Leave(const char* text)
+  {
+#ifdef _GOS_ASSUMPTION_COUT_
+    std::cout << "leaving: " << text << std::endl;
+#else
+    (void)text;
+#endif
+  }
 public:
+  Engine_() :
+    last_stage_(Stage::Undefined),
+    novos_sequence_(0),
+    itg_sequence_(0),
+    novos_accepted_(false),
+    itg_accepted_(false)
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+    , entered_(0)
+#endif
+  {}
+
+  //! The last stage entered, wait free from any thread
+  /*! Published on every entry for monitoring threads polling the engines,
+   *  unlike visiting the current states or GetStage, which are only for
+   *  the thread processing the events.
+   */
+  Stage stage() const { return this->published_.stage(); }
+  //! The number of transitions made, wait free from any thread
+  std::uint64_t transitions() const { return this->published_.transitions(); }
+  //! The sequence of the last NOVOS data frame accepted
+  const std::uint64_t& novos_sequence() const
+  {
+    return this->novos_sequence_;
+  }
+  //! The sequence of the last ITG data frame accepted
+  const std::uint64_t& itg_sequence() const { return this->itg_sequence_; }
+
   template<class Event, class FSM>
   void on_entry(Event const&, FSM&)
   {
+#ifdef _GOS_ASSUMPTION_COUT_
     ::std::cout << "Entering engine" << ::std::endl;
+#endif
   }
   template<class Event, class FSM>
   void on_exit(Event const&, FSM&)
   {
-    ::std::cout << "Entering engine" << ::std::endl;
+#ifdef _GOS_ASSUMPTION_COUT_
+    ::std::cout << "Leaving engine" << ::std::endl;
+#endif
   }
 
   // The list of FSM states
@@ -151,15 +204,12 @@ public:
     template <class Event, class FSM>
     void on_entry(Event const& e, FSM& fsm)
     {
-      fsm.SetLastStage(Stage::Starting);
-      events::Fundament& fundament = (events::Fundament&)e;
-      fundament.State = Stage::Starting;
-      std::cout << "entering: Starting" << std::endl;
+      fsm.Enter(Stage::Starting, e, "Starting");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Starting" << std::endl;
+      fsm.Leave("Starting");
     }
     void accept(visitors::SomeVisitor& vis, Stage& state) const
     {
@@ -171,14 +221,14 @@ public:
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: No data" << std::endl;
+      fsm.Enter(Stage::NoData, e, "No data");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: No data" << std::endl;
+      fsm.Leave("No data");
     }
     void accept(visitors::SomeVisitor& vis, Stage& state) const
     {
@@ -190,126 +240,127 @@ public:
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: No NOVOS data" << std::endl;
+      fsm.Enter(Stage::NoNovosData, e, "No NOVOS data");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: No NOVOS data" << std::endl;
+      fsm.Leave("No NOVOS data");
     }
   };
   struct NoItgData : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: No ITG data" << std::endl;
+      fsm.Enter(Stage::NoItgData, e, "No ITG data");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: No ITG data" << std::endl;
+      fsm.Leave("No ITG data");
     }
   };
   struct HoistConstrainstActivityUnavailable : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: Hoist Constrainst Activity Unavailable" << std::endl;
+      fsm.Enter(Stage::HoistConstrainstActivityUnavailable, e,
+        "Hoist Constrainst Activity Unavailable");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Hoist Constrainst Activity Unavailable" << std::endl;
+      fsm.Leave("Hoist Constrainst Activity Unavailable");
     }
   };
   struct ActivitiesAvailable : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: Activities Available" << std::endl;
+      fsm.Enter(Stage::ActivitiesAvailable, e, "Activities Available");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Activities Available" << std::endl;
+      fsm.Leave("Activities Available");
     }
   };
   struct RequestingControl : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: Requesting Control" << std::endl;
+      fsm.Enter(Stage::RequestingControl, e, "Requesting Control");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Requesting Control" << std::endl;
+      fsm.Leave("Requesting Control");
     }
   };
   struct RelinquishingControl : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: Relinquishing Control" << std::endl;
+      fsm.Enter(Stage::RelinquishingControl, e, "Relinquishing Control");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Relinquishing Control" << std::endl;
+      fsm.Leave("Relinquishing Control");
     }
   };
   struct InControl : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: In Control" << std::endl;
+      fsm.Enter(Stage::InControl, e, "In Control");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: In Control" << std::endl;
+      fsm.Leave("In Control");
     }
   };
   struct Exiting : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: Exiting" << std::endl;
+      fsm.Enter(Stage::Exiting, e, "Exiting");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Exiting" << std::endl;
+      fsm.Leave("Exiting");
     }
   };
   struct Out : public ::boost::msm::front::state<>
   {
     // every (optional) entry/exit methods get the event passed.
     template <class Event, class FSM>
-    void on_entry(Event const&, FSM&)
+    void on_entry(Event const& e, FSM& fsm)
     {
-      std::cout << "entering: Out" << std::endl;
+      fsm.Enter(Stage::Out, e, "Out");
     }
     template <class Event, class FSM>
-    void on_exit(Event const&, FSM&)
+    void on_exit(Event const&, FSM& fsm)
     {
-      std::cout << "leaving: Out" << std::endl;
+      fsm.Leave("Out");
     }
   };
 
@@ -341,6 +392,36 @@ public:
   {
   }
 
+  // Data guards and actions, a frame not newer than the last is stale, the
+  // first frame is fresh whatever its sequence and the frames are read
+  // where they are
+  bool Fresh(events::NovosDataAvailable const& e)
+  {
+    return e.Data.empty() || !this->novos_accepted_ ||
+      e.Data.sequence() > this->novos_sequence_;
+  }
+  bool Fresh(events::ItgDataAvailable const& e)
+  {
+    return e.Data.empty() || !this->itg_accepted_ ||
+      e.Data.sequence() > this->itg_sequence_;
+  }
+  void Accept(events::NovosDataAvailable const& e)
+  {
+    if (!e.Data.empty())
+    {
+      this->novos_sequence_ = e.Data.sequence();
+      this->novos_accepted_ = true;
+    }
+  }
+  void Accept(events::ItgDataAvailable const& e)
+  {
+    if (!e.Data.empty())
+    {
+      this->itg_sequence_ = e.Data.sequence();
+      this->itg_accepted_ = true;
+    }
+  }
+
   // Shorten some types
   // Events
   typedef events::Started Started;
@@ -371,14 +452,15 @@ public:
     //  +--------------+--------------+--------------+----------+----------+
     _row < Starting, Started, NoData >,
     //  +--------------+--------------+--------------+----------+----------+
-    _row < NoData, NovosData, NoItgData >,
-    _row < NoData, ItgData, NoNovosData >,
+    row < NoData, NovosData, NoItgData, &Engine_::Accept, &Engine_::Fresh >,
+    row < NoData, ItgData, NoNovosData, &Engine_::Accept, &Engine_::Fresh >,
     _row < NoItgData, NovosDataAway, NoData >,
     _row < NoNovosData, ItgDataAway, NoData >,
     //  +--------------+--------------+--------------+----------+----------+
-    _row < NoItgData, ItgData, HoistUnavail >,
+    row < NoItgData, ItgData, HoistUnavail, &Engine_::Accept, &Engine_::Fresh >,
     _row < HoistUnavail, ItgDataAway, NoItgData >,
-    _row < NoNovosData, NovosData, HoistUnavail >,
+    row < NoNovosData, NovosData, HoistUnavail,
+      &Engine_::Accept, &Engine_::Fresh >,
     _row < HoistUnavail, NovosDataAway, NoNovosData >,
     _row < HoistUnavail, HoistReady, Available >,
     //  +--------------+--------------+--------------+----------+----------+
@@ -415,8 +497,20 @@ public:
   template <class FSM, class Event>
   void no_transition(Event const& e, FSM&, int state)
   {
+#ifdef _GOS_ASSUMPTION_COUT_
     std::cout << "no transition from state " << state
       << " on event " << typeid(e).name() << std::endl;
+#else
+    (void)e;
+    (void)state;
+#endif
+#ifdef _GOS_ASSUMPTION_TRACE_
+    ::gos::assumption::trace::Tracer::instance().record(
+      ::gos::assumption::trace::Kind::NoTransition,
+      static_cast<std::uint16_t>(this->last_stage_),
+      static_cast<std::uint16_t>(this->last_stage_),
+      static_cast<std::uint16_t>(events::Id<Event>::value));
+#endif
   }
 
   // Pick a back-end
@@ -429,6 +523,79 @@ public:
   const Stage GetStage() const { return GetLastStage(); }
 };
 
+//! Process the event of an id
+/*! The events posted by id carry no data frame. Returns false for an
+ *  unknown id.
+ */
+inline bool process(StateEngine& engine, const events::EventId& id)
+{
+  switch (id)
+  {
+  case events::EventId::Started:
+    engine.process_event(
+      events::Started(__FILE__, __LINE__, Stage::Undefined));
+    return true;
+  case events::EventId::NovosDataAvailable:
+    engine.process_event(events::NovosDataAvailable());
+    return true;
+  case events::EventId::NovosDataUnavailable:
+    engine.process_event(events::NovosDataUnavailable());
+    return true;
+  case events::EventId::ItgDataAvailable:
+    engine.process_event(events::ItgDataAvailable());
+    return true;
+  case events::EventId::ItgDataUnavailable:
+    engine.process_event(events::ItgDataUnavailable());
+    return true;
+  case events::EventId::HoistConstrainstActivityBecomesAvailable:
+    engine.process_event(events::HoistConstrainstActivityBecomesAvailable());
+    return true;
+  case events::EventId::HoistConstrainstActivityBecomesUnavailable:
+    engine.process_event(
+      events::HoistConstrainstActivityBecomesUnavailable());
+    return true;
+  case events::EventId::ControlRequested:
+    engine.process_event(events::ControlRequested());
+    return true;
+  case events::EventId::ControlRelinquished:
+    engine.process_event(events::ControlRelinquished());
+    return true;
+  case events::EventId::ControlLost:
+    engine.process_event(events::ControlLost());
+    return true;
+  case events::EventId::Granted:
+    engine.process_event(events::Granted());
+    return true;
+  case events::EventId::Timeout:
+    engine.process_event(events::Timeout());
+    return true;
+  case events::EventId::Quit:
+    engine.process_event(events::Quit());
+    return true;
+  case events::EventId::Exited:
+    engine.process_event(events::Exited());
+    return true;
+  default:
+    return false;
+  }
+}
+
+//! Dispatches the Timeout event to the engines of expired timers
+/*! The fire function of a WheelTimer<StateEngine*>, the engines that are
+ *  Requesting or Relinquishing control when their timer expires fall back
+ *  to Available.
+ */
+struct TimeoutDispatcher
+{
+  template<typename B> void operator()(const B& engines) const
+  {
+    for (StateEngine* engine : engines)
+    {
+      engine->process_event(events::Timeout());
+    }
+  }
+};
+
 } // namespace state_machine_boost_msm
 
 #endif
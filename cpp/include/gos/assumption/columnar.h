@@ -0,0 +1,368 @@
+#ifndef _GOS_ASSUMPTION_COLUMNAR_H_
+#define _GOS_ASSUMPTION_COLUMNAR_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gos/assumption.h>
+#include <gos/assumption/memory.h>
+#include <gos/assumption/span.h>
+#include <gos/assumption/table.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! The Assumption storage in columns
+/*! The raw values of every id live contiguously in one arena and the set
+ *  flags live in a separate bitmap with one bit for each value. Each id owns
+ *  a slice of the arena that is exposed as a span, so scanning the values of
+ *  many ids streams memory linearly instead of chasing a pointer and a
+ *  wrapper object for each value.
+ *  Spans are invalidated when ids are created, the offsets of the slices and
+ *  the handles are not.
+ *  The slices of removed ids are kept in a free list and reused by the ids
+ *  created later, adjacent free slices are merged. An id created again keeps
+ *  its slice if the new size fits in it. The arena therefore only grows when
+ *  no free slice is large enough, so a registry whose ids come and go stays
+ *  bounded by the most values it held at once plus the fragmentation.
+ *  The table, the arena, the bitmap and the free list are allocated from the
+ *  memory resource given at construction.
+ */
+template<typename T> class ColumnarAssumption
+{
+public:
+  //! The id type
+  typedef std::string Id;
+  //! The id view type
+  typedef std::string_view Key;
+  //! The index type
+  typedef unsigned int Index;
+  //! The size type
+  typedef Index Size;
+  //! The handle type
+  typedef ::gos::interfaces::Handle Handle;
+  //! The type of an id and the array size to create for it
+  typedef std::pair<Id, Size> Entry;
+  //! The type of a batch of ids to create in bulk
+  typedef std::vector<Entry> Batch;
+  //! The type of a word in the set flag bitmap
+  typedef std::uint64_t Word;
+  //! The wrapper type equivalent to a value and its set flag
+  typedef gos::assumption::Wrapper<T> WrapperType;
+
+  //! The handle returned when resolving an id that is not contained
+  static const Handle NoHandle = ::gos::interfaces::NoHandle;
+  //! The number of set flags in a bitmap word
+  static const size_t WordBits = 8 * sizeof(Word);
+
+  //! A Constructor that takes the memory resource to allocate from
+  /*! The resource must outlive the object */
+  ColumnarAssumption(
+    MemoryResource* resource = std::pmr::get_default_resource()) :
+    table_(resource), values_(resource), bits_(resource), free_(resource)
+  {}
+
+  //! Create the slice for an id
+  /*! The values are zeroed and unset. The slice of an id that is already
+   *  contained in the object is replaced, in place if the size fits.
+   */
+  void create(const Key& id, const Size& size)
+  {
+    const std::pair<typename Table::Index, bool> inserted =
+      this->table_.insert(id);
+    this->place(this->table_.at(inserted.first), inserted.second, size);
+  }
+  //! Create the slices for a batch of ids
+  /*! The table, the arena and the bitmap are grown at most once for the
+   *  batch, the free slices are used first
+   */
+  void create_many(const Batch& batch)
+  {
+    size_t total = 0;
+    for (const Entry& entry : batch)
+    {
+      total += entry.second;
+    }
+    this->table_.reserve(this->table_.size() + batch.size());
+    this->values_.reserve(this->values_.size() + total);
+    this->bits_.reserve(
+      (this->values_.size() + total + WordBits - 1) / WordBits);
+    for (const Entry& entry : batch)
+    {
+      const std::pair<typename Table::Index, bool> inserted =
+        this->table_.insert(entry.first);
+      this->place(
+        this->table_.at(inserted.first), inserted.second, entry.second);
+    }
+  }
+  //! Remove an id
+  /*! The slice of the id is zeroed and unset and kept for reuse */
+  bool remove(const Key& id)
+  {
+    const typename Table::Index index = this->table_.find(id);
+    if (index == Table::Npos)
+    {
+      return false;
+    }
+    const Record& record = this->table_.at(index);
+    this->release(record.offset, record.size);
+    return this->table_.erase(id);
+  }
+
+  //! Check if the id is contained in the object
+  bool has(const Key& id) const
+  {
+    return this->table_.find(id) != Table::Npos;
+  }
+  //! Resolve an id into a handle that stays valid while it is contained
+  Handle resolve(const Key& id) const
+  {
+    return static_cast<Handle>(this->table_.find(id));
+  }
+  //! The number of ids contained in the object
+  size_t size() const { return this->table_.size(); }
+
+  //! The slice of values of an id
+  Span<T> values(const Handle& handle)
+  {
+    const Record& record = this->record(handle);
+    return Span<T>(this->values_.data() + record.offset, record.size);
+  }
+  //! The constant slice of values of an id
+  Span<const T> values(const Handle& handle) const
+  {
+    const Record& record = this->record(handle);
+    return Span<const T>(this->values_.data() + record.offset, record.size);
+  }
+  //! The slice of values of an id or an empty span if it is not contained
+  Span<T> values(const Key& id)
+  {
+    const Handle handle = this->resolve(id);
+    return handle != NoHandle ? this->values(handle) : Span<T>();
+  }
+  //! The constant slice of values of an id or an empty span
+  Span<const T> values(const Key& id) const
+  {
+    const Handle handle = this->resolve(id);
+    return handle != NoHandle ? this->values(handle) : Span<const T>();
+  }
+
+  //! Check if a value of an id has been set
+  bool is_set(const Handle& handle, const Index& index) const
+  {
+    return this->test(this->position(handle, index));
+  }
+  //! Set a value of an id
+  void set(const Handle& handle, const Index& index, const T& value)
+  {
+    const size_t position = this->position(handle, index);
+    this->values_[position] = value;
+    this->bits_[position / WordBits] |= Word(1) << (position % WordBits);
+  }
+  //! Unset a value of an id and zero it
+  void reset(const Handle& handle, const Index& index)
+  {
+    const size_t position = this->position(handle, index);
+    this->values_[position] = T();
+    this->bits_[position / WordBits] &= ~(Word(1) << (position % WordBits));
+  }
+  //! A wrapper equivalent to a value of an id and its set flag
+  WrapperType wrapper(const Handle& handle, const Index& index) const
+  {
+    const size_t position = this->position(handle, index);
+    return this->test(position) ?
+      WrapperType(this->values_[position]) : WrapperType();
+  }
+  //! The offset of the slice of an id in the arena
+  size_t offset(const Handle& handle) const
+  {
+    return this->record(handle).offset;
+  }
+
+  //! The number of values of the free slices
+  size_t available() const
+  {
+    size_t result = 0;
+    for (const Slice& slice : this->free_)
+    {
+      result += slice.size;
+    }
+    return result;
+  }
+
+  //! The whole arena of values of all the ids
+  Span<T> arena()
+  {
+    return Span<T>(this->values_.data(), this->values_.size());
+  }
+  //! The whole constant arena of values of all the ids
+  Span<const T> arena() const
+  {
+    return Span<const T>(this->values_.data(), this->values_.size());
+  }
+  //! The set flag bitmap of the whole arena
+  /*! The flag of the value at position p of the arena is the bit p modulo
+   *  WordBits of the word p divided by WordBits.
+   */
+  Span<const Word> bitmap() const
+  {
+    return Span<const Word>(this->bits_.data(), this->bits_.size());
+  }
+
+private:
+  struct Record
+  {
+    Id id;
+    size_t offset = 0;
+    Size size = 0;
+  };
+
+  /* A free part of the arena, zeroed and unset */
+  struct Slice
+  {
+    size_t offset;
+    size_t size;
+  };
+
+  typedef detail::RecordTable<Record> Table;
+  typedef std::pmr::vector<T> Values;
+  typedef std::pmr::vector<Word> Bits;
+  typedef std::pmr::vector<Slice> Slices;
+
+  static_assert(static_cast<Handle>(Table::Npos) == NoHandle,
+    "A handle is a record index");
+
+  const Record& record(const Handle& handle) const
+  {
+    const typename Table::Index index =
+      static_cast<typename Table::Index>(handle);
+    assert(this->table_.live(index));
+    return this->table_.at(index);
+  }
+  size_t position(const Handle& handle, const Index& index) const
+  {
+    const Record& record = this->record(handle);
+    assert(index < record.size);
+    return record.offset + index;
+  }
+  bool test(const size_t& position) const
+  {
+    return (this->bits_[position / WordBits] >> (position % WordBits)) & 1;
+  }
+  void grow(const size_t& count)
+  {
+    this->values_.resize(this->values_.size() + count, T());
+    this->bits_.resize((this->values_.size() + WordBits - 1) / WordBits, 0);
+  }
+  void clear(const size_t& offset, const size_t& size)
+  {
+    for (size_t i = offset; i < offset + size; i++)
+    {
+      this->values_[i] = T();
+      this->bits_[i / WordBits] &= ~(Word(1) << (i % WordBits));
+    }
+  }
+  /* Give a record a zeroed slice of a size, keeping its own if it fits */
+  void place(Record& record, const bool& inserted, const Size& size)
+  {
+    if (!inserted && size <= record.size)
+    {
+      this->clear(record.offset, size);
+      this->release(record.offset + size, record.size - size);
+      record.size = size;
+      return;
+    }
+    if (!inserted)
+    {
+      this->release(record.offset, record.size);
+    }
+    record.offset = this->allocate(size);
+    record.size = size;
+  }
+  /* The first free slice large enough or a new one at the end */
+  size_t allocate(const size_t& size)
+  {
+    if (size == 0)
+    {
+      return 0;
+    }
+    for (size_t i = 0; i < this->free_.size(); i++)
+    {
+      Slice& slice = this->free_[i];
+      if (slice.size >= size)
+      {
+        const size_t offset = slice.offset;
+        slice.offset += size;
+        slice.size -= size;
+        if (slice.size == 0)
+        {
+          this->free_.erase(this->free_.begin() + i);
+        }
+        return offset;
+      }
+    }
+    const size_t offset = this->values_.size();
+    this->grow(size);
+    return offset;
+  }
+  /* Zero a slice and add it to the free list sorted by offset, merged
+   * with the free slices next to it */
+  void release(const size_t& offset, const size_t& size)
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    this->clear(offset, size);
+    typename Slices::iterator next = std::lower_bound(
+      this->free_.begin(), this->free_.end(), offset,
+      [](const Slice& slice, const size_t& at) { return slice.offset < at; });
+    if (next != this->free_.begin())
+    {
+      Slice& previous = *(next - 1);
+      if (previous.offset + previous.size == offset)
+      {
+        previous.size += size;
+        if (next != this->free_.end() &&
+          previous.offset + previous.size == next->offset)
+        {
+          previous.size += next->size;
+          this->free_.erase(next);
+        }
+        return;
+      }
+    }
+    if (next != this->free_.end() && offset + size == next->offset)
+    {
+      next->offset = offset;
+      next->size += size;
+      return;
+    }
+    this->free_.insert(next, Slice{ offset, size });
+  }
+
+  Table table_;
+  Values values_;
+  Bits bits_;
+  Slices free_;
+};
+
+template<typename T>
+const typename ColumnarAssumption<T>::Handle ColumnarAssumption<T>::NoHandle;
+template<typename T>
+const size_t ColumnarAssumption<T>::WordBits;
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_COLUMNAR_H_ */
@@ -0,0 +1,220 @@
+#ifndef _GOS_ASSUMPTION_CONCURRENT_H_
+#define _GOS_ASSUMPTION_CONCURRENT_H_
+
+#include <cassert>
+#include <cstdint>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include <gos/assumption.h>
+#include <gos/assumption/table.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! The thread safe Assumption sharded by the hash of the id
+/*! Every id lives in exactly one shard, an Assumption guarded by its own
+ *  reader writer lock, so threads working on ids in different shards never
+ *  contend and readers of the same shard share the lock.
+ *  References into the storage are never handed out since they would outlive
+ *  the lock, values are copied in and out or accessed inside update.
+ */
+template<typename T, typename W, typename H> class ConcurrentAssumption
+{
+public:
+  //! The assumption type of a shard
+  typedef gos::assumption::Assumption<T, W, H> Shard;
+  //! The id type
+  typedef typename Shard::Id Id;
+  //! The id view type
+  typedef typename Shard::Key Key;
+  //! The index type
+  typedef typename Shard::Index Index;
+  //! The size type
+  typedef typename Shard::Size Size;
+  //! The handle type of a shard
+  typedef typename Shard::Handle Handle;
+  //! The type of an id and the array size to create for it
+  typedef typename Shard::Entry Entry;
+  //! The type of a batch of ids to create in bulk
+  typedef typename Shard::Batch Batch;
+
+  //! The default number of shards
+  static const size_t DefaultShards = 64;
+
+  //! A Constructor that takes the number of shards
+  /*! The number is rounded up to a power of two */
+  ConcurrentAssumption(const size_t& shards = DefaultShards) : shift_(64)
+  {
+    size_t count = 1;
+    while (count < shards)
+    {
+      count *= 2;
+      this->shift_--;
+    }
+    this->shards_ = std::make_unique<Slot[]>(count);
+    this->count_ = count;
+  }
+
+  //! Create the items for an id
+  void create(const Key& id, const Size& size)
+  {
+    Slot& slot = this->slot(id);
+    std::unique_lock<std::shared_mutex> lock(slot.mutex);
+    slot.shard.create(id, size);
+  }
+  //! Create the items for a batch of ids
+  /*! The batch is split by shard and each shard is locked once */
+  void create_many(const Batch& batch)
+  {
+    std::vector<Batch> batches(this->count_);
+    for (const Entry& entry : batch)
+    {
+      batches[this->index(entry.first)].push_back(entry);
+    }
+    for (size_t i = 0; i < this->count_; i++)
+    {
+      if (!batches[i].empty())
+      {
+        std::unique_lock<std::shared_mutex> lock(this->shards_[i].mutex);
+        this->shards_[i].shard.create_many(batches[i]);
+      }
+    }
+  }
+  //! Remove an id and release its items
+  bool remove(const Key& id)
+  {
+    Slot& slot = this->slot(id);
+    std::unique_lock<std::shared_mutex> lock(slot.mutex);
+    return slot.shard.remove(id);
+  }
+  //! Check if the id is contained in the object
+  bool has(const Key& id) const
+  {
+    const Slot& slot = this->slot(id);
+    std::shared_lock<std::shared_mutex> lock(slot.mutex);
+    return slot.shard.resolve(id) != Shard::NoHandle;
+  }
+
+  //! Get a copy of a value by id and index
+  /*! Returns no value if the id is not contained in the object */
+  std::optional<T> value(const Key& id, const Index& index) const
+  {
+    const Slot& slot = this->slot(id);
+    std::shared_lock<std::shared_mutex> lock(slot.mutex);
+    const T* value = slot.shard.find_value(id, index);
+    return value != nullptr ? std::optional<T>(*value) : std::nullopt;
+  }
+  //! Get a copy of a wrapper by id and index
+  /*! Returns no wrapper if the id is not contained in the object */
+  std::optional<W> wrapper(const Key& id, const Index& index) const
+  {
+    const Slot& slot = this->slot(id);
+    std::shared_lock<std::shared_mutex> lock(slot.mutex);
+    const W* wrapper = slot.shard.find_wrapper(id, index);
+    return wrapper != nullptr ? std::optional<W>(*wrapper) : std::nullopt;
+  }
+  //! Set a value by id and index
+  /*! Returns false if the id is not contained in the object */
+  bool set_value(const Key& id, const Index& index, const T& value)
+  {
+    Slot& slot = this->slot(id);
+    std::unique_lock<std::shared_mutex> lock(slot.mutex);
+    T* target = slot.shard.find_value(id, index);
+    if (target == nullptr)
+    {
+      return false;
+    }
+    *target = value;
+    return true;
+  }
+  //! Set a wrapper by id and index
+  /*! Returns false if the id is not contained in the object */
+  bool set_wrapper(const Key& id, const Index& index, const W& wrapper)
+  {
+    Slot& slot = this->slot(id);
+    std::unique_lock<std::shared_mutex> lock(slot.mutex);
+    W* target = slot.shard.find_wrapper(id, index);
+    if (target == nullptr)
+    {
+      return false;
+    }
+    *target = wrapper;
+    return true;
+  }
+  //! Access the items of an id exclusively
+  /*! The function is called with the shard and the handle of the id while
+   *  the shard is locked. Returns false if the id is not contained.
+   */
+  template<typename F> bool update(const Key& id, F function)
+  {
+    Slot& slot = this->slot(id);
+    std::unique_lock<std::shared_mutex> lock(slot.mutex);
+    const Handle handle = slot.shard.resolve(id);
+    if (handle == Shard::NoHandle)
+    {
+      return false;
+    }
+    function(slot.shard, handle);
+    return true;
+  }
+
+  //! The number of ids contained in the object
+  /*! The shards are counted one after another so the result is only exact
+   *  when no other thread creates or removes ids.
+   */
+  size_t size() const
+  {
+    size_t size = 0;
+    for (size_t i = 0; i < this->count_; i++)
+    {
+      std::shared_lock<std::shared_mutex> lock(this->shards_[i].mutex);
+      size += this->shards_[i].shard.size();
+    }
+    return size;
+  }
+  //! The number of shards
+  size_t shards() const { return this->count_; }
+  //! The shard of an id
+  size_t index(const Key& id) const
+  {
+    /* The tables inside the shards probe with the low bits of the same hash
+     * so the shard is picked from the high bits of a mixed hash */
+    const std::uint64_t hash =
+      static_cast<std::uint64_t>(detail::hash(id)) * 0x9e3779b97f4a7c15ull;
+    return this->shift_ < 64 ? static_cast<size_t>(hash >> this->shift_) : 0;
+  }
+
+private:
+  /* Every shard is kept on its own cache lines to avoid false sharing */
+  struct alignas(64) Slot
+  {
+    mutable std::shared_mutex mutex;
+    Shard shard;
+  };
+
+  Slot& slot(const Key& id) { return this->shards_[this->index(id)]; }
+  const Slot& slot(const Key& id) const
+  {
+    return this->shards_[this->index(id)];
+  }
+
+  std::unique_ptr<Slot[]> shards_;
+  size_t count_;
+  unsigned int shift_;
+};
+
+template<typename T, typename W, typename H>
+const size_t ConcurrentAssumption<T, W, H>::DefaultShards;
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_CONCURRENT_H_ */
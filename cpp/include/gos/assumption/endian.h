@@ -0,0 +1,409 @@
+#ifndef _GOS_ASSUMPTION_ENDIAN_H_
+#define _GOS_ASSUMPTION_ENDIAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__) || \
+  defined(_M_X64) || defined(_M_IX86)
+#if defined(__GNUC__) || defined(__clang__)
+#define _GOS_ASSUMPTION_ENDIAN_X86_
+#define _GOS_ASSUMPTION_ENDIAN_TARGET_(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER)
+#define _GOS_ASSUMPTION_ENDIAN_X86_
+#define _GOS_ASSUMPTION_ENDIAN_TARGET_(isa)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_GOS_ASSUMPTION_ENDIAN_X86_)
+#include <immintrin.h>
+#endif
+
+namespace gos
+{
+namespace assumption
+{
+namespace endian
+{
+
+//! The instruction sets the byte swap kernels are implemented with
+enum class Kernel
+{
+  Scalar,
+  Ssse3,
+  Avx2
+};
+
+//! True when the native byte order is little endian
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+  __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool NativeLittle = false;
+#else
+const bool NativeLittle = true;
+#endif
+
+namespace detail
+{
+
+//! A kernel reversing the bytes of count values of one width
+/*! The source and the destination may be unaligned and may be the same
+ *  buffer but must not otherwise overlap.
+ */
+typedef void (*Swap)(
+  unsigned char* destination, const unsigned char* source, std::size_t count);
+
+inline std::uint16_t reverse(const std::uint16_t& value)
+{
+  return static_cast<std::uint16_t>((value >> 8) | (value << 8));
+}
+inline std::uint32_t reverse(const std::uint32_t& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(value);
+#elif defined(_MSC_VER)
+  return _byteswap_ulong(value);
+#else
+  return (value >> 24) | ((value >> 8) & 0xff00u) |
+    ((value << 8) & 0xff0000u) | (value << 24);
+#endif
+}
+inline std::uint64_t reverse(const std::uint64_t& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+  return _byteswap_uint64(value);
+#else
+  return (static_cast<std::uint64_t>(reverse(
+    static_cast<std::uint32_t>(value))) << 32) |
+    reverse(static_cast<std::uint32_t>(value >> 32));
+#endif
+}
+
+//! The portable kernel, one value at a time
+template<typename U> void swap_scalar(
+  unsigned char* destination, const unsigned char* source, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; i++)
+  {
+    U value;
+    std::memcpy(&value, source + i * sizeof(U), sizeof(U));
+    value = reverse(value);
+    std::memcpy(destination + i * sizeof(U), &value, sizeof(U));
+  }
+}
+
+#if defined(_GOS_ASSUMPTION_ENDIAN_X86_)
+
+/* The shuffle reversing the bytes of each value of a width in 16 bytes */
+template<std::size_t Width> struct Shuffle;
+template<> struct Shuffle<2>
+{
+  static const char* bytes()
+  {
+    static const char Bytes[16] =
+      { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+    return Bytes;
+  }
+};
+template<> struct Shuffle<4>
+{
+  static const char* bytes()
+  {
+    static const char Bytes[16] =
+      { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+    return Bytes;
+  }
+};
+template<> struct Shuffle<8>
+{
+  static const char* bytes()
+  {
+    static const char Bytes[16] =
+      { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+    return Bytes;
+  }
+};
+
+//! The SSSE3 kernel, 16 bytes per shuffle
+template<typename U> _GOS_ASSUMPTION_ENDIAN_TARGET_("ssse3")
+void swap_ssse3(
+  unsigned char* destination, const unsigned char* source, std::size_t count)
+{
+  const __m128i mask = _mm_loadu_si128(
+    reinterpret_cast<const __m128i*>(Shuffle<sizeof(U)>::bytes()));
+  const std::size_t bytes = count * sizeof(U);
+  std::size_t i = 0;
+  for (; i + 16 <= bytes; i += 16)
+  {
+    const __m128i value =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i),
+      _mm_shuffle_epi8(value, mask));
+  }
+  swap_scalar<U>(destination + i, source + i, (bytes - i) / sizeof(U));
+}
+
+//! The AVX2 kernel, two shuffles of 32 bytes per iteration
+/*! The shuffle works within each 16 byte lane which is all a byte swap of
+ *  values of at most 8 bytes needs. */
+template<typename U> _GOS_ASSUMPTION_ENDIAN_TARGET_("avx2")
+void swap_avx2(
+  unsigned char* destination, const unsigned char* source, std::size_t count)
+{
+  const __m128i lane = _mm_loadu_si128(
+    reinterpret_cast<const __m128i*>(Shuffle<sizeof(U)>::bytes()));
+  const __m256i mask = _mm256_broadcastsi128_si256(lane);
+  const std::size_t bytes = count * sizeof(U);
+  std::size_t i = 0;
+  for (; i + 64 <= bytes; i += 64)
+  {
+    const __m256i first =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+    const __m256i second =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),
+      _mm256_shuffle_epi8(first, mask));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 32),
+      _mm256_shuffle_epi8(second, mask));
+  }
+  for (; i + 32 <= bytes; i += 32)
+  {
+    const __m256i value =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i),
+      _mm256_shuffle_epi8(value, mask));
+  }
+  swap_scalar<U>(destination + i, source + i, (bytes - i) / sizeof(U));
+}
+
+#endif
+
+} /* namespace detail */
+
+//! Check if the processor supports the instructions of a kernel
+inline bool supports(const Kernel& kernel)
+{
+  switch (kernel)
+  {
+  case Kernel::Scalar:
+    return true;
+#if defined(_GOS_ASSUMPTION_ENDIAN_X86_)
+#if defined(__GNUC__) || defined(__clang__)
+  case Kernel::Ssse3:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+  case Kernel::Avx2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+  case Kernel::Ssse3:
+  {
+    int registers[4];
+    __cpuid(registers, 1);
+    return (registers[2] & (1 << 9)) != 0;
+  }
+  case Kernel::Avx2:
+  {
+    int registers[4];
+    __cpuid(registers, 1);
+    /* The operating system must save the AVX registers */
+    const bool osxsave = (registers[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 6) != 6)
+    {
+      return false;
+    }
+    __cpuidex(registers, 7, 0);
+    return (registers[1] & (1 << 5)) != 0;
+  }
+#endif
+#endif
+  default:
+    return false;
+  }
+}
+
+//! The fastest kernel the processor supports
+/*! Detected once, later calls return the detected kernel */
+inline Kernel kernel()
+{
+  static const Kernel Detected =
+    supports(Kernel::Avx2) ? Kernel::Avx2 :
+    supports(Kernel::Ssse3) ? Kernel::Ssse3 : Kernel::Scalar;
+  return Detected;
+}
+
+namespace detail
+{
+
+//! The kernel for values of the width of U
+template<typename U> Swap swap(const Kernel& kernel)
+{
+#if defined(_GOS_ASSUMPTION_ENDIAN_X86_)
+  switch (kernel)
+  {
+  case Kernel::Avx2: return &swap_avx2<U>;
+  case Kernel::Ssse3: return &swap_ssse3<U>;
+  default: break;
+  }
+#endif
+  return &swap_scalar<U>;
+}
+
+//! The unsigned type of the width of a value type
+template<std::size_t Width> struct Unsigned;
+template<> struct Unsigned<1> { typedef std::uint8_t Type; };
+template<> struct Unsigned<2> { typedef std::uint16_t Type; };
+template<> struct Unsigned<4> { typedef std::uint32_t Type; };
+template<> struct Unsigned<8> { typedef std::uint64_t Type; };
+
+//! Copy count values of a width and reverse their bytes unless native
+template<typename U> void reorder(
+  unsigned char* destination, const unsigned char* source,
+  const std::size_t& count, const bool& little)
+{
+  if (little == NativeLittle)
+  {
+    if (destination != source)
+    {
+      std::memcpy(destination, source, count * sizeof(U));
+    }
+    return;
+  }
+  /* Less than a vector is not worth the indirect call */
+  if (count * sizeof(U) < 16)
+  {
+    swap_scalar<U>(destination, source, count);
+    return;
+  }
+  /* The detected kernel is looked up once for each width */
+  static const Swap Detected = swap<U>(endian::kernel());
+  Detected(destination, source, count);
+}
+
+//! Copy count values and reverse their bytes unless the order is native
+template<typename T> void convert(
+  unsigned char* destination, const unsigned char* source,
+  const std::size_t& count, const bool& little)
+{
+  static_assert(std::is_arithmetic<T>::value,
+    "Only integers and floating point values have a byte order");
+  if constexpr (sizeof(T) == 1)
+  {
+    if (destination != source)
+    {
+      std::memcpy(destination, source, count);
+    }
+  }
+  else
+  {
+    reorder<typename Unsigned<sizeof(T)>::Type>(
+      destination, source, count, little);
+  }
+}
+
+} /* namespace detail */
+
+//! Reverse the bytes of count values of type T with a chosen kernel
+/*! The kernel must be supported by the processor. In place when the source
+ *  and the destination are the same.
+ */
+template<typename T> void swap(
+  void* destination, const void* source, const std::size_t& count,
+  const Kernel& kernel)
+{
+  if constexpr (sizeof(T) == 1)
+  {
+    std::memmove(destination, source, count);
+  }
+  else
+  {
+    typedef typename detail::Unsigned<sizeof(T)>::Type U;
+    detail::swap<U>(kernel)(static_cast<unsigned char*>(destination),
+      static_cast<const unsigned char*>(source), count);
+  }
+}
+
+//! Store values into a buffer in big endian order
+/*! The buffer may be unaligned. Returns the end of the stored values. */
+template<typename T> void* store_big_endian_array(
+  void* pointer, const T* values, std::size_t count)
+{
+  unsigned char* destination = static_cast<unsigned char*>(pointer);
+  detail::convert<T>(destination,
+    reinterpret_cast<const unsigned char*>(values), count, false);
+  return destination + count * sizeof(T);
+}
+
+//! Store values into a buffer in little endian order
+/*! The buffer may be unaligned. Returns the end of the stored values. */
+template<typename T> void* store_little_endian_array(
+  void* pointer, const T* values, std::size_t count)
+{
+  unsigned char* destination = static_cast<unsigned char*>(pointer);
+  detail::convert<T>(destination,
+    reinterpret_cast<const unsigned char*>(values), count, true);
+  return destination + count * sizeof(T);
+}
+
+//! Load values stored in big endian order from a buffer
+/*! The buffer may be unaligned. Returns the end of the loaded values in the
+ *  buffer. */
+template<typename T> void* load_big_endian_array(
+  const void* pointer, T* values, std::size_t count)
+{
+  const unsigned char* source = static_cast<const unsigned char*>(pointer);
+  detail::convert<T>(
+    reinterpret_cast<unsigned char*>(values), source, count, false);
+  return const_cast<unsigned char*>(source + count * sizeof(T));
+}
+
+//! Load values stored in little endian order from a buffer
+/*! The buffer may be unaligned. Returns the end of the loaded values in the
+ *  buffer. */
+template<typename T> void* load_little_endian_array(
+  const void* pointer, T* values, std::size_t count)
+{
+  const unsigned char* source = static_cast<const unsigned char*>(pointer);
+  detail::convert<T>(
+    reinterpret_cast<unsigned char*>(values), source, count, true);
+  return const_cast<unsigned char*>(source + count * sizeof(T));
+}
+
+//! Load a single value stored in big endian order
+template<typename T> T load_big_endian(const void* pointer)
+{
+  T value;
+  load_big_endian_array(pointer, &value, 1);
+  return value;
+}
+
+//! Load a single value stored in little endian order
+template<typename T> T load_little_endian(const void* pointer)
+{
+  T value;
+  load_little_endian_array(pointer, &value, 1);
+  return value;
+}
+
+//! Store a single value in big endian order
+template<typename T> void store_big_endian(void* pointer, const T& value)
+{
+  store_big_endian_array(pointer, &value, 1);
+}
+
+//! Store a single value in little endian order
+template<typename T> void store_little_endian(void* pointer, const T& value)
+{
+  store_little_endian_array(pointer, &value, 1);
+}
+
+} /* namespace endian */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_ENDIAN_H_ */
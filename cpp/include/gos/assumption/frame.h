@@ -0,0 +1,287 @@
+#ifndef _GOS_ASSUMPTION_FRAME_H_
+#define _GOS_ASSUMPTION_FRAME_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <gos/assumption/queue.h>
+#include <gos/assumption/span.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+class FramePool;
+
+//! A reference counted reference to a frame buffer of a pool
+/*! Copying a frame adds a reference to the same buffer, the buffer goes
+ *  back to its pool when the last frame referring to it is destroyed,
+ *  from whatever thread that is. The buffer is written by the thread that
+ *  acquired it before it is shared and only read after. An empty frame
+ *  refers to no buffer.
+ */
+class Frame
+{
+public:
+  //! The size type
+  typedef std::size_t Size;
+
+  Frame() : pool_(nullptr), index_(0) {}
+  Frame(const Frame& other) : pool_(other.pool_), index_(other.index_)
+  {
+    this->retain();
+  }
+  Frame(Frame&& other) : pool_(other.pool_), index_(other.index_)
+  {
+    other.pool_ = nullptr;
+  }
+  ~Frame() { this->release(); }
+  Frame& operator=(const Frame& other)
+  {
+    if (this != &other)
+    {
+      Frame(other).swap(*this);
+    }
+    return *this;
+  }
+  Frame& operator=(Frame&& other)
+  {
+    Frame(std::move(other)).swap(*this);
+    return *this;
+  }
+  void swap(Frame& other)
+  {
+    std::swap(this->pool_, other.pool_);
+    std::swap(this->index_, other.index_);
+  }
+
+  //! Check if the frame refers to no buffer
+  bool empty() const { return this->pool_ == nullptr; }
+  //! Check if the frame refers to a buffer
+  explicit operator bool() const { return this->pool_ != nullptr; }
+
+  //! Access to the bytes, only before the frame is shared
+  inline unsigned char* data();
+  //! Access to the bytes
+  inline const unsigned char* data() const;
+  //! The number of bytes used
+  inline Size size() const;
+  //! Set the number of bytes used, at most the capacity
+  inline void resize(const Size& size);
+  //! The number of bytes of the buffer
+  inline Size capacity() const;
+  //! The sequence number the producer gave the frame
+  inline std::uint64_t sequence() const;
+  //! Set the sequence number, only before the frame is shared
+  inline void sequence(const std::uint64_t& sequence);
+  //! The number of frames referring to the buffer
+  inline Size references() const;
+
+  //! The bytes used as values decoded in place
+  /*! The buffers are aligned for any fundamental type */
+  template<typename T> Span<const T> values() const
+  {
+    return Span<const T>(
+      reinterpret_cast<const T*>(this->data()), this->size() / sizeof(T));
+  }
+  //! The bytes as values to decode in place, only before it is shared
+  template<typename T> Span<T> values(const Size& count)
+  {
+    this->resize(count * sizeof(T));
+    return Span<T>(reinterpret_cast<T*>(this->data()), count);
+  }
+
+private:
+  friend class FramePool;
+
+  Frame(FramePool* pool, const std::uint32_t& index) :
+    pool_(pool), index_(index)
+  {}
+
+  inline void retain();
+  inline void release();
+
+  FramePool* pool_;
+  std::uint32_t index_;
+};
+
+//! A pool of fixed size frame buffers
+/*! The buffers are allocated once in one block. Frames are acquired by one
+ *  thread, the producer decoding into them, and released from any thread
+ *  without waiting. The pool must outlive its frames.
+ */
+class FramePool
+{
+public:
+  //! The size type
+  typedef std::size_t Size;
+
+  //! A Constructor that takes the number of buffers and their size
+  FramePool(const Size& count, const Size& bytes) :
+    count_(count),
+    stride_(sizeof(Header) + (bytes + Align - 1) / Align * Align),
+    bytes_(bytes),
+    memory_(new Block[count * stride_ / Align]),
+    free_(count)
+  {
+    static_assert(sizeof(Header) % Align == 0, "Header breaks alignment");
+    for (Size i = 0; i < count; i++)
+    {
+      new (this->header(static_cast<std::uint32_t>(i))) Header();
+      this->free_.push(static_cast<std::uint32_t>(i));
+    }
+  }
+  ~FramePool()
+  {
+    for (Size i = 0; i < this->count_; i++)
+    {
+      this->header(static_cast<std::uint32_t>(i))->~Header();
+    }
+  }
+  FramePool(const FramePool&) = delete;
+  FramePool& operator=(const FramePool&) = delete;
+
+  //! Acquire a frame, empty if every buffer is in use
+  /*! Only called by one thread at a time */
+  Frame acquire()
+  {
+    std::uint32_t index = 0;
+    if (this->free_.pop([&index](const std::uint32_t& free)
+      {
+        index = free;
+      }, 1) == 0)
+    {
+      return Frame();
+    }
+    Header* header = this->header(index);
+    header->references.store(1, std::memory_order_relaxed);
+    header->size = 0;
+    header->sequence = 0;
+    return Frame(this, index);
+  }
+
+  //! The number of buffers
+  const Size& count() const { return this->count_; }
+  //! The number of bytes of a buffer
+  const Size& bytes() const { return this->bytes_; }
+  //! The number of buffers not in use
+  Size available() const { return this->free_.size(); }
+
+private:
+  friend class Frame;
+
+  static constexpr Size Align = 64;
+
+  struct alignas(64) Block
+  {
+    unsigned char bytes[64];
+  };
+
+  struct alignas(64) Header
+  {
+    Header() : references(0), size(0), sequence(0) {}
+    std::atomic<std::uint32_t> references;
+    std::uint32_t size;
+    std::uint64_t sequence;
+  };
+
+  Header* header(const std::uint32_t& index) const
+  {
+    return reinterpret_cast<Header*>(
+      reinterpret_cast<unsigned char*>(this->memory_.get()) +
+        index * this->stride_);
+  }
+  unsigned char* bytes(const std::uint32_t& index) const
+  {
+    return reinterpret_cast<unsigned char*>(this->header(index)) +
+      sizeof(Header);
+  }
+  void recycle(const std::uint32_t& index)
+  {
+    /* There is always room, the queue holds as many indexes as buffers */
+    const bool pushed = this->free_.push(index);
+    assert(pushed);
+    (void)pushed;
+  }
+
+  Size count_;
+  Size stride_;
+  Size bytes_;
+  std::unique_ptr<Block[]> memory_;
+  MpscQueue<std::uint32_t> free_;
+};
+
+inline unsigned char* Frame::data()
+{
+  assert(this->pool_ != nullptr);
+  return this->pool_->bytes(this->index_);
+}
+inline const unsigned char* Frame::data() const
+{
+  assert(this->pool_ != nullptr);
+  return this->pool_->bytes(this->index_);
+}
+inline Frame::Size Frame::size() const
+{
+  return this->pool_ != nullptr ? this->pool_->header(this->index_)->size : 0;
+}
+inline void Frame::resize(const Size& size)
+{
+  assert(this->pool_ != nullptr && size <= this->pool_->bytes_);
+  this->pool_->header(this->index_)->size = static_cast<std::uint32_t>(size);
+}
+inline Frame::Size Frame::capacity() const
+{
+  return this->pool_ != nullptr ? this->pool_->bytes_ : 0;
+}
+inline std::uint64_t Frame::sequence() const
+{
+  return this->pool_ != nullptr ?
+    this->pool_->header(this->index_)->sequence : 0;
+}
+inline void Frame::sequence(const std::uint64_t& sequence)
+{
+  assert(this->pool_ != nullptr);
+  this->pool_->header(this->index_)->sequence = sequence;
+}
+inline Frame::Size Frame::references() const
+{
+  return this->pool_ != nullptr ?
+    this->pool_->header(this->index_)->references.load(
+      std::memory_order_relaxed) :
+    0;
+}
+inline void Frame::retain()
+{
+  if (this->pool_ != nullptr)
+  {
+    this->pool_->header(this->index_)->references.fetch_add(
+      1, std::memory_order_relaxed);
+  }
+}
+inline void Frame::release()
+{
+  if (this->pool_ == nullptr)
+  {
+    return;
+  }
+  /* The last reader sees every write before the buffer is reused */
+  if (this->pool_->header(this->index_)->references.fetch_sub(
+    1, std::memory_order_acq_rel) == 1)
+  {
+    this->pool_->recycle(this->index_);
+  }
+  this->pool_ = nullptr;
+}
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_FRAME_H_ */
@@ -0,0 +1,353 @@
+#ifndef _GOS_ASSUMPTION_HISTOGRAM_H_
+#define _GOS_ASSUMPTION_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace gos
+{
+namespace assumption
+{
+namespace histogram
+{
+
+//! The bits of the sub buckets of a power of 2, a relative error of 1/32
+inline constexpr unsigned SubBits = 5;
+//! The bits of the largest value recorded, about 18 minutes in nanoseconds
+inline constexpr unsigned RangeBits = 40;
+
+//! The bucket of a value
+/*! The values below 2^SubBits have a bucket each, above the buckets are
+ *  log linear like HDR histograms: 2^SubBits buckets per power of 2. The
+ *  values beyond the range go to the last bucket.
+ */
+inline std::size_t bucket(std::uint64_t value)
+{
+  const std::uint64_t Largest = (std::uint64_t(1) << RangeBits) - 1;
+  value = value < Largest ? value : Largest;
+  if (value < (std::uint64_t(1) << SubBits))
+  {
+    return static_cast<std::size_t>(value);
+  }
+#if defined(__GNUC__)
+  const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+  unsigned msb = 0;
+  for (std::uint64_t rest = value; rest > 1; rest >>= 1)
+  {
+    msb++;
+  }
+#endif
+  const unsigned shift = msb - SubBits;
+  return (static_cast<std::size_t>(shift) << SubBits) +
+    static_cast<std::size_t>(value >> shift);
+}
+
+//! The largest value of a bucket
+inline std::uint64_t upper(const std::size_t& index)
+{
+  if (index < (std::size_t(1) << SubBits))
+  {
+    return index;
+  }
+  const std::size_t shift = (index >> SubBits) - 1;
+  const std::uint64_t mantissa = index - (shift << SubBits);
+  return ((mantissa + 1) << shift) - 1;
+}
+
+//! The number of buckets of a histogram
+inline constexpr std::size_t Buckets =
+  (std::size_t(RangeBits - SubBits) << SubBits) + (std::size_t(1) << SubBits);
+
+//! The counts of a histogram at some time, to query
+class Snapshot
+{
+public:
+  Snapshot() : counts_(Buckets, 0), count_(0), sum_(0), max_(0) {}
+
+  //! The number of values
+  const std::uint64_t& count() const { return this->count_; }
+  //! The largest value
+  const std::uint64_t& max() const { return this->max_; }
+  //! The mean of the values
+  double mean() const
+  {
+    return this->count_ > 0 ?
+      static_cast<double>(this->sum_) / static_cast<double>(this->count_) :
+      0.0;
+  }
+  //! The value a fraction of the values are at most, within 1/32
+  std::uint64_t percentile(const double& fraction) const
+  {
+    if (this->count_ == 0)
+    {
+      return 0;
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(
+      fraction * static_cast<double>(this->count_) + 0.5);
+    rank = rank > 0 ? rank : 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < Buckets; i++)
+    {
+      seen += this->counts_[i];
+      if (seen >= rank)
+      {
+        const std::uint64_t result = upper(i);
+        return result < this->max_ ? result : this->max_;
+      }
+    }
+    return this->max_;
+  }
+  //! The count of a bucket
+  const std::uint64_t& at(const std::size_t& index) const
+  {
+    return this->counts_[index];
+  }
+
+  //! Add the values of another snapshot
+  Snapshot& merge(const Snapshot& other)
+  {
+    for (std::size_t i = 0; i < Buckets; i++)
+    {
+      this->counts_[i] += other.counts_[i];
+    }
+    this->count_ += other.count_;
+    this->sum_ += other.sum_;
+    this->max_ = this->max_ > other.max_ ? this->max_ : other.max_;
+    return *this;
+  }
+
+private:
+  friend class Histogram;
+
+  std::vector<std::uint64_t> counts_;
+  std::uint64_t count_;
+  std::uint64_t sum_;
+  std::uint64_t max_;
+};
+
+//! A histogram of values recorded from many threads
+/*! Recording is lock free, a few relaxed atomic adds. A snapshot taken
+ *  while values are recorded may miss the latest of them.
+ */
+class Histogram
+{
+public:
+  Histogram() : count_(0), sum_(0), max_(0)
+  {
+    for (std::atomic<std::uint64_t>& count : this->counts_)
+    {
+      count.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  //! Record a value
+  void record(const std::uint64_t& value)
+  {
+    this->counts_[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    this->count_.fetch_add(1, std::memory_order_relaxed);
+    this->sum_.fetch_add(value, std::memory_order_relaxed);
+    std::uint64_t max = this->max_.load(std::memory_order_relaxed);
+    while (value > max && !this->max_.compare_exchange_weak(
+      max, value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  //! The counts at this time
+  Snapshot snapshot() const
+  {
+    Snapshot result;
+    for (std::size_t i = 0; i < Buckets; i++)
+    {
+      result.counts_[i] = this->counts_[i].load(std::memory_order_relaxed);
+      result.count_ += result.counts_[i];
+    }
+    result.sum_ = this->sum_.load(std::memory_order_relaxed);
+    result.max_ = this->max_.load(std::memory_order_relaxed);
+    return result;
+  }
+
+private:
+  std::atomic<std::uint64_t> counts_[Buckets];
+  std::atomic<std::uint64_t> count_;
+  std::atomic<std::uint64_t> sum_;
+  std::atomic<std::uint64_t> max_;
+};
+
+//! The latency histograms of the transitions between stages
+/*! The latency of a transition from a stage to another is the time from
+ *  the entry of the first to the entry of the second, the dwell time of a
+ *  stage is the latency of all the transitions from it. The histogram of
+ *  a pair of stages is allocated the first time the pair is recorded and
+ *  published with a compare and swap, so memory is bounded by the pairs
+ *  that happen and recording never locks.
+ */
+class Latencies
+{
+public:
+  //! The size type
+  typedef std::size_t Size;
+
+  //! A Constructor that takes the number of stage codes
+  Latencies(const Size& stages) :
+    stages_(stages),
+    histograms_(std::make_unique<std::atomic<Histogram*>[]>(stages * stages))
+  {
+    for (Size i = 0; i < stages * stages; i++)
+    {
+      this->histograms_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  ~Latencies()
+  {
+    for (Size i = 0; i < this->stages_ * this->stages_; i++)
+    {
+      delete this->histograms_[i].load(std::memory_order_relaxed);
+    }
+  }
+  Latencies(const Latencies&) = delete;
+  Latencies& operator=(const Latencies&) = delete;
+
+  //! The number of stage codes
+  const Size& stages() const { return this->stages_; }
+
+  //! The steady clock time in nanoseconds
+  static std::uint64_t now()
+  {
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  //! Record the latency of a transition in nanoseconds
+  void record(
+    const std::uint16_t& from,
+    const std::uint16_t& to,
+    const std::uint64_t& nanoseconds)
+  {
+    if (from >= this->stages_ || to >= this->stages_)
+    {
+      return;
+    }
+    std::atomic<Histogram*>& slot =
+      this->histograms_[from * this->stages_ + to];
+    Histogram* histogram = slot.load(std::memory_order_acquire);
+    if (histogram == nullptr)
+    {
+      std::unique_ptr<Histogram> created = std::make_unique<Histogram>();
+      if (slot.compare_exchange_strong(histogram, created.get(),
+        std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        histogram = created.release();
+      }
+    }
+    histogram->record(nanoseconds);
+  }
+
+  //! The latencies of the transitions from a stage to another
+  Snapshot latency(const std::uint16_t& from, const std::uint16_t& to) const
+  {
+    const Histogram* histogram = this->find(from, to);
+    return histogram != nullptr ? histogram->snapshot() : Snapshot();
+  }
+  //! The dwell times of a stage
+  Snapshot dwell(const std::uint16_t& stage) const
+  {
+    Snapshot result;
+    for (Size to = 0; to < this->stages_; to++)
+    {
+      const Histogram* histogram =
+        this->find(stage, static_cast<std::uint16_t>(to));
+      if (histogram != nullptr)
+      {
+        result.merge(histogram->snapshot());
+      }
+    }
+    return result;
+  }
+
+  //! Write the transitions and dwell times recorded as text tables
+  /*! The latencies are in nanoseconds, a null name function writes the
+   *  stages as numbers.
+   */
+  void dump(std::ostream& os,
+    const char* (*name)(const std::uint16_t&) = nullptr) const
+  {
+    os << "transition count mean p50 p90 p99 p99.9 max\n";
+    for (Size from = 0; from < this->stages_; from++)
+    {
+      for (Size to = 0; to < this->stages_; to++)
+      {
+        const Histogram* histogram = this->find(
+          static_cast<std::uint16_t>(from), static_cast<std::uint16_t>(to));
+        if (histogram != nullptr)
+        {
+          write(os, name, static_cast<std::uint16_t>(from));
+          os << "->";
+          write(os, name, static_cast<std::uint16_t>(to));
+          summary(os, histogram->snapshot());
+        }
+      }
+    }
+    os << "dwell count mean p50 p90 p99 p99.9 max\n";
+    for (Size stage = 0; stage < this->stages_; stage++)
+    {
+      const Snapshot snapshot = this->dwell(static_cast<std::uint16_t>(stage));
+      if (snapshot.count() > 0)
+      {
+        write(os, name, static_cast<std::uint16_t>(stage));
+        summary(os, snapshot);
+      }
+    }
+  }
+
+private:
+  const Histogram* find(const std::uint16_t& from, const std::uint16_t& to)
+    const
+  {
+    if (from >= this->stages_ || to >= this->stages_)
+    {
+      return nullptr;
+    }
+    return this->histograms_[from * this->stages_ + to].load(
+      std::memory_order_acquire);
+  }
+  static void write(std::ostream& os,
+    const char* (*name)(const std::uint16_t&), const std::uint16_t& stage)
+  {
+    if (name != nullptr)
+    {
+      os << name(stage);
+    }
+    else
+    {
+      os << stage;
+    }
+  }
+  static void summary(std::ostream& os, const Snapshot& snapshot)
+  {
+    os << " " << snapshot.count()
+      << " " << static_cast<std::uint64_t>(snapshot.mean())
+      << " " << snapshot.percentile(0.5)
+      << " " << snapshot.percentile(0.9)
+      << " " << snapshot.percentile(0.99)
+      << " " << snapshot.percentile(0.999)
+      << " " << snapshot.max() << "\n";
+  }
+
+  Size stages_;
+  std::unique_ptr<std::atomic<Histogram*>[]> histograms_;
+};
+
+} /* namespace histogram */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_HISTOGRAM_H_ */
@@ -0,0 +1,882 @@
+#ifndef _GOS_ASSUMPTION_IMAGE_H_
+#define _GOS_ASSUMPTION_IMAGE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define _GOS_ASSUMPTION_IMAGE_MMAP_
+#endif
+
+#include <gos/assumption.h>
+#include <gos/assumption/span.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace image
+{
+
+/* An image is a file of the ids, the value arrays and the wrappers of an
+ * Assumption. It holds offsets from its start and no pointers so it can be
+ * mapped at any address and used in place. The sections follow the header
+ * in this order, each starting on a multiple of 64 bytes:
+ *   entries   an Entry for each id in handle order
+ *   slots     the open addressing hash table of the entries
+ *   values    the values of all the ids, the ids own consecutive slices
+ *   wrappers  the values of the wrappers, in the same slices
+ *   bits      the set flags of the wrappers, a bit for each value
+ *   names     the bytes of the ids
+ * The numbers are in the byte order of the writer, an image is rejected by
+ * a reader with another byte order. A checksum covers the whole file. */
+
+//! The version of the image layout
+inline constexpr std::uint32_t Version = 1;
+
+//! The result of writing or reading an image
+enum class Status
+{
+  //! The image was written or read
+  Ok,
+  //! The file can't be opened or mapped
+  Unreadable,
+  //! The file can't be written
+  Unwritable,
+  //! The file is shorter than the image it holds
+  Truncated,
+  //! The file is not an image
+  Format,
+  //! The image has another version
+  Version,
+  //! The image holds another value type or byte order
+  Layout,
+  //! The image doesn't match its checksum or is inconsistent
+  Corrupt
+};
+
+//! The name of a status
+inline const char* status_name(const Status& status)
+{
+  switch (status)
+  {
+  case Status::Ok:
+    return "Ok";
+  case Status::Unreadable:
+    return "Unreadable";
+  case Status::Unwritable:
+    return "Unwritable";
+  case Status::Truncated:
+    return "Truncated";
+  case Status::Format:
+    return "Format";
+  case Status::Version:
+    return "Version";
+  case Status::Layout:
+    return "Layout";
+  case Status::Corrupt:
+    return "Corrupt";
+  }
+  return "Unknown";
+}
+
+//! The header at the start of an image
+struct Header
+{
+  char magic[8];
+  std::uint32_t version;
+  //! The number 0x01020304 in the byte order of the writer
+  std::uint32_t order;
+  //! The kind of the value type
+  std::uint32_t kind;
+  //! The size of a value
+  std::uint32_t value_bytes;
+  std::uint64_t ids;
+  std::uint64_t values;
+  std::uint64_t slots;
+  std::uint64_t names;
+  std::uint64_t entries_at;
+  std::uint64_t slots_at;
+  std::uint64_t values_at;
+  std::uint64_t wrappers_at;
+  std::uint64_t bits_at;
+  std::uint64_t names_at;
+  //! The size of the whole image
+  std::uint64_t size;
+  //! The checksum of the sections and the header with a zero checksum
+  std::uint64_t checksum;
+  std::uint64_t reserved;
+};
+
+//! The record of an id in an image
+struct Entry
+{
+  //! The hash of the id
+  std::uint64_t hash;
+  //! The offset of the id in the names
+  std::uint64_t name;
+  //! The offset of the slice of the id in the values and the wrappers
+  std::uint64_t offset;
+  //! The length of the id
+  std::uint32_t length;
+  //! The array size of the id
+  std::uint32_t size;
+};
+
+static_assert(sizeof(Header) == 128, "The header is two cache lines");
+static_assert(sizeof(Entry) == 32, "An entry has no padding");
+
+//! The bytes the sections are aligned to
+inline constexpr std::uint64_t Align = 64;
+//! The slot of the hash table that holds no entry
+inline constexpr std::uint32_t NoEntry =
+  std::numeric_limits<std::uint32_t>::max();
+//! The magic bytes at the start of an image
+inline constexpr char Magic[8] = { 'G', 'O', 'S', 'I', 'M', 'A', 'G', 'E' };
+//! The byte order mark
+inline constexpr std::uint32_t Order = 0x01020304;
+
+//! The kind of a value type
+/*! 1 for unsigned integers, 2 for signed integers, 3 for floating point
+ *  numbers and 4 for other trivially copyable types
+ */
+template<typename T> constexpr std::uint32_t kind()
+{
+  return std::is_floating_point<T>::value ? 3 :
+    std::is_integral<T>::value ? (std::is_signed<T>::value ? 2 : 1) : 4;
+}
+
+//! Hash an id the same way in every process, 64 bit FNV-1a
+inline std::uint64_t hash(const std::string_view& id)
+{
+  std::uint64_t result = 0xcbf29ce484222325ull;
+  for (const char& c : id)
+  {
+    result ^= static_cast<unsigned char>(c);
+    result *= 0x100000001b3ull;
+  }
+  return result;
+}
+
+//! A checksum of a stream of bytes
+/*! Four independent lanes of 64 bit multiply rotate rounds over 32 byte
+ *  blocks, so it runs at several bytes a cycle. Not cryptographic, it
+ *  catches truncation and corruption.
+ */
+class Checksum
+{
+public:
+  Checksum() :
+    lanes_{ Seed, Seed ^ Prime1, Seed ^ Prime2, Seed ^ Prime3 },
+    used_(0),
+    bytes_(0)
+  {}
+
+  //! Add bytes to the checksum
+  void update(const void* data, std::size_t size)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    this->bytes_ += size;
+    if (this->used_ > 0)
+    {
+      const std::size_t part = size < Block - this->used_ ?
+        size : Block - this->used_;
+      std::memcpy(this->buffer_ + this->used_, bytes, part);
+      this->used_ += part;
+      bytes += part;
+      size -= part;
+      if (this->used_ < Block)
+      {
+        return;
+      }
+      this->block(this->buffer_);
+      this->used_ = 0;
+    }
+    for (; size >= Block; bytes += Block, size -= Block)
+    {
+      this->block(bytes);
+    }
+    std::memcpy(this->buffer_, bytes, size);
+    this->used_ = size;
+  }
+
+  //! The checksum of the bytes added
+  std::uint64_t value() const
+  {
+    Checksum last(*this);
+    if (last.used_ > 0)
+    {
+      std::memset(last.buffer_ + last.used_, 0, Block - last.used_);
+      last.block(last.buffer_);
+    }
+    std::uint64_t result = last.bytes_ * Prime1;
+    for (const std::uint64_t& lane : last.lanes_)
+    {
+      result = round(result, lane);
+    }
+    result ^= result >> 33;
+    result *= Prime2;
+    result ^= result >> 29;
+    return result;
+  }
+
+private:
+  static constexpr std::size_t Block = 32;
+  static constexpr std::uint64_t Seed = 0x27d4eb2f165667c5ull;
+  static constexpr std::uint64_t Prime1 = 0x9e3779b185ebca87ull;
+  static constexpr std::uint64_t Prime2 = 0xc2b2ae3d27d4eb4full;
+  static constexpr std::uint64_t Prime3 = 0x165667b19e3779f9ull;
+
+  static std::uint64_t round(std::uint64_t lane, const std::uint64_t& word)
+  {
+    lane += word * Prime2;
+    lane = (lane << 31) | (lane >> 33);
+    return lane * Prime1;
+  }
+  void block(const unsigned char* bytes)
+  {
+    for (std::size_t i = 0; i < 4; i++)
+    {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + 8 * i, sizeof(word));
+      this->lanes_[i] = round(this->lanes_[i], word);
+    }
+  }
+
+  std::uint64_t lanes_[4];
+  unsigned char buffer_[Block];
+  std::size_t used_;
+  std::uint64_t bytes_;
+};
+
+namespace detail
+{
+
+inline std::uint64_t aligned(const std::uint64_t& offset)
+{
+  return (offset + Align - 1) / Align * Align;
+}
+
+//! Lay the sections out for the counts of a header
+/*! The counts must be bounded so the offsets don't overflow */
+inline void layout(Header& header)
+{
+  header.entries_at = sizeof(Header);
+  header.slots_at =
+    aligned(header.entries_at + header.ids * sizeof(Entry));
+  header.values_at =
+    aligned(header.slots_at + header.slots * sizeof(std::uint32_t));
+  header.wrappers_at =
+    aligned(header.values_at + header.values * header.value_bytes);
+  header.bits_at =
+    aligned(header.wrappers_at + header.values * header.value_bytes);
+  header.names_at =
+    aligned(header.bits_at + (header.values + 63) / 64 * sizeof(std::uint64_t));
+  header.size = header.names_at + header.names;
+}
+
+//! The number of slots of the hash table of a number of ids
+inline std::uint64_t slots(const std::uint64_t& ids)
+{
+  /* Keep the load factor at or below one half for short probes */
+  std::uint64_t result = 2;
+  while (result < 2 * ids)
+  {
+    result *= 2;
+  }
+  return result;
+}
+
+//! Writes the sections of an image and adds them to the checksum
+class Writer
+{
+public:
+  Writer(std::FILE* file, const std::uint64_t& position) :
+    file_(file), position_(position), good_(true)
+  {}
+
+  void write(const void* data, const std::size_t& size)
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    this->checksum_.update(data, size);
+    this->good_ =
+      this->good_ && std::fwrite(data, 1, size, this->file_) == size;
+    this->position_ += size;
+  }
+  //! Write zeros up to an offset
+  void pad(const std::uint64_t& offset)
+  {
+    static const unsigned char Zeros[Align] = {};
+    assert(offset >= this->position_ && offset - this->position_ <= Align);
+    this->write(Zeros, static_cast<std::size_t>(offset - this->position_));
+  }
+
+  const Checksum& checksum() const { return this->checksum_; }
+  const std::uint64_t& position() const { return this->position_; }
+  bool good() const { return this->good_; }
+
+private:
+  std::FILE* file_;
+  std::uint64_t position_;
+  bool good_;
+  Checksum checksum_;
+};
+
+} /* namespace detail */
+
+//! Write the ids, the values and the wrappers of an Assumption to a file
+/*! The image is written next to the file and renamed over it once it is
+ *  complete, so a reader never sees a partial image. The holders are not
+ *  written, they are created again when the image is loaded.
+ */
+template<typename T, typename W, typename H>
+Status save(const Assumption<T, W, H>& assumption, const std::string& path)
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+    "An image holds the bytes of the values");
+  static_assert(alignof(T) <= Align, "The sections are aligned to 64 bytes");
+  typedef typename Assumption<T, W, H>::Size Size;
+
+  struct Items
+  {
+    const T* values;
+    const W* wrappers;
+  };
+
+  Header header = {};
+  std::memcpy(header.magic, Magic, sizeof(Magic));
+  header.version = Version;
+  header.order = Order;
+  header.kind = kind<T>();
+  header.value_bytes = sizeof(T);
+
+  std::vector<Entry> entries;
+  std::vector<Items> items;
+  entries.reserve(assumption.size());
+  items.reserve(assumption.size());
+  assumption.for_each([&](const std::string& id,
+    const T* values, const W* wrappers, const Size& size)
+  {
+    entries.push_back(Entry{ hash(id), header.names, header.values,
+      static_cast<std::uint32_t>(id.size()), size });
+    items.push_back(Items{ values, wrappers });
+    header.names += id.size();
+    header.values += size;
+  });
+  header.ids = entries.size();
+  header.slots = detail::slots(header.ids);
+  detail::layout(header);
+
+  std::vector<std::uint32_t> slots(header.slots, NoEntry);
+  const std::uint64_t mask = header.slots - 1;
+  for (std::uint32_t i = 0; i < entries.size(); i++)
+  {
+    std::uint64_t slot = entries[i].hash & mask;
+    while (slots[slot] != NoEntry)
+    {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = i;
+  }
+
+  const std::string temporary = path + ".tmp";
+  std::FILE* file = std::fopen(temporary.c_str(), "wb");
+  if (file == nullptr)
+  {
+    return Status::Unwritable;
+  }
+  /* The header is written last once the checksum is known */
+  const Header empty = {};
+  bool good = std::fwrite(&empty, sizeof(empty), 1, file) == 1;
+  detail::Writer writer(file, sizeof(Header));
+  writer.write(entries.data(), entries.size() * sizeof(Entry));
+  writer.pad(header.slots_at);
+  writer.write(slots.data(), slots.size() * sizeof(std::uint32_t));
+  writer.pad(header.values_at);
+  for (std::size_t i = 0; i < entries.size(); i++)
+  {
+    writer.write(items[i].values, entries[i].size * sizeof(T));
+  }
+  writer.pad(header.wrappers_at);
+  /* The wrappers and their flags are gathered in chunks */
+  const std::size_t Chunk = 4096;
+  std::vector<T> chunk;
+  chunk.reserve(Chunk);
+  for (std::size_t i = 0; i < entries.size(); i++)
+  {
+    for (std::uint32_t j = 0; j < entries[i].size; j++)
+    {
+      chunk.push_back(items[i].wrappers[j].value());
+      if (chunk.size() == Chunk)
+      {
+        writer.write(chunk.data(), chunk.size() * sizeof(T));
+        chunk.clear();
+      }
+    }
+  }
+  writer.write(chunk.data(), chunk.size() * sizeof(T));
+  writer.pad(header.bits_at);
+  std::vector<std::uint64_t> words;
+  words.reserve(Chunk / 64);
+  std::uint64_t word = 0;
+  std::uint64_t position = 0;
+  for (std::size_t i = 0; i < entries.size(); i++)
+  {
+    for (std::uint32_t j = 0; j < entries[i].size; j++, position++)
+    {
+      if (items[i].wrappers[j].is_set())
+      {
+        word |= std::uint64_t(1) << (position % 64);
+      }
+      if (position % 64 == 63)
+      {
+        words.push_back(word);
+        word = 0;
+      }
+      if (words.size() == Chunk / 64)
+      {
+        writer.write(words.data(), words.size() * sizeof(std::uint64_t));
+        words.clear();
+      }
+    }
+  }
+  if (position % 64 != 0)
+  {
+    words.push_back(word);
+  }
+  writer.write(words.data(), words.size() * sizeof(std::uint64_t));
+  writer.pad(header.names_at);
+  assumption.for_each([&writer](const std::string& id,
+    const T*, const W*, const Size&)
+  {
+    writer.write(id.data(), id.size());
+  });
+  good = good && writer.good() && writer.position() == header.size;
+
+  Checksum checksum = writer.checksum();
+  checksum.update(&header, sizeof(header));
+  header.checksum = checksum.value();
+  good = good && std::fseek(file, 0, SEEK_SET) == 0 &&
+    std::fwrite(&header, sizeof(header), 1, file) == 1;
+  good = std::fclose(file) == 0 && good;
+  std::error_code error;
+  if (good)
+  {
+    std::filesystem::rename(temporary, path, error);
+  }
+  if (!good || error)
+  {
+    std::filesystem::remove(temporary, error);
+    return Status::Unwritable;
+  }
+  return Status::Ok;
+}
+
+//! A read only image mapped in memory
+/*! The values, the wrappers and the ids are used in place from the mapping
+ *  without copying them, a lookup hashes the id and probes the hash table
+ *  of the image. The whole image is checked when it is opened. Where
+ *  mapping is not available the file is read into memory instead.
+ */
+template<typename T> class Image
+{
+public:
+  //! The id view type
+  typedef std::string_view Key;
+  //! The index type
+  typedef unsigned int Index;
+  //! The size type
+  typedef Index Size;
+  //! The handle type, the index of an id in the image
+  typedef ::gos::interfaces::Handle Handle;
+  //! The type of a word in the set flag bitmap
+  typedef std::uint64_t Word;
+  //! The wrapper type equivalent to a value and its set flag
+  typedef gos::assumption::Wrapper<T> WrapperType;
+
+  //! The handle returned when resolving an id that is not contained
+  static const Handle NoHandle = ::gos::interfaces::NoHandle;
+
+  Image() : data_(nullptr), length_(0), mapped_(false), header_(nullptr) {}
+  ~Image() { this->close(); }
+  Image(const Image&) = delete;
+  Image& operator=(const Image&) = delete;
+
+  //! Map an image file and check it
+  /*! An image that is not Ok is closed */
+  Status open(const std::string& path)
+  {
+    this->close();
+    Status result = this->map(path);
+    if (result == Status::Ok)
+    {
+      result = this->check();
+    }
+    if (result != Status::Ok)
+    {
+      this->close();
+    }
+    return result;
+  }
+  //! Unmap the image
+  /*! The spans and the ids taken from the image are invalid afterwards */
+  void close()
+  {
+#if defined(_GOS_ASSUMPTION_IMAGE_MMAP_)
+    if (this->mapped_)
+    {
+      ::munmap(const_cast<unsigned char*>(this->data_), this->length_);
+    }
+#endif
+    this->buffer_.reset();
+    this->data_ = nullptr;
+    this->length_ = 0;
+    this->mapped_ = false;
+    this->header_ = nullptr;
+  }
+  //! Check if an image is open
+  bool is_open() const { return this->header_ != nullptr; }
+
+  //! The number of ids
+  std::size_t size() const
+  {
+    return this->header_ != nullptr ?
+      static_cast<std::size_t>(this->header_->ids) : 0;
+  }
+  //! The number of values of all the ids
+  std::size_t count() const
+  {
+    return this->header_ != nullptr ?
+      static_cast<std::size_t>(this->header_->values) : 0;
+  }
+
+  //! Resolve an id into a handle or NoHandle if it is not contained
+  Handle resolve(const Key& id) const
+  {
+    if (this->header_ == nullptr)
+    {
+      return NoHandle;
+    }
+    const std::uint64_t h = hash(id);
+    const std::uint64_t mask = this->header_->slots - 1;
+    const std::uint32_t* slots = this->section<std::uint32_t>(
+      this->header_->slots_at);
+    for (std::uint64_t i = h & mask;; i = (i + 1) & mask)
+    {
+      const std::uint32_t index = slots[i];
+      if (index == NoEntry)
+      {
+        return NoHandle;
+      }
+      const Handle handle = static_cast<Handle>(index);
+      if (this->entry(handle).hash == h && this->id(handle) == id)
+      {
+        return handle;
+      }
+    }
+  }
+  //! Check if the id is contained in the image
+  bool has(const Key& id) const { return this->resolve(id) != NoHandle; }
+  //! The id of a handle
+  Key id(const Handle& handle) const
+  {
+    const Entry& entry = this->entry(handle);
+    return Key(reinterpret_cast<const char*>(this->data_) +
+      this->header_->names_at + entry.name, entry.length);
+  }
+
+  //! The values of an id
+  Span<const T> values(const Handle& handle) const
+  {
+    const Entry& entry = this->entry(handle);
+    return Span<const T>(
+      this->section<T>(this->header_->values_at) + entry.offset, entry.size);
+  }
+  //! The values of an id or an empty span if it is not contained
+  Span<const T> values(const Key& id) const
+  {
+    const Handle handle = this->resolve(id);
+    return handle != NoHandle ? this->values(handle) : Span<const T>();
+  }
+  //! The values of the wrappers of an id, zero when not set
+  Span<const T> wrapper_values(const Handle& handle) const
+  {
+    const Entry& entry = this->entry(handle);
+    return Span<const T>(
+      this->section<T>(this->header_->wrappers_at) + entry.offset, entry.size);
+  }
+  //! Check if a wrapper of an id was set
+  bool is_set(const Handle& handle, const Index& index) const
+  {
+    const Entry& entry = this->entry(handle);
+    assert(index < entry.size);
+    const std::uint64_t position = entry.offset + index;
+    return (this->section<Word>(this->header_->bits_at)[position / 64] >>
+      (position % 64)) & 1;
+  }
+  //! A wrapper equivalent to a wrapper of an id
+  WrapperType wrapper(const Handle& handle, const Index& index) const
+  {
+    return this->is_set(handle, index) ?
+      WrapperType(this->wrapper_values(handle)[index]) : WrapperType();
+  }
+  //! The offset of the slice of an id in the values and the wrappers
+  std::size_t offset(const Handle& handle) const
+  {
+    return static_cast<std::size_t>(this->entry(handle).offset);
+  }
+  //! The set flag bitmap of the wrappers of all the ids
+  /*! The flag of the wrapper at position p is the bit p modulo 64 of the
+   *  word p divided by 64.
+   */
+  Span<const Word> bitmap() const
+  {
+    return this->header_ != nullptr ?
+      Span<const Word>(this->section<Word>(this->header_->bits_at),
+        static_cast<std::size_t>((this->header_->values + 63) / 64)) :
+      Span<const Word>();
+  }
+
+private:
+  /* The fallback buffer is aligned like a mapping */
+  struct alignas(64) Block
+  {
+    unsigned char bytes[64];
+  };
+
+  template<typename U> const U* section(const std::uint64_t& offset) const
+  {
+    return reinterpret_cast<const U*>(this->data_ + offset);
+  }
+  const Entry& entry(const Handle& handle) const
+  {
+    const std::size_t index = static_cast<std::size_t>(handle);
+    assert(this->header_ != nullptr && index < this->header_->ids);
+    return this->section<Entry>(this->header_->entries_at)[index];
+  }
+
+  Status map(const std::string& path)
+  {
+#if defined(_GOS_ASSUMPTION_IMAGE_MMAP_)
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+      return Status::Unreadable;
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0)
+    {
+      ::close(descriptor);
+      return Status::Unreadable;
+    }
+    this->length_ = static_cast<std::size_t>(status.st_size);
+    if (this->length_ < sizeof(Header))
+    {
+      ::close(descriptor);
+      return Status::Truncated;
+    }
+    void* data = ::mmap(nullptr, this->length_, PROT_READ, MAP_PRIVATE,
+      descriptor, 0);
+    /* The mapping keeps the file open */
+    ::close(descriptor);
+    if (data == MAP_FAILED)
+    {
+      return Status::Unreadable;
+    }
+    this->data_ = static_cast<const unsigned char*>(data);
+    this->mapped_ = true;
+    return Status::Ok;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+      return Status::Unreadable;
+    }
+    this->length_ = static_cast<std::size_t>(file.tellg());
+    if (this->length_ < sizeof(Header))
+    {
+      return Status::Truncated;
+    }
+    this->buffer_.reset(new Block[(this->length_ + 63) / 64]);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(this->buffer_.get()),
+      static_cast<std::streamsize>(this->length_)))
+    {
+      return Status::Unreadable;
+    }
+    this->data_ = reinterpret_cast<const unsigned char*>(this->buffer_.get());
+    return Status::Ok;
+#endif
+  }
+
+  Status check()
+  {
+    Header header;
+    std::memcpy(&header, this->data_, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+    {
+      return Status::Format;
+    }
+    if (header.version != Version)
+    {
+      return Status::Version;
+    }
+    if (header.order != Order || header.kind != kind<T>() ||
+      header.value_bytes != sizeof(T))
+    {
+      return Status::Layout;
+    }
+    /* Bound the counts by the file before laying the sections out so the
+     * offsets can't overflow */
+    const std::uint64_t length = this->length_;
+    if (header.ids > length / sizeof(Entry) ||
+      header.slots > length / sizeof(std::uint32_t) ||
+      header.values > length / sizeof(T) || header.names > length)
+    {
+      return header.size > length ? Status::Truncated : Status::Corrupt;
+    }
+    Header expected = header;
+    detail::layout(expected);
+    if (std::memcmp(&expected, &header, sizeof(header)) != 0 ||
+      header.slots != detail::slots(header.ids))
+    {
+      return Status::Corrupt;
+    }
+    if (header.size > length)
+    {
+      return Status::Truncated;
+    }
+    if (header.size < length)
+    {
+      return Status::Corrupt;
+    }
+
+    Checksum checksum;
+    checksum.update(this->data_ + sizeof(Header), length - sizeof(Header));
+    header.checksum = 0;
+    checksum.update(&header, sizeof(header));
+    if (checksum.value() != expected.checksum)
+    {
+      return Status::Corrupt;
+    }
+
+    /* The checksum doesn't prove the writer was right, the entries are
+     * checked so a lookup never reads outside of the image */
+    this->header_ = reinterpret_cast<const Header*>(this->data_);
+    const std::uint32_t* slots = this->section<std::uint32_t>(header.slots_at);
+    std::uint64_t used = 0;
+    for (std::uint64_t i = 0; i < header.slots; i++)
+    {
+      if (slots[i] != NoEntry && slots[i] >= header.ids)
+      {
+        return Status::Corrupt;
+      }
+      used += slots[i] != NoEntry;
+    }
+    if (used != header.ids)
+    {
+      return Status::Corrupt;
+    }
+    const Entry* entries = this->section<Entry>(header.entries_at);
+    for (std::uint64_t i = 0; i < header.ids; i++)
+    {
+      const Entry& entry = entries[i];
+      if (entry.name > header.names ||
+        entry.length > header.names - entry.name ||
+        entry.offset > header.values ||
+        entry.size > header.values - entry.offset ||
+        entry.hash != hash(this->id(static_cast<Handle>(i))))
+      {
+        return Status::Corrupt;
+      }
+    }
+    return Status::Ok;
+  }
+
+  const unsigned char* data_;
+  std::size_t length_;
+  bool mapped_;
+  std::unique_ptr<Block[]> buffer_;
+  const Header* header_;
+};
+
+template<typename T>
+const typename Image<T>::Handle Image<T>::NoHandle;
+
+//! Create the ids of an image in an Assumption and copy their items
+/*! The ids are created in bulk with one block for the values and one for
+ *  the wrappers, the values are copied with one copy for each id. The ids
+ *  of the image replace the same ids of the object, the other ids are
+ *  kept. The holders are created like the ones of created ids.
+ */
+template<typename T, typename W, typename H>
+Status load(const Image<T>& image, Assumption<T, W, H>& assumption)
+{
+  typedef Assumption<T, W, H> Target;
+  typedef typename Image<T>::Handle Handle;
+  if (!image.is_open())
+  {
+    return Status::Unreadable;
+  }
+  typename Target::Batch batch;
+  batch.reserve(image.size());
+  for (std::size_t i = 0; i < image.size(); i++)
+  {
+    const Handle source = static_cast<Handle>(i);
+    batch.emplace_back(typename Target::Id(image.id(source)),
+      static_cast<typename Target::Size>(image.values(source).size()));
+  }
+  assumption.create_many(batch);
+  const Span<const std::uint64_t> bits = image.bitmap();
+  for (std::size_t i = 0; i < image.size(); i++)
+  {
+    const Handle source = static_cast<Handle>(i);
+    const Span<const T> values = image.values(source);
+    if (values.empty())
+    {
+      continue;
+    }
+    const typename Target::Handle handle = assumption.resolve(image.id(source));
+    std::memcpy(&assumption.value(handle, 0), values.data(),
+      values.size() * sizeof(T));
+    /* The wrappers are created unset, only the set ones are assigned */
+    const Span<const T> wrappers = image.wrapper_values(source);
+    W* target = &assumption.wrapper(handle, 0);
+    const std::size_t offset = image.offset(source);
+    for (std::size_t j = 0; j < wrappers.size(); j++)
+    {
+      const std::size_t position = offset + j;
+      if ((bits[position / 64] >> (position % 64)) & 1)
+      {
+        target[j] = W(wrappers[j]);
+      }
+    }
+  }
+  return Status::Ok;
+}
+
+} /* namespace image */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_IMAGE_H_ */
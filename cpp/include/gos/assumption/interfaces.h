@@ -1,8 +1,12 @@
 #ifndef _GOS_ASSUMPTION_INTERFACES_H_
 #define _GOS_ASSUMPTION_INTERFACES_H_
 
+#include <limits>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace gos
 {
@@ -107,14 +111,27 @@ public:
   virtual const T* pointer() const = 0;
 };
 
+//! The handle of a resolved id
+/*! A small integer token, a type of its own so an index passed where a
+ *  handle belongs does not compile
+ */
+enum class Handle : unsigned int {};
+//! The handle of an id that is not contained
+inline constexpr Handle NoHandle = static_cast<Handle>(
+  std::numeric_limits<std::underlying_type<Handle>::type>::max());
+
 //! The Assumption interface
 template<typename T, typename W, typename H> class Assumption
 {
 public:
   //! The id type
   typedef std::string Id;
+  //! The id view type for lookups without building a temporary id
+  typedef std::string_view Key;
   //! The index type
   typedef unsigned int Index;
+  //! The handle type, a small integer token for a resolved id
+  typedef ::gos::interfaces::Handle Handle;
   //! The array type
   typedef std::unique_ptr<T[]> Array;
   //! The array wrapper type
@@ -124,14 +141,157 @@ public:
   virtual ~Assumption() {}
   //! A method that should create the unique items for the unique assumption
   virtual void unique(Array& a, WrapperArray& wrapper, HolderPtr& holder) = 0;
+  //! A method that should create the items for an id with an array size
+  virtual void create(const Key& id, const Index& size) = 0;
   //! Should check if the id is contained in the object
-  virtual bool has(const Id& id) = 0;
+  /*! The internal state of the object stays unchanged by constant guard */
+  virtual bool has(const Key& id) const = 0;
   //! Should return a reference to a value from an array by id and index
-  virtual T& value(const Id& id, const Index& index) = 0;
+  virtual T& value(const Key& id, const Index& index) = 0;
   //! Should return a reference to a wrapper from an array by id and index
-  virtual W& wrapper(const Id& id, const Index& index) = 0;
+  virtual W& wrapper(const Key& id, const Index& index) = 0;
   //! Should return a reference to a holder by id
-  virtual H& holder(const Id& id) = 0;
+  virtual H& holder(const Key& id) = 0;
+  //! Should resolve an id into a handle that stays valid while it is contained
+  virtual Handle resolve(const Key& id) const = 0;
+  //! Should return a reference to a value from an array by handle and index
+  virtual T& value(const Handle& handle, const Index& index) = 0;
+  //! Should return a reference to a wrapper from an array by handle and index
+  virtual W& wrapper(const Handle& handle, const Index& index) = 0;
+  //! Should return a reference to a holder by handle
+  virtual H& holder(const Handle& handle) = 0;
+};
+
+/* The static interfaces of the fast mode. A concrete class derives from the
+ * static interface with itself as the first template argument and the
+ * interface checks the members of the class at compile time instead of
+ * declaring them virtual, so the class needs no virtual table. */
+
+//! Checks if a type has the members of the wrapper interface
+template<typename W, typename T, typename = void>
+struct IsWrapper : std::false_type {};
+template<typename W, typename T>
+struct IsWrapper<W, T, std::void_t<
+  decltype(std::declval<const W&>().value()),
+  decltype(std::declval<const W&>().is_set())>> :
+  std::integral_constant<bool,
+    std::is_convertible<
+      decltype(std::declval<const W&>().value()), const T&>::value &&
+    std::is_convertible<
+      decltype(std::declval<const W&>().is_set()), bool>::value>
+{};
+
+//! Checks if a type has the members of the three value holder interfaces
+template<typename H, typename T, typename = void>
+struct IsHolder : std::false_type {};
+template<typename H, typename T>
+struct IsHolder<H, T, std::void_t<
+  decltype(std::declval<H&>().value()),
+  decltype(std::declval<H&>().reference()),
+  decltype(std::declval<H&>().pointer())>> :
+  std::integral_constant<bool,
+    std::is_convertible<decltype(std::declval<H&>().value()), T>::value &&
+    std::is_same<decltype(std::declval<H&>().reference()), T&>::value &&
+    std::is_same<decltype(std::declval<H&>().pointer()), T*>::value>
+{};
+
+//! Checks if a type has the members of the array holder interface
+template<typename H, typename T, typename = void>
+struct IsArrayHolder : std::false_type {};
+template<typename H, typename T>
+struct IsArrayHolder<H, T, std::void_t<
+  decltype(std::declval<H&>().get(0u)),
+  decltype(std::declval<H&>().pointer(0u)),
+  decltype(std::declval<const H&>().size())>> :
+  std::integral_constant<bool,
+    std::is_same<decltype(std::declval<H&>().get(0u)), T&>::value &&
+    std::is_same<decltype(std::declval<H&>().pointer(0u)), T*>::value>
+{};
+
+//! Checks if a type has the lookup members of the Assumption interface
+template<typename A, typename T, typename W, typename H, typename = void>
+struct IsAssumption : std::false_type {};
+template<typename A, typename T, typename W, typename H>
+struct IsAssumption<A, T, W, H, std::void_t<
+  decltype(std::declval<const A&>().has(std::string_view())),
+  decltype(std::declval<const A&>().resolve(std::string_view())),
+  decltype(std::declval<A&>().value(std::string_view(), 0u)),
+  decltype(std::declval<A&>().wrapper(std::string_view(), 0u)),
+  decltype(std::declval<A&>().holder(std::string_view()))>> :
+  std::integral_constant<bool,
+    std::is_same<decltype(std::declval<A&>().value(
+      std::string_view(), 0u)), T&>::value &&
+    std::is_same<decltype(std::declval<A&>().wrapper(
+      std::string_view(), 0u)), W&>::value &&
+    std::is_same<decltype(std::declval<A&>().holder(
+      std::string_view())), H&>::value &&
+    std::is_same<decltype(std::declval<const A&>().resolve(
+      std::string_view())), Handle>::value>
+{};
+
+//! The static wrapper interface
+template<typename D, typename T> class StaticWrapper
+{
+protected:
+  ~StaticWrapper()
+  {
+    static_assert(IsWrapper<D, T>::value,
+      "The class does not implement the wrapper interface");
+  }
+};
+
+//! The static interface of the copyable, referencable and pointered holders
+template<typename D, typename T> class StaticHolder
+{
+protected:
+  ~StaticHolder()
+  {
+    static_assert(IsHolder<D, T>::value,
+      "The class does not implement the holder interfaces");
+  }
+};
+
+//! The static array holding interface
+template<typename D, typename T> class StaticArrayHolder
+{
+public:
+  //! The index type
+  typedef typename ArrayHolder<T>::Index Index;
+  //! The size type
+  typedef typename ArrayHolder<T>::Size Size;
+protected:
+  ~StaticArrayHolder()
+  {
+    static_assert(IsArrayHolder<D, T>::value,
+      "The class does not implement the array holder interface");
+  }
+};
+
+//! The static Assumption interface
+/*! The types are the types of the Assumption interface */
+template<typename D, typename T, typename W, typename H> class StaticAssumption
+{
+public:
+  //! The id type
+  typedef typename Assumption<T, W, H>::Id Id;
+  //! The id view type
+  typedef typename Assumption<T, W, H>::Key Key;
+  //! The index type
+  typedef typename Assumption<T, W, H>::Index Index;
+  //! The handle type
+  typedef typename Assumption<T, W, H>::Handle Handle;
+  //! The array type
+  typedef typename Assumption<T, W, H>::Array Array;
+  //! The array wrapper type
+  typedef typename Assumption<T, W, H>::WrapperArray WrapperArray;
+  //! A type for unique pointer to a holder
+  typedef typename Assumption<T, W, H>::HolderPtr HolderPtr;
+protected:
+  ~StaticAssumption()
+  {
+    static_assert(IsAssumption<D, T, W, H>::value,
+      "The class does not implement the Assumption interface");
+  }
 };
 
 } /* namespace interfaces */
@@ -0,0 +1,589 @@
+#ifndef _GOS_ASSUMPTION_MACHINE_H_
+#define _GOS_ASSUMPTION_MACHINE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+
+#include <gos/assumption/frame.h>
+
+#ifdef _GOS_ASSUMPTION_COUT_
+#include <iostream>
+#endif
+
+#ifdef _GOS_ASSUMPTION_TRACE_
+#include <gos/assumption/trace.h>
+#endif
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+#include <gos/assumption/histogram.h>
+#endif
+
+namespace gos
+{
+namespace assumption
+{
+namespace state_machine
+{
+
+//! The stages of the state engines, dense from 0
+enum class Stage : std::uint8_t
+{
+  Undefined,
+  Starting,
+  NoData,
+  NoNovosData,
+  NoItgData,
+  HoistConstrainstActivityUnavailable,
+  ActivitiesAvailable,
+  RequestingControl,
+  RelinquishingControl,
+  InControl,
+  Exiting,
+  Out
+};
+
+namespace events
+{
+//! Where an event was made and the stage it was made in
+struct Fundament
+{
+  Fundament(const char* file, const int& line, const Stage& stage) :
+    File(file), Line(line), State(stage)
+  {}
+  const char* File;
+  int Line;
+  Stage State;
+};
+struct Started : Fundament
+{
+  Started(const char* file, const int& line, const Stage& stage) :
+    Fundament(file, line, stage) { }
+};
+//! The NOVOS data is available, with the frame it was decoded to if any
+/*! The frame is shared by every engine the event is processed by and goes
+ *  back to its pool once the last copy of the event is destroyed.
+ */
+struct NovosDataAvailable
+{
+  NovosDataAvailable() {}
+  explicit NovosDataAvailable(const Frame& data) : Data(data) {}
+  Frame Data;
+};
+struct NovosDataUnavailable {};
+//! The ITG data is available, with the frame it was decoded to if any
+struct ItgDataAvailable
+{
+  ItgDataAvailable() {}
+  explicit ItgDataAvailable(const Frame& data) : Data(data) {}
+  Frame Data;
+};
+struct ItgDataUnavailable {};
+struct HoistConstrainstActivityBecomesAvailable {};
+struct HoistConstrainstActivityBecomesUnavailable {};
+struct ControlRequested {};
+struct ControlRelinquished {};
+struct ControlLost {};
+struct Granted {};
+struct Timeout {};
+struct Quit {};
+struct Exited {};
+
+//! The dense ids of the events, 0 is an event unknown to the engine
+enum class EventId : std::uint16_t
+{
+  Unknown,
+  Started,
+  NovosDataAvailable,
+  NovosDataUnavailable,
+  ItgDataAvailable,
+  ItgDataUnavailable,
+  HoistConstrainstActivityBecomesAvailable,
+  HoistConstrainstActivityBecomesUnavailable,
+  ControlRequested,
+  ControlRelinquished,
+  ControlLost,
+  Granted,
+  Timeout,
+  Quit,
+  Exited
+};
+
+//! The id of an event type
+template<typename E> struct Id
+{
+  static constexpr EventId value = EventId::Unknown;
+};
+#define _GOS_ASSUMPTION_EVENT_ID_(E) \
+  template<> struct Id<E> { static constexpr EventId value = EventId::E; };
+_GOS_ASSUMPTION_EVENT_ID_(Started)
+_GOS_ASSUMPTION_EVENT_ID_(NovosDataAvailable)
+_GOS_ASSUMPTION_EVENT_ID_(NovosDataUnavailable)
+_GOS_ASSUMPTION_EVENT_ID_(ItgDataAvailable)
+_GOS_ASSUMPTION_EVENT_ID_(ItgDataUnavailable)
+_GOS_ASSUMPTION_EVENT_ID_(HoistConstrainstActivityBecomesAvailable)
+_GOS_ASSUMPTION_EVENT_ID_(HoistConstrainstActivityBecomesUnavailable)
+_GOS_ASSUMPTION_EVENT_ID_(ControlRequested)
+_GOS_ASSUMPTION_EVENT_ID_(ControlRelinquished)
+_GOS_ASSUMPTION_EVENT_ID_(ControlLost)
+_GOS_ASSUMPTION_EVENT_ID_(Granted)
+_GOS_ASSUMPTION_EVENT_ID_(Timeout)
+_GOS_ASSUMPTION_EVENT_ID_(Quit)
+_GOS_ASSUMPTION_EVENT_ID_(Exited)
+#undef _GOS_ASSUMPTION_EVENT_ID_
+} // namespace events
+
+//! The name of a stage code
+inline const char* stage_name(const std::uint16_t& stage)
+{
+  static const char* Names[] = {
+    "Undefined",
+    "Starting",
+    "NoData",
+    "NoNovosData",
+    "NoItgData",
+    "HoistConstrainstActivityUnavailable",
+    "ActivitiesAvailable",
+    "RequestingControl",
+    "RelinquishingControl",
+    "InControl",
+    "Exiting",
+    "Out"
+  };
+  return stage < sizeof(Names) / sizeof(Names[0]) ? Names[stage] : "?";
+}
+
+//! The name of an event code
+inline const char* event_name(const std::uint16_t& event)
+{
+  static const char* Names[] = {
+    "Unknown",
+    "Started",
+    "NovosDataAvailable",
+    "NovosDataUnavailable",
+    "ItgDataAvailable",
+    "ItgDataUnavailable",
+    "HoistConstrainstActivityBecomesAvailable",
+    "HoistConstrainstActivityBecomesUnavailable",
+    "ControlRequested",
+    "ControlRelinquished",
+    "ControlLost",
+    "Granted",
+    "Timeout",
+    "Quit",
+    "Exited"
+  };
+  return event < sizeof(Names) / sizeof(Names[0]) ? Names[event] : "?";
+}
+
+//! The stage of an engine and its number of transitions for other threads
+/*! Only the thread of the engine publishes, so publishing is a plain
+ *  atomic store and reading from any thread is one wait free load that
+ *  sees the stage and the count of the same transition.
+ */
+class Published
+{
+public:
+  Published() : word_(0) {}
+  Published(const Published& other) :
+    word_(other.word_.load(std::memory_order_acquire))
+  {}
+  Published& operator=(const Published& other)
+  {
+    this->word_.store(other.word_.load(std::memory_order_acquire),
+      std::memory_order_release);
+    return *this;
+  }
+
+  //! Publish the stage entered, counted unless it is the first
+  void publish(const Stage& stage, const bool& transition)
+  {
+    const std::uint64_t count =
+      (this->word_.load(std::memory_order_relaxed) >> 8) +
+      (transition ? 1 : 0);
+    this->word_.store((count << 8) | static_cast<std::uint64_t>(stage),
+      std::memory_order_release);
+  }
+  //! The stage last entered
+  Stage stage() const
+  {
+    return static_cast<Stage>(
+      this->word_.load(std::memory_order_acquire) & 0xff);
+  }
+  //! The number of transitions made
+  std::uint64_t transitions() const
+  {
+    return this->word_.load(std::memory_order_acquire) >> 8;
+  }
+
+private:
+  std::atomic<std::uint64_t> word_;
+};
+
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+//! The latencies of the transitions of the state engines
+inline histogram::Latencies& latencies()
+{
+  static histogram::Latencies result(static_cast<std::size_t>(Stage::Out) + 1);
+  return result;
+}
+#endif
+
+//! The state engine as a constexpr table of stages by events
+/*! The same engine as the boost::msm StateEngine without its template
+ *  machinery. A transition is one lookup of the dense stage and event ids
+ *  in a table built at compile time, an exit, an action called through a
+ *  function pointer and an entry, which print and trace like the boost::msm
+ *  states do.
+ */
+class TableEngine
+{
+public:
+  //! The number of stages
+  static constexpr std::size_t Stages =
+    static_cast<std::size_t>(Stage::Out) + 1;
+  //! The number of event ids
+  static constexpr std::size_t Events =
+    static_cast<std::size_t>(events::EventId::Exited) + 1;
+
+  //! The type of the transition actions
+  typedef void (*Action)(TableEngine&);
+
+  //! A transition of the table, a next stage of Undefined is none
+  struct Transition
+  {
+    Stage next;
+    Action action;
+  };
+
+  //! A row of the transition table
+  struct Row
+  {
+    Stage from;
+    events::EventId event;
+    Stage next;
+    Action action;
+  };
+
+  //! The transition table
+  struct Table
+  {
+    Transition transitions[Stages][Events];
+  };
+
+  /*! Like the boost::msm engine the engine is in its initial stage before
+   *  it is started, which isn't entered and isn't the stage reported yet.
+   */
+  TableEngine() :
+    stage_(Stage::Starting),
+    last_stage_(Stage::Undefined),
+    novos_sequence_(0),
+    itg_sequence_(0),
+    novos_accepted_(false),
+    itg_accepted_(false)
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+    , entered_(0)
+#endif
+  {}
+
+  //! Enter the engine and its initial stage
+  void start()
+  {
+#ifdef _GOS_ASSUMPTION_COUT_
+    ::std::cout << "Entering engine" << ::std::endl;
+#endif
+    this->Enter(Stage::Starting, events::EventId::Unknown);
+  }
+  //! Leave the current stage and the engine
+  void stop()
+  {
+    this->Leave(this->stage_);
+#ifdef _GOS_ASSUMPTION_COUT_
+    ::std::cout << "Leaving engine" << ::std::endl;
+#endif
+  }
+
+  //! Process an event, returns false if it has no transition
+  template<class Event> bool process_event(Event const&)
+  {
+    return this->process(events::Id<Event>::value);
+  }
+  //! Process the NOVOS data, a frame not newer than the last is stale
+  bool process_event(events::NovosDataAvailable const& e)
+  {
+    return this->data(
+      events::EventId::NovosDataAvailable, e.Data, this->novos_sequence_,
+      this->novos_accepted_);
+  }
+  //! Process the ITG data, a frame not newer than the last is stale
+  bool process_event(events::ItgDataAvailable const& e)
+  {
+    return this->data(
+      events::EventId::ItgDataAvailable, e.Data, this->itg_sequence_,
+      this->itg_accepted_);
+  }
+  //! Process the event of an id, returns false if it has no transition
+  bool process(const events::EventId& id);
+
+  //! The last stage entered
+  const Stage& GetStage() const { return this->last_stage_; }
+  //! The last stage entered, wait free from any thread
+  Stage stage() const { return this->published_.stage(); }
+  //! The number of transitions made, wait free from any thread
+  std::uint64_t transitions() const { return this->published_.transitions(); }
+  //! The sequence of the last NOVOS data frame accepted
+  const std::uint64_t& novos_sequence() const
+  {
+    return this->novos_sequence_;
+  }
+  //! The sequence of the last ITG data frame accepted
+  const std::uint64_t& itg_sequence() const { return this->itg_sequence_; }
+
+  // Transition actions
+  static void RequestControl(TableEngine&) {}
+  static void RelinquishControl(TableEngine&) {}
+  static void InformRequestSuccess(TableEngine&) {}
+  static void NotifyRequestFailure(TableEngine&) {}
+  static void NotifyLost(TableEngine&) {}
+  static void InformRelinquishSuccess(TableEngine&) {}
+  static void NotifyRelinquishFailure(TableEngine&) {}
+
+private:
+  static const char* text(const Stage& stage)
+  {
+    static const char* Texts[] = {
+      "",
+      "Starting",
+      "No data",
+      "No NOVOS data",
+      "No ITG data",
+      "Hoist Constrainst Activity Unavailable",
+      "Activities Available",
+      "Requesting Control",
+      "Relinquishing Control",
+      "In Control",
+      "Exiting",
+      "Out"
+    };
+    return Texts[static_cast<std::size_t>(stage)];
+  }
+
+  /* The guard and the action of the boost::msm data rows, the frame is
+   * read where it is. Like a guard a stale frame is no transition but not
+   * reported as one, the first frame is fresh whatever its sequence */
+  bool data(const events::EventId& id, const Frame& frame,
+    std::uint64_t& sequence, bool& accepted)
+  {
+    if (!frame.empty() && accepted && frame.sequence() <= sequence)
+    {
+      return false;
+    }
+    if (!this->process(id))
+    {
+      return false;
+    }
+    if (!frame.empty())
+    {
+      sequence = frame.sequence();
+      accepted = true;
+    }
+    return true;
+  }
+
+  void Enter(const Stage& stage, const events::EventId& event)
+  {
+#ifdef _GOS_ASSUMPTION_COUT_
+    std::cout << "entering: " << text(stage) << std::endl;
+#endif
+#ifdef _GOS_ASSUMPTION_TRACE_
+    ::gos::assumption::trace::Tracer::instance().record(
+      ::gos::assumption::trace::Kind::Entry,
+      static_cast<std::uint16_t>(this->last_stage_),
+      static_cast<std::uint16_t>(stage),
+      static_cast<std::uint16_t>(event));
+#else
+    (void)event;
+#endif
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+    const std::uint64_t now = histogram::Latencies::now();
+    if (this->last_stage_ != Stage::Undefined)
+    {
+      latencies().record(static_cast<std::uint16_t>(this->last_stage_),
+        static_cast<std::uint16_t>(stage), now - this->entered_);
+    }
+    this->entered_ = now;
+#endif
+    this->published_.publish(stage, this->last_stage_ != Stage::Undefined);
+    this->stage_ = stage;
+    this->last_stage_ = stage;
+  }
+  void Leave(const Stage& stage)
+  {
+#ifdef _GOS_ASSUMPTION_COUT_
+    std::cout << "leaving: " << text(stage) << std::endl;
+#else
+    (void)stage;
+#endif
+  }
+  void NoTransition(const events::EventId& event)
+  {
+#ifdef _GOS_ASSUMPTION_COUT_
+    std::cout << "no transition from state "
+      << stage_name(static_cast<std::uint16_t>(this->stage_))
+      << " on event " << event_name(static_cast<std::uint16_t>(event))
+      << std::endl;
+#endif
+#ifdef _GOS_ASSUMPTION_TRACE_
+    ::gos::assumption::trace::Tracer::instance().record(
+      ::gos::assumption::trace::Kind::NoTransition,
+      static_cast<std::uint16_t>(this->last_stage_),
+      static_cast<std::uint16_t>(this->last_stage_),
+      static_cast<std::uint16_t>(event));
+#else
+    (void)event;
+#endif
+  }
+
+  Stage stage_;
+  Stage last_stage_;
+  Published published_;
+  std::uint64_t novos_sequence_;
+  std::uint64_t itg_sequence_;
+  bool novos_accepted_;
+  bool itg_accepted_;
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+  std::uint64_t entered_;
+#endif
+};
+
+namespace detail
+{
+
+typedef TableEngine::Row Row;
+typedef events::EventId E;
+
+//! The rows of the transition table, the same as the boost::msm table
+inline constexpr Row Rows[] = {
+  //  Start          Event          Next           Action
+  //  +--------------+--------------+--------------+----------+
+  { Stage::Starting, E::Started, Stage::NoData, nullptr },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::NoData, E::NovosDataAvailable, Stage::NoItgData, nullptr },
+  { Stage::NoData, E::ItgDataAvailable, Stage::NoNovosData, nullptr },
+  { Stage::NoItgData, E::NovosDataUnavailable, Stage::NoData, nullptr },
+  { Stage::NoNovosData, E::ItgDataUnavailable, Stage::NoData, nullptr },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::NoItgData, E::ItgDataAvailable,
+    Stage::HoistConstrainstActivityUnavailable, nullptr },
+  { Stage::HoistConstrainstActivityUnavailable, E::ItgDataUnavailable,
+    Stage::NoItgData, nullptr },
+  { Stage::NoNovosData, E::NovosDataAvailable,
+    Stage::HoistConstrainstActivityUnavailable, nullptr },
+  { Stage::HoistConstrainstActivityUnavailable, E::NovosDataUnavailable,
+    Stage::NoNovosData, nullptr },
+  { Stage::HoistConstrainstActivityUnavailable,
+    E::HoistConstrainstActivityBecomesAvailable,
+    Stage::ActivitiesAvailable, nullptr },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::ActivitiesAvailable, E::HoistConstrainstActivityBecomesUnavailable,
+    Stage::HoistConstrainstActivityUnavailable, nullptr },
+  { Stage::ActivitiesAvailable, E::NovosDataUnavailable,
+    Stage::NoNovosData, nullptr },
+  { Stage::ActivitiesAvailable, E::ItgDataUnavailable,
+    Stage::NoItgData, nullptr },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::ActivitiesAvailable, E::ControlRequested,
+    Stage::RequestingControl, &TableEngine::RequestControl },
+  { Stage::RequestingControl, E::Granted,
+    Stage::InControl, &TableEngine::InformRequestSuccess },
+  { Stage::RequestingControl, E::Timeout,
+    Stage::ActivitiesAvailable, &TableEngine::NotifyRequestFailure },
+  { Stage::InControl, E::ControlLost,
+    Stage::ActivitiesAvailable, &TableEngine::NotifyLost },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::InControl, E::ControlRelinquished,
+    Stage::RelinquishingControl, &TableEngine::RelinquishControl },
+  { Stage::RelinquishingControl, E::ControlLost,
+    Stage::ActivitiesAvailable, &TableEngine::InformRelinquishSuccess },
+  { Stage::RelinquishingControl, E::Timeout,
+    Stage::ActivitiesAvailable, &TableEngine::NotifyRelinquishFailure },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::InControl, E::HoistConstrainstActivityBecomesUnavailable,
+    Stage::HoistConstrainstActivityUnavailable, nullptr },
+  { Stage::InControl, E::NovosDataUnavailable, Stage::NoNovosData, nullptr },
+  { Stage::InControl, E::ItgDataUnavailable, Stage::NoItgData, nullptr },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::NoData, E::Quit, Stage::Exiting, nullptr },
+  { Stage::NoItgData, E::Quit, Stage::Exiting, nullptr },
+  { Stage::NoNovosData, E::Quit, Stage::Exiting, nullptr },
+  { Stage::HoistConstrainstActivityUnavailable, E::Quit,
+    Stage::Exiting, nullptr },
+  { Stage::ActivitiesAvailable, E::Quit, Stage::Exiting, nullptr },
+  { Stage::RequestingControl, E::Quit, Stage::Exiting, nullptr },
+  { Stage::InControl, E::Quit, Stage::Exiting, nullptr },
+  { Stage::RelinquishingControl, E::Quit, Stage::Exiting, nullptr },
+  //  +--------------+--------------+--------------+----------+
+  { Stage::Exiting, E::Exited, Stage::Out, nullptr }
+};
+
+//! The dense table of the rows, compile time only
+constexpr TableEngine::Table table()
+{
+  TableEngine::Table result = {};
+  for (const Row& row : Rows)
+  {
+    result.transitions[static_cast<std::size_t>(row.from)]
+      [static_cast<std::size_t>(row.event)] =
+        TableEngine::Transition{ row.next, row.action };
+  }
+  return result;
+}
+
+//! The transition table of every table engine
+inline constexpr TableEngine::Table Transitions = table();
+
+/* A row per cell, a second row for a cell would overwrite the first */
+constexpr std::size_t count()
+{
+  std::size_t result = 0;
+  for (std::size_t stage = 0; stage < TableEngine::Stages; stage++)
+  {
+    for (std::size_t event = 0; event < TableEngine::Events; event++)
+    {
+      if (Transitions.transitions[stage][event].next != Stage::Undefined)
+      {
+        result++;
+      }
+    }
+  }
+  return result;
+}
+static_assert(count() == sizeof(Rows) / sizeof(Rows[0]),
+  "Two rows of the transition table are for the same stage and event");
+
+} /* namespace detail */
+
+inline bool TableEngine::process(const events::EventId& id)
+{
+  const std::size_t event = static_cast<std::size_t>(id);
+  const Transition& transition = detail::Transitions.transitions
+    [static_cast<std::size_t>(this->stage_)][event < Events ? event : 0];
+  if (transition.next == Stage::Undefined)
+  {
+    this->NoTransition(id);
+    return false;
+  }
+  this->Leave(this->stage_);
+  if (transition.action != nullptr)
+  {
+    transition.action(*this);
+  }
+  this->Enter(transition.next, id);
+  return true;
+}
+
+} /* namespace state_machine */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_MACHINE_H_ */
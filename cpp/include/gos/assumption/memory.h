@@ -0,0 +1,142 @@
+#ifndef _GOS_ASSUMPTION_MEMORY_H_
+#define _GOS_ASSUMPTION_MEMORY_H_
+
+#include <cstddef>
+
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! The memory resource type the containers allocate from
+typedef std::pmr::memory_resource MemoryResource;
+
+namespace detail
+{
+
+//! A deleter for arrays that may come from a memory resource
+/*! A default constructed deleter deletes an array created with new, which
+ *  makes it possible to adopt a std::unique_ptr<T[]>. A deleter with a
+ *  resource destroys the objects and returns the memory to the resource.
+ *  A borrowing deleter does nothing, it is used for parts of a block that
+ *  is owned elsewhere.
+ */
+template<typename T> class ArrayDeleter
+{
+public:
+  ArrayDeleter() : resource_(nullptr), count_(0), owning_(true) {}
+  //! A Constructor for an array of count objects allocated from a resource
+  ArrayDeleter(MemoryResource* resource, const std::size_t& count) :
+    resource_(resource), count_(count), owning_(true)
+  {}
+  //! A deleter for an array that is owned elsewhere
+  static ArrayDeleter borrowed()
+  {
+    ArrayDeleter deleter;
+    deleter.owning_ = false;
+    return deleter;
+  }
+  void operator()(T* pointer) const
+  {
+    if (!this->owning_)
+    {
+      return;
+    }
+    if (this->resource_ == nullptr)
+    {
+      delete[] pointer;
+      return;
+    }
+    if (!std::is_trivially_destructible<T>::value)
+    {
+      for (std::size_t i = 0; i < this->count_; i++)
+      {
+        pointer[i].~T();
+      }
+    }
+    this->resource_->deallocate(
+      pointer, this->count_ * sizeof(T), alignof(T));
+  }
+private:
+  MemoryResource* resource_;
+  std::size_t count_;
+  bool owning_;
+};
+
+//! A deleter for objects that may come from a memory resource
+/*! A default constructed deleter deletes an object created with new */
+template<typename T> class ObjectDeleter
+{
+public:
+  ObjectDeleter() : resource_(nullptr) {}
+  //! A Constructor for an object allocated from a resource
+  ObjectDeleter(MemoryResource* resource) : resource_(resource) {}
+  void operator()(T* pointer) const
+  {
+    if (this->resource_ == nullptr)
+    {
+      delete pointer;
+      return;
+    }
+    pointer->~T();
+    this->resource_->deallocate(pointer, sizeof(T), alignof(T));
+  }
+private:
+  MemoryResource* resource_;
+};
+
+//! Allocate an array of value initialized objects from a resource
+/*! Values like int, double and float are zeroed */
+template<typename T>
+std::unique_ptr<T[], ArrayDeleter<T>> make_array(
+  MemoryResource* resource, const std::size_t& count)
+{
+  T* pointer = static_cast<T*>(
+    resource->allocate(count * sizeof(T), alignof(T)));
+  std::size_t constructed = 0;
+  try
+  {
+    for (; constructed < count; constructed++)
+    {
+      ::new (static_cast<void*>(pointer + constructed)) T();
+    }
+  }
+  catch (...)
+  {
+    ArrayDeleter<T>(resource, constructed)(pointer);
+    throw;
+  }
+  return std::unique_ptr<T[], ArrayDeleter<T>>(
+    pointer, ArrayDeleter<T>(resource, count));
+}
+
+//! Allocate an object from a resource
+template<typename T, typename... Arguments>
+std::unique_ptr<T, ObjectDeleter<T>> make_object(
+  MemoryResource* resource, Arguments&&... arguments)
+{
+  void* pointer = resource->allocate(sizeof(T), alignof(T));
+  try
+  {
+    T* object = ::new (pointer) T(std::forward<Arguments>(arguments)...);
+    return std::unique_ptr<T, ObjectDeleter<T>>(
+      object, ObjectDeleter<T>(resource));
+  }
+  catch (...)
+  {
+    resource->deallocate(pointer, sizeof(T), alignof(T));
+    throw;
+  }
+}
+
+} /* namespace detail */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_MEMORY_H_ */
@@ -0,0 +1,142 @@
+#ifndef _GOS_ASSUMPTION_POLYMORPHIC_H_
+#define _GOS_ASSUMPTION_POLYMORPHIC_H_
+
+#include <gos/assumption.h>
+#include <gos/assumption/interfaces.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! A wrapper interface referring to a concrete wrapper
+/*! In the fast mode the concrete classes don't implement the virtual
+ *  interfaces, the adapters give code that needs them access to a concrete
+ *  object. The adapters work in both modes and must not outlive the object.
+ */
+template<typename T, typename W = gos::assumption::Wrapper<T>>
+class PolymorphicWrapper final : public gos::interfaces::Wrapper<T>
+{
+public:
+  //! A Constructor that takes a constant reference to the wrapper
+  PolymorphicWrapper(const W& wrapper) : wrapper_(wrapper) {}
+  //! Access to a constant reference to the wrapped object
+  const T& value() const { return this->wrapper_.value(); }
+  //! Checks if the wrapper is holding an object (is set or not)
+  const bool is_set() const { return this->wrapper_.is_set(); }
+private:
+  const W& wrapper_;
+};
+
+//! The holder interfaces referring to a concrete holder
+template<typename T, typename H = gos::assumption::Holder<T>>
+class PolymorphicHolder final :
+  public gos::interfaces::CopyableHolder<T>,
+  public gos::interfaces::ReferencableHolder<T>,
+  public gos::interfaces::PointeredHolder<T>
+{
+public:
+  //! A Constructor that takes a reference to the holder
+  PolymorphicHolder(H& holder) : holder_(holder) {}
+  //! Access to a copy of the contained value
+  T value() { return this->holder_.value(); }
+  //! Access to a reference of the contained value
+  T& reference() { return this->holder_.reference(); }
+  //! Access to a raw pointer to the contained value
+  T* pointer() { return this->holder_.pointer(); }
+private:
+  H& holder_;
+};
+
+//! An array holder interface referring to a concrete array holder
+template<typename T, typename H = gos::assumption::ArrayHolder<T>>
+class PolymorphicArrayHolder final : public gos::interfaces::ArrayHolder<T>
+{
+public:
+  //! The index type
+  typedef typename gos::interfaces::ArrayHolder<T>::Index Index;
+  //! The size type
+  typedef typename gos::interfaces::ArrayHolder<T>::Size Size;
+  //! A Constructor that takes a reference to the array holder
+  PolymorphicArrayHolder(H& holder) : holder_(holder) {}
+  //! Access a reference to an item by index
+  T& get(const Index& index) { return this->holder_.get(index); }
+  //! Access a pointer to an item by index
+  T* pointer(const Index& index) { return this->holder_.pointer(index); }
+  //! Get the internal array size as constant reference
+  const Size& size() const { return this->holder_.size(); }
+private:
+  H& holder_;
+};
+
+//! An Assumption interface referring to a concrete Assumption
+template<typename T, typename W, typename H,
+  typename A = gos::assumption::Assumption<T, W, H>>
+class PolymorphicAssumption final : public gos::interfaces::Assumption<T, W, H>
+{
+public:
+  //! The interface type
+  typedef gos::interfaces::Assumption<T, W, H> Interface;
+  //! The id type
+  typedef typename Interface::Id Id;
+  //! The id view type
+  typedef typename Interface::Key Key;
+  //! The index type
+  typedef typename Interface::Index Index;
+  //! The handle type
+  typedef typename Interface::Handle Handle;
+  //! The array type
+  typedef typename Interface::Array Array;
+  //! The array wrapper type
+  typedef typename Interface::WrapperArray WrapperArray;
+  //! The holder unique pointer type
+  typedef typename Interface::HolderPtr HolderPtr;
+
+  //! A Constructor that takes a reference to the Assumption
+  PolymorphicAssumption(A& assumption) : assumption_(assumption) {}
+  //! Create the unique items for the unique assumption
+  void unique(Array& a, WrapperArray& wrapper, HolderPtr& holder)
+  {
+    this->assumption_.unique(a, wrapper, holder);
+  }
+  //! Create the items for an id with an array size
+  void create(const Key& id, const Index& size)
+  {
+    this->assumption_.create(id, size);
+  }
+  //! Check if the id is contained in the object
+  bool has(const Key& id) const { return this->assumption_.has(id); }
+  //! Returns a reference to a value from an array by id and index
+  T& value(const Key& id, const Index& index)
+  {
+    return this->assumption_.value(id, index);
+  }
+  //! Returns a reference to a wrapper from an array by id and index
+  W& wrapper(const Key& id, const Index& index)
+  {
+    return this->assumption_.wrapper(id, index);
+  }
+  //! Returns a reference to a holder by id
+  H& holder(const Key& id) { return this->assumption_.holder(id); }
+  //! Resolve an id into a handle
+  Handle resolve(const Key& id) const { return this->assumption_.resolve(id); }
+  //! Returns a reference to a value from an array by handle and index
+  T& value(const Handle& handle, const Index& index)
+  {
+    return this->assumption_.value(handle, index);
+  }
+  //! Returns a reference to a wrapper from an array by handle and index
+  W& wrapper(const Handle& handle, const Index& index)
+  {
+    return this->assumption_.wrapper(handle, index);
+  }
+  //! Returns a reference to a holder by handle
+  H& holder(const Handle& handle) { return this->assumption_.holder(handle); }
+private:
+  A& assumption_;
+};
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_POLYMORPHIC_H_ */
@@ -0,0 +1,204 @@
+#ifndef _GOS_ASSUMPTION_PUMP_H_
+#define _GOS_ASSUMPTION_PUMP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+
+#include <gos/assumption/boost.h>
+#include <gos/assumption/queue.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+namespace state_machine_boost_msm
+{
+
+//! What posting an event does when the queue is full
+enum class Policy
+{
+  //! The event is not posted and the producer decides, the backpressure
+  Reject,
+  //! The event is dropped
+  Drop,
+  //! A data availability event replaces the pending event of its source
+  /*! The availability of the NOVOS data, the ITG data and the hoist
+   *  activity are levels, only the last event of a source matters. The
+   *  other events are dropped.
+   */
+  Coalesce
+};
+
+//! What happened to a posted event
+enum class Posted
+{
+  Queued,
+  Rejected,
+  Dropped,
+  Coalesced
+};
+
+//! The counters of an event pump
+struct PumpCounters
+{
+  std::uint64_t queued;
+  std::uint64_t rejected;
+  std::uint64_t dropped;
+  std::uint64_t coalesced;
+  std::uint64_t dispatched;
+  std::uint64_t batches;
+};
+
+//! Events posted from many threads and dispatched to an engine in batches
+/*! Posting is wait free and may be done from any thread, dispatching is
+ *  done by the one thread that owns the engine.
+ */
+class EventPump
+{
+public:
+  //! The size type
+  typedef std::size_t Size;
+  //! The default most events dispatched by one call
+  static constexpr Size Batch = 64;
+
+  //! A Constructor that takes the engine, the queue capacity and a policy
+  EventPump(StateEngine& engine, const Size& capacity, const Policy& policy) :
+    engine_(engine),
+    queue_(capacity),
+    policy_(policy),
+    queued_(0),
+    rejected_(0),
+    dropped_(0),
+    coalesced_(0),
+    dispatched_(0),
+    batches_(0)
+  {
+    for (std::atomic<events::EventId>& pending : this->pending_)
+    {
+      pending.store(events::EventId::Unknown, std::memory_order_relaxed);
+    }
+  }
+
+  //! Post an event
+  Posted post(const events::EventId& id)
+  {
+    const Size source = this->source(id);
+    /* Once an event of a source is pending the later ones of the source
+     * are coalesced too, so the pending one is never older than a queued
+     * one */
+    const bool pending = source < Sources &&
+      this->pending_[source].load(std::memory_order_acquire) !=
+        events::EventId::Unknown;
+    if (!pending && this->queue_.push(id))
+    {
+      this->queued_.fetch_add(1, std::memory_order_relaxed);
+      return Posted::Queued;
+    }
+    if (this->policy_ == Policy::Reject)
+    {
+      this->rejected_.fetch_add(1, std::memory_order_relaxed);
+      return Posted::Rejected;
+    }
+    if (this->policy_ == Policy::Drop || source == Sources)
+    {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return Posted::Dropped;
+    }
+    this->pending_[source].store(id, std::memory_order_release);
+    this->coalesced_.fetch_add(1, std::memory_order_relaxed);
+    return Posted::Coalesced;
+  }
+
+  //! Dispatch up to a number of queued events to the engine
+  /*! The pending coalesced events are dispatched once the queue is empty.
+   *  Returns the number of events dispatched.
+   */
+  Size dispatch(const Size& most = Batch)
+  {
+    Size result = this->queue_.pop([this](const events::EventId& id)
+    {
+      process(this->engine_, id);
+    }, most);
+    if (result < most)
+    {
+      for (std::atomic<events::EventId>& pending : this->pending_)
+      {
+        const events::EventId id =
+          pending.exchange(events::EventId::Unknown, std::memory_order_acq_rel);
+        if (id != events::EventId::Unknown)
+        {
+          process(this->engine_, id);
+          result++;
+        }
+      }
+    }
+    if (result > 0)
+    {
+      this->dispatched_.fetch_add(result, std::memory_order_relaxed);
+      this->batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  //! The number of events queued and not yet dispatched
+  Size size() const { return this->queue_.size(); }
+
+  //! A snapshot of the counters
+  PumpCounters counters() const
+  {
+    return PumpCounters{
+      this->queued_.load(std::memory_order_relaxed),
+      this->rejected_.load(std::memory_order_relaxed),
+      this->dropped_.load(std::memory_order_relaxed),
+      this->coalesced_.load(std::memory_order_relaxed),
+      this->dispatched_.load(std::memory_order_relaxed),
+      this->batches_.load(std::memory_order_relaxed)
+    };
+  }
+
+private:
+  //! The number of sources of availability events
+  static constexpr Size Sources = 3;
+
+  //! The source of an availability event or Sources for other events
+  static Size source(const events::EventId& id)
+  {
+    switch (id)
+    {
+    case events::EventId::NovosDataAvailable:
+    case events::EventId::NovosDataUnavailable:
+      return 0;
+    case events::EventId::ItgDataAvailable:
+    case events::EventId::ItgDataUnavailable:
+      return 1;
+    case events::EventId::HoistConstrainstActivityBecomesAvailable:
+    case events::EventId::HoistConstrainstActivityBecomesUnavailable:
+      return 2;
+    default:
+      return Sources;
+    }
+  }
+
+  StateEngine& engine_;
+  MpscQueue<events::EventId> queue_;
+  Policy policy_;
+  std::atomic<events::EventId> pending_[Sources];
+  std::atomic<std::uint64_t> queued_;
+  std::atomic<std::uint64_t> rejected_;
+  std::atomic<std::uint64_t> dropped_;
+  std::atomic<std::uint64_t> coalesced_;
+  std::atomic<std::uint64_t> dispatched_;
+  std::atomic<std::uint64_t> batches_;
+};
+
+} /* namespace state_machine_boost_msm */
+#endif
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_PUMP_H_ */
@@ -0,0 +1,126 @@
+#ifndef _GOS_ASSUMPTION_QUEUE_H_
+#define _GOS_ASSUMPTION_QUEUE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! A bounded queue of many producers and one consumer
+/*! Pushing is wait free, a producer reserves room with one atomic add,
+ *  takes a slot with another and publishes the value with a store, and
+ *  fails at once when the queue is full instead of waiting. The consumer
+ *  pops values in the order their slots were taken, a value that is taken
+ *  but not yet published ends the current batch. The capacity is rounded
+ *  up to a power of 2.
+ */
+template<typename T> class MpscQueue
+{
+public:
+  //! The value type
+  typedef T Value;
+  //! The size type
+  typedef std::size_t Size;
+
+  //! A Constructor that takes the capacity of the queue
+  MpscQueue(const Size& capacity) :
+    capacity_(round(capacity)),
+    mask_(capacity_ - 1),
+    slots_(std::make_unique<Slot[]>(capacity_)),
+    count_(0),
+    tail_(0),
+    head_(0)
+  {
+    for (Size i = 0; i < this->capacity_; i++)
+    {
+      this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  //! The capacity of the queue
+  const Size& capacity() const { return this->capacity_; }
+  //! The number of values reserved and not yet popped
+  Size size() const { return this->count_.load(std::memory_order_relaxed); }
+
+  //! Push a value, fails if the queue is full
+  bool push(const T& value)
+  {
+    if (this->count_.fetch_add(1, std::memory_order_acquire) >=
+      this->capacity_)
+    {
+      this->count_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    const std::uint64_t ticket =
+      this->tail_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = this->slots_[ticket & this->mask_];
+    /* The room reserved guarantees the consumer freed the slot */
+    assert(slot.sequence.load(std::memory_order_acquire) == ticket);
+    slot.value = value;
+    slot.sequence.store(ticket + 1, std::memory_order_release);
+    return true;
+  }
+
+  //! Pop up to a number of published values, only called by the consumer
+  /*! Read is called with each value in order, the room of the batch is
+   *  released at once after it. Returns the number of values popped.
+   */
+  template<typename F> Size pop(F&& read, const Size& most)
+  {
+    Size result = 0;
+    while (result < most)
+    {
+      Slot& slot = this->slots_[this->head_ & this->mask_];
+      if (slot.sequence.load(std::memory_order_acquire) != this->head_ + 1)
+      {
+        break;
+      }
+      read(slot.value);
+      slot.sequence.store(
+        this->head_ + this->capacity_, std::memory_order_release);
+      this->head_++;
+      result++;
+    }
+    if (result > 0)
+    {
+      this->count_.fetch_sub(result, std::memory_order_release);
+    }
+    return result;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<std::uint64_t> sequence;
+    T value;
+  };
+
+  static Size round(const Size& capacity)
+  {
+    Size result = 1;
+    while (result < capacity)
+    {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  Size capacity_;
+  Size mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<Size> count_;
+  alignas(64) std::atomic<std::uint64_t> tail_;
+  alignas(64) std::uint64_t head_;
+};
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_QUEUE_H_ */
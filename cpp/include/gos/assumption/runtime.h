@@ -0,0 +1,218 @@
+#ifndef _GOS_ASSUMPTION_RUNTIME_H_
+#define _GOS_ASSUMPTION_RUNTIME_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gos/assumption/machine.h>
+#include <gos/assumption/queue.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace state_machine
+{
+
+//! Many table engines sharded across worker threads by instance id
+/*! Instance i is owned by shard i modulo the number of shards. A shard has
+ *  its engines in one vector, a queue of the events posted to them and a
+ *  worker thread that dispatches them in batches, so an engine is only
+ *  ever touched by the thread of its shard and needs no lock. Posting is
+ *  wait free from any thread and fails when the queue of the shard is
+ *  full. The events of an instance posted by one thread are processed in
+ *  the order they were posted.
+ */
+class Runtime
+{
+public:
+  //! The size type
+  typedef std::size_t Size;
+  //! The instance id type
+  typedef std::uint32_t Instance;
+  //! The most events a worker dispatches before it publishes its counters
+  static constexpr Size Batch = 256;
+
+  //! A Constructor that takes the number of instances and of shards
+  /*! The engines are started, the workers are not. There is at least one
+   *  shard.
+   */
+  Runtime(
+    const Size& instances,
+    const Size& shards,
+    const Size& capacity = 4096) :
+    instances_(instances),
+    running_(false)
+  {
+    const Size count = shards > 0 ? shards : 1;
+    for (Size i = 0; i < count; i++)
+    {
+      this->shards_.push_back(std::make_unique<Shard>(
+        (instances + count - 1 - i) / count, capacity));
+    }
+  }
+  ~Runtime() { this->stop(); }
+
+  //! Start a worker thread per shard
+  void start()
+  {
+    if (this->running_.exchange(true))
+    {
+      return;
+    }
+    for (std::unique_ptr<Shard>& shard : this->shards_)
+    {
+      Shard* pointer = shard.get();
+      shard->worker = std::thread([this, pointer]() { this->run(*pointer); });
+    }
+  }
+  //! Stop the workers once they dispatched the events posted
+  void stop()
+  {
+    if (!this->running_.exchange(false))
+    {
+      return;
+    }
+    for (std::unique_ptr<Shard>& shard : this->shards_)
+    {
+      shard->worker.join();
+    }
+  }
+
+  //! Post an event to an instance
+  /*! Fails if the instance is not one of the runtime or if the queue of its
+   *  shard is full
+   */
+  bool post(const Instance& instance, const events::EventId& id)
+  {
+    if (instance >= this->instances_)
+    {
+      return false;
+    }
+    return this->shards_[this->shard(instance)]->queue.push(
+      Envelope{ this->local(instance), id });
+  }
+
+  //! The number of instances
+  const Size& instances() const { return this->instances_; }
+  //! The number of shards
+  Size shards() const { return this->shards_.size(); }
+  //! The shard of an instance
+  Size shard(const Instance& instance) const
+  {
+    return instance % this->shards_.size();
+  }
+
+  //! The number of events dispatched
+  std::uint64_t processed() const
+  {
+    std::uint64_t result = 0;
+    for (const std::unique_ptr<Shard>& shard : this->shards_)
+    {
+      result += shard->processed.load(std::memory_order_acquire);
+    }
+    return result;
+  }
+  //! The number of events dispatched that made a transition
+  std::uint64_t transitions() const
+  {
+    std::uint64_t result = 0;
+    for (const std::unique_ptr<Shard>& shard : this->shards_)
+    {
+      result += shard->transitions.load(std::memory_order_acquire);
+    }
+    return result;
+  }
+
+  //! The stage of an instance, wait free from any thread
+  Stage stage(const Instance& instance) const
+  {
+    assert(instance < this->instances_);
+    return this->shards_[this->shard(instance)]->engines[
+      this->local(instance)].stage();
+  }
+
+private:
+  //! An event posted to the engine of a shard
+  struct Envelope
+  {
+    Instance local;
+    events::EventId id;
+  };
+
+  struct Shard
+  {
+    Shard(const Size& instances, const Size& capacity) :
+      engines(instances), queue(capacity), processed(0), transitions(0)
+    {
+      for (TableEngine& engine : this->engines)
+      {
+        engine.start();
+      }
+    }
+    std::vector<TableEngine> engines;
+    MpscQueue<Envelope> queue;
+    std::thread worker;
+    alignas(64) std::atomic<std::uint64_t> processed;
+    std::atomic<std::uint64_t> transitions;
+  };
+
+  Instance local(const Instance& instance) const
+  {
+    return static_cast<Instance>(instance / this->shards_.size());
+  }
+
+  void run(Shard& shard)
+  {
+    /* An idle worker yields and then sleeps, a producer never wakes it */
+    Size idle = 0;
+    while (true)
+    {
+      const bool running = this->running_.load(std::memory_order_acquire);
+      std::uint64_t transitions = 0;
+      const Size count = shard.queue.pop([&](const Envelope& envelope)
+      {
+        if (shard.engines[envelope.local].process(envelope.id))
+        {
+          transitions++;
+        }
+      }, Batch);
+      if (count > 0)
+      {
+        shard.transitions.fetch_add(transitions, std::memory_order_relaxed);
+        shard.processed.fetch_add(count, std::memory_order_release);
+        idle = 0;
+        continue;
+      }
+      if (!running)
+      {
+        break;
+      }
+      if (++idle < 64)
+      {
+        std::this_thread::yield();
+      }
+      else
+      {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+  }
+
+  Size instances_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<bool> running_;
+};
+
+} /* namespace state_machine */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_RUNTIME_H_ */
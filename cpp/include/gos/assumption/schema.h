@@ -0,0 +1,231 @@
+#ifndef _GOS_ASSUMPTION_SCHEMA_H_
+#define _GOS_ASSUMPTION_SCHEMA_H_
+
+#include <cstddef>
+
+#include <tuple>
+#include <type_traits>
+
+#include <gos/assumption/view.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace schema
+{
+
+typedef ::gos::assumption::endian::Order Order;
+
+namespace detail
+{
+
+//! The record and value types of a pointer to a data member
+template<typename M> struct Member;
+template<typename T, typename R> struct Member<T R::*>
+{
+  typedef R Record;
+  typedef T Value;
+};
+
+} /* namespace detail */
+
+//! A field of a fixed layout record
+/*! M is a pointer to the data member the field is decoded into, O the byte
+ *  order of the field and Offset its position in bytes from the start of
+ *  the record. The width of the field is the size of the member type.
+ */
+template<auto M, Order O, std::size_t Offset> struct Field
+{
+  typedef typename detail::Member<decltype(M)>::Record Record;
+  typedef typename detail::Member<decltype(M)>::Value Value;
+  static_assert(std::is_arithmetic<Value>::value,
+    "A field must be an integer or a floating point value");
+
+  static constexpr std::size_t Begin = Offset;
+  static constexpr std::size_t End = Offset + sizeof(Value);
+
+  static void decode(const unsigned char* data, Record& record)
+  {
+    record.*M = endian::detail::decode<Value, O>(data + Offset);
+  }
+  static void encode(unsigned char* data, const Record& record)
+  {
+    endian::detail::encode<Value, O>(data + Offset, record.*M);
+  }
+  //! Decode the field of a record into an item of a column
+  template<typename I> static void decode(const unsigned char* data, I& item)
+  {
+    item = endian::detail::decode<Value, O>(data + Offset);
+  }
+};
+
+namespace detail
+{
+
+template<typename... F> constexpr std::size_t end()
+{
+  std::size_t result = 0;
+  ((result = F::End > result ? F::End : result), ...);
+  return result;
+}
+
+//! Check that no two fields share a byte
+template<typename... F> constexpr bool disjoint()
+{
+  const std::size_t Begins[] = { F::Begin... };
+  const std::size_t Ends[] = { F::End... };
+  const std::size_t Count = sizeof...(F);
+  for (std::size_t i = 0; i < Count; i++)
+  {
+    for (std::size_t j = i + 1; j < Count; j++)
+    {
+      if (Begins[i] < Ends[j] && Begins[j] < Ends[i])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} /* namespace detail */
+
+//! The layout of a fixed size binary record as a list of fields
+/*! The schema is resolved at compile time, decoding a record is one load
+ *  and at most one byte swap per field at constant offsets with no parsing
+ *  state in between. Records of an array are Bytes apart unless a
+ *  stride is given, the bytes not covered by a field are skipped.
+ *  The decoders don't check bounds beyond the given byte counts.
+ */
+template<typename... F> class Schema
+{
+public:
+  static_assert(sizeof...(F) > 0, "A schema needs at least one field");
+
+  //! The struct the record is decoded into
+  typedef typename std::tuple_element<0, std::tuple<F...>>::type::Record
+    Record;
+  static_assert((std::is_same<Record, typename F::Record>::value && ...),
+    "All fields of a schema must be members of the same struct");
+  static_assert(detail::disjoint<F...>(), "Fields of a schema overlap");
+
+  //! The size type
+  typedef std::size_t Size;
+  //! The number of fields
+  static constexpr Size Fields = sizeof...(F);
+  //! The number of bytes of one record
+  static constexpr Size Bytes = detail::end<F...>();
+
+  //! Decode one record
+  static void decode(const void* data, Record& record)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    (F::decode(bytes, record), ...);
+  }
+  //! Encode one record
+  static void encode(void* data, const Record& record)
+  {
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    (F::encode(bytes, record), ...);
+  }
+  //! Decode the records of a frame into an array
+  /*! Decodes the whole records that fit in size bytes up to count and
+   *  returns the number of records decoded, none if the stride is shorter
+   *  than a record.
+   */
+  static Size decode(
+    const void* data,
+    const Size& size,
+    Record* records,
+    const Size& count,
+    const Size& stride = Bytes)
+  {
+    const Size result = fit(size, count, stride);
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (Size i = 0; i < result; i++)
+    {
+      (F::decode(bytes, records[i]), ...);
+      bytes += stride;
+    }
+    return result;
+  }
+  //! Encode an array of records into a frame
+  /*! Returns the number of records encoded in the size bytes, none if the
+   *  stride is shorter than a record
+   */
+  static Size encode(
+    void* data,
+    const Size& size,
+    const Record* records,
+    const Size& count,
+    const Size& stride = Bytes)
+  {
+    const Size result = fit(size, count, stride);
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (Size i = 0; i < result; i++)
+    {
+      (F::encode(bytes, records[i]), ...);
+      bytes += stride;
+    }
+    return result;
+  }
+  //! Decode the records of a frame into one column per field
+  /*! The columns are array holders like ArrayHolder<T> or
+   *  ArrayHolder<Wrapper<T>> in the order of the fields. Decodes the whole
+   *  records that fit in size bytes and in the smallest column and returns
+   *  the number of records decoded, none if the stride is shorter than a
+   *  record.
+   */
+  template<typename... H> static Size decode_columns(
+    const void* data,
+    const Size& size,
+    const Size& stride,
+    H&... columns)
+  {
+    static_assert(sizeof...(H) == sizeof...(F),
+      "A schema needs one column per field");
+    Size count = size;
+    ((count = static_cast<Size>(columns.size()) < count ?
+      static_cast<Size>(columns.size()) : count), ...);
+    const Size result = fit(size, count, stride);
+    if (result == 0)
+    {
+      return 0;
+    }
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    scatter(bytes, result, stride, columns.pointer(0)...);
+    return result;
+  }
+
+private:
+  //! The number of whole records of a stride in size bytes up to count
+  /*! A stride shorter than a record would overlap the records, none fit */
+  static Size fit(const Size& size, const Size& count, const Size& stride)
+  {
+    if (size < Bytes || stride < Bytes)
+    {
+      return 0;
+    }
+    const Size whole = (size - Bytes) / stride + 1;
+    return whole < count ? whole : count;
+  }
+  template<typename... I> static void scatter(
+    const unsigned char* bytes,
+    const Size& count,
+    const Size& stride,
+    I*... items)
+  {
+    for (Size i = 0; i < count; i++)
+    {
+      (F::decode(bytes, items[i]), ...);
+      bytes += stride;
+    }
+  }
+};
+
+} /* namespace schema */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_SCHEMA_H_ */
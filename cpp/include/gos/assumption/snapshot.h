@@ -0,0 +1,379 @@
+#ifndef _GOS_ASSUMPTION_SNAPSHOT_H_
+#define _GOS_ASSUMPTION_SNAPSHOT_H_
+
+#include <cassert>
+#include <cstdint>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gos/assumption/interfaces.h>
+#include <gos/assumption/table.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! The Assumption registry with lock-free read snapshots
+/*! The mapping from id to items is an immutable version. Writers serialize
+ *  on a mutex, copy the current version, modify the copy and publish it with
+ *  an atomic store. Readers take a snapshot, which announces the current
+ *  epoch in the slot of the reader and loads the current version, and then
+ *  look ids up in the snapshot without any further synchronization.
+ *  A replaced version is retired with the epoch it was replaced in and freed
+ *  once no reader slot announces that epoch or an earlier one.
+ *  The items of an id are shared between versions, the snapshot guards the
+ *  mapping and the lifetime of the items, not concurrent writes to values.
+ */
+template<typename T, typename W, typename H> class SnapshotAssumption
+{
+public:
+  //! The id type
+  typedef std::string Id;
+  //! The id view type
+  typedef std::string_view Key;
+  //! The index type
+  typedef unsigned int Index;
+  //! The size type
+  typedef Index Size;
+  //! The handle type, valid in every version containing the id
+  typedef ::gos::interfaces::Handle Handle;
+  //! The type of an id and the array size to create for it
+  typedef std::pair<Id, Size> Entry;
+  //! The type of a batch of ids to create in bulk
+  typedef std::vector<Entry> Batch;
+  //! The epoch type
+  typedef std::uint64_t Epoch;
+
+  //! The handle returned when resolving an id that is not contained
+  static const Handle NoHandle = ::gos::interfaces::NoHandle;
+  //! The default number of reader slots
+  static const size_t DefaultReaders = 64;
+
+  //! The items of an id
+  class Item
+  {
+  public:
+    //! A Constructor that creates zeroed values and default wrappers
+    Item(const Size& size) :
+      values_(std::make_unique<T[]>(size)),
+      wrappers_(std::make_unique<W[]>(size)),
+      holder_(std::make_unique<H>(size)),
+      size_(size)
+    {}
+    //! Access to a raw pointer to the values
+    T* values() const { return this->values_.get(); }
+    //! Access to a raw pointer to the wrappers
+    W* wrappers() const { return this->wrappers_.get(); }
+    //! Access to the holder
+    H& holder() const { return *this->holder_; }
+    //! The array size
+    const Size& size() const { return this->size_; }
+  private:
+    std::unique_ptr<T[]> values_;
+    std::unique_ptr<W[]> wrappers_;
+    std::unique_ptr<H> holder_;
+    Size size_;
+  };
+
+private:
+  struct Record
+  {
+    Id id;
+    std::shared_ptr<Item> item;
+  };
+
+  typedef detail::RecordTable<Record> Table;
+
+  struct Version
+  {
+    Table table;
+    std::uint64_t number = 0;
+  };
+
+  /* Every reader slot is kept on its own cache line */
+  struct alignas(64) Slot
+  {
+    std::atomic<Epoch> epoch;
+  };
+
+  /* A slot that is not claimed by a reader */
+  static const Epoch Free = std::numeric_limits<Epoch>::max();
+  /* A slot of a reader without a snapshot */
+  static const Epoch Idle = Free - 1;
+
+public:
+  //! A lock-free view of one version of the registry
+  /*! The version stays alive while the snapshot exists. A snapshot is
+   *  meant to be short lived, a long lived snapshot holds back reclamation.
+   */
+  class Snapshot
+  {
+  public:
+    Snapshot(Snapshot&& snapshot) :
+      slot_(snapshot.slot_), version_(snapshot.version_)
+    {
+      snapshot.slot_ = nullptr;
+      snapshot.version_ = nullptr;
+    }
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    ~Snapshot()
+    {
+      if (this->slot_ != nullptr)
+      {
+        this->slot_->epoch.store(Idle, std::memory_order_release);
+      }
+    }
+    //! Check if the id is contained in the version
+    bool has(const Key& id) const
+    {
+      return this->version_->table.find(id) != Table::Npos;
+    }
+    //! Resolve an id into a handle or NoHandle
+    Handle resolve(const Key& id) const
+    {
+      return static_cast<Handle>(this->version_->table.find(id));
+    }
+    //! Find the items of an id or a null pointer
+    const Item* find(const Key& id) const
+    {
+      const typename Table::Index index = this->version_->table.find(id);
+      return index != Table::Npos ?
+        this->version_->table.at(index).item.get() : nullptr;
+    }
+    //! Access the items of an id by handle
+    const Item& item(const Handle& handle) const
+    {
+      const typename Table::Index index =
+        static_cast<typename Table::Index>(handle);
+      assert(this->version_->table.live(index));
+      return *this->version_->table.at(index).item;
+    }
+    //! Find a value by id and index or a null pointer
+    const T* find_value(const Key& id, const Index& index) const
+    {
+      const Item* item = this->find(id);
+      return item != nullptr ? item->values() + index : nullptr;
+    }
+    //! Find a wrapper by id and index or a null pointer
+    const W* find_wrapper(const Key& id, const Index& index) const
+    {
+      const Item* item = this->find(id);
+      return item != nullptr ? item->wrappers() + index : nullptr;
+    }
+    //! The number of ids in the version
+    size_t size() const { return this->version_->table.size(); }
+    //! The number of the version, incremented by every publish
+    std::uint64_t version() const { return this->version_->number; }
+  private:
+    friend class SnapshotAssumption;
+    Snapshot(Slot* slot, const Version* version) :
+      slot_(slot), version_(version)
+    {}
+    Slot* slot_;
+    const Version* version_;
+  };
+
+  //! A registered reader owning a slot to announce its epoch in
+  /*! A reader is used by one thread and holds at most one snapshot at a
+   *  time.
+   */
+  class Reader
+  {
+  public:
+    Reader(Reader&& reader) :
+      registry_(reader.registry_), slot_(reader.slot_)
+    {
+      reader.slot_ = nullptr;
+    }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    ~Reader()
+    {
+      if (this->slot_ != nullptr)
+      {
+        assert(this->slot_->epoch.load() == Idle);
+        this->slot_->epoch.store(Free, std::memory_order_release);
+      }
+    }
+    //! Take a snapshot of the current version
+    Snapshot snapshot() const
+    {
+      assert(this->slot_->epoch.load(std::memory_order_relaxed) == Idle);
+      /* The announcement must be visible before the version is loaded so a
+       * writer either sees the announcement or the reader sees the newer
+       * version, which is why both are sequentially consistent */
+      this->slot_->epoch.store(this->registry_->epoch_.load());
+      return Snapshot(this->slot_, this->registry_->current_.load());
+    }
+  private:
+    friend class SnapshotAssumption;
+    Reader(const SnapshotAssumption* registry, Slot* slot) :
+      registry_(registry), slot_(slot)
+    {}
+    const SnapshotAssumption* registry_;
+    Slot* slot_;
+  };
+
+  //! A Constructor that takes the maximum number of concurrent readers
+  SnapshotAssumption(const size_t& readers = DefaultReaders) :
+    slots_(std::make_unique<Slot[]>(readers)),
+    readers_(readers),
+    current_(new Version()),
+    epoch_(0)
+  {
+    for (size_t i = 0; i < this->readers_; i++)
+    {
+      this->slots_[i].epoch.store(Free, std::memory_order_relaxed);
+    }
+  }
+  SnapshotAssumption(const SnapshotAssumption&) = delete;
+  SnapshotAssumption& operator=(const SnapshotAssumption&) = delete;
+  //! The destructor, all readers must have been destroyed
+  ~SnapshotAssumption()
+  {
+    for (Retired& retired : this->retired_)
+    {
+      delete retired.second;
+    }
+    delete this->current_.load();
+  }
+
+  //! Register a reader
+  /*! Returns a reader or throws std::length_error if every slot is taken */
+  Reader reader()
+  {
+    for (size_t i = 0; i < this->readers_; i++)
+    {
+      Epoch expected = Free;
+      if (this->slots_[i].epoch.compare_exchange_strong(expected, Idle))
+      {
+        return Reader(this, &this->slots_[i]);
+      }
+    }
+    throw std::length_error("No free reader slot");
+  }
+
+  //! Create the items for an id and publish a new version
+  void create(const Key& id, const Size& size)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    std::unique_ptr<Version> version = this->copy();
+    Record& record = version->table.at(version->table.insert(id).first);
+    record.item = std::make_shared<Item>(size);
+    this->publish(std::move(version));
+  }
+  //! Create the items for a batch of ids and publish one new version
+  void create_many(const Batch& batch)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    std::unique_ptr<Version> version = this->copy();
+    version->table.reserve(version->table.size() + batch.size());
+    for (const Entry& entry : batch)
+    {
+      Record& record =
+        version->table.at(version->table.insert(entry.first).first);
+      record.item = std::make_shared<Item>(entry.second);
+    }
+    this->publish(std::move(version));
+  }
+  //! Remove an id and publish a new version
+  /*! The items are released once no version refers to them */
+  bool remove(const Key& id)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (this->current_.load()->table.find(id) == Table::Npos)
+    {
+      return false;
+    }
+    std::unique_ptr<Version> version = this->copy();
+    version->table.erase(id);
+    this->publish(std::move(version));
+    return true;
+  }
+  //! Free the retired versions no reader can observe any more
+  /*! Returns the number of versions still waiting to be freed */
+  size_t reclaim()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->collect();
+  }
+
+private:
+  typedef std::pair<Epoch, Version*> Retired;
+
+  std::unique_ptr<Version> copy() const
+  {
+    std::unique_ptr<Version> version =
+      std::make_unique<Version>(*this->current_.load());
+    version->number++;
+    return version;
+  }
+  void publish(std::unique_ptr<Version> version)
+  {
+    Version* previous = this->current_.exchange(version.release());
+    this->retired_.push_back(Retired(this->epoch_.fetch_add(1), previous));
+    this->collect();
+  }
+  size_t collect()
+  {
+    Epoch oldest = Idle;
+    for (size_t i = 0; i < this->readers_; i++)
+    {
+      const Epoch epoch = this->slots_[i].epoch.load();
+      if (epoch < oldest)
+      {
+        oldest = epoch;
+      }
+    }
+    /* A reader that announced epoch e loaded a version that was current
+     * at or after e, so a version retired in an earlier epoch is unseen */
+    size_t kept = 0;
+    for (Retired& retired : this->retired_)
+    {
+      if (retired.first < oldest)
+      {
+        delete retired.second;
+      }
+      else
+      {
+        this->retired_[kept++] = retired;
+      }
+    }
+    this->retired_.resize(kept);
+    return kept;
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t readers_;
+  std::atomic<Version*> current_;
+  std::atomic<Epoch> epoch_;
+  std::mutex mutex_;
+  std::vector<Retired> retired_;
+};
+
+template<typename T, typename W, typename H>
+const typename SnapshotAssumption<T, W, H>::Handle
+  SnapshotAssumption<T, W, H>::NoHandle;
+template<typename T, typename W, typename H>
+const size_t SnapshotAssumption<T, W, H>::DefaultReaders;
+template<typename T, typename W, typename H>
+const typename SnapshotAssumption<T, W, H>::Epoch
+  SnapshotAssumption<T, W, H>::Free;
+template<typename T, typename W, typename H>
+const typename SnapshotAssumption<T, W, H>::Epoch
+  SnapshotAssumption<T, W, H>::Idle;
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_SNAPSHOT_H_ */
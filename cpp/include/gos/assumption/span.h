@@ -0,0 +1,63 @@
+#ifndef _GOS_ASSUMPTION_SPAN_H_
+#define _GOS_ASSUMPTION_SPAN_H_
+
+#include <cassert>
+#include <cstddef>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! A non-owning view of a contiguous sequence of objects
+/*! The viewed objects must outlive the span. A span is cheap to copy and
+ *  is passed by value.
+ */
+template<typename T> class Span
+{
+public:
+  //! The element type
+  typedef T Element;
+  //! The size type
+  typedef std::size_t Size;
+  //! The iterator type
+  typedef T* Iterator;
+
+  Span() : data_(nullptr), size_(0) {}
+  //! A Constructor that takes a pointer to the first object and a count
+  Span(T* data, const Size& size) : data_(data), size_(size) {}
+  //! A span of constant objects can be created from a span of objects
+  template<typename U> Span(const Span<U>& span) :
+    data_(span.data()), size_(span.size())
+  {}
+
+  //! Access a reference to an object by index
+  T& operator[](const Size& index) const
+  {
+    assert(index < this->size_);
+    return this->data_[index];
+  }
+  //! Access to a raw pointer to the first object
+  T* data() const { return this->data_; }
+  //! The number of objects in the span
+  Size size() const { return this->size_; }
+  //! Check if the span is empty
+  bool empty() const { return this->size_ == 0; }
+  Iterator begin() const { return this->data_; }
+  Iterator end() const { return this->data_ + this->size_; }
+  //! A span of a part of this span
+  Span subspan(const Size& offset, const Size& count) const
+  {
+    assert(offset + count <= this->size_);
+    return Span(this->data_ + offset, count);
+  }
+
+private:
+  T* data_;
+  Size size_;
+};
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_SPAN_H_ */
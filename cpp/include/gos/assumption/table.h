@@ -0,0 +1,283 @@
+#ifndef _GOS_ASSUMPTION_TABLE_H_
+#define _GOS_ASSUMPTION_TABLE_H_
+
+#include <cassert>
+#include <cstddef>
+
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gos/assumption/memory.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace detail
+{
+
+//! Hash an id
+/*! The hash of a view is equal to the hash of the equivalent string */
+inline std::size_t hash(const std::string_view& id)
+{
+  return std::hash<std::string_view>()(id);
+}
+
+//! An open addressing hash table of records keyed by an id
+/*! The records are kept densely in a vector and the probe sequence only
+ *  stores the full hash of the id and the index of the record, so a lookup
+ *  costs one hash of the id, a linear probe over a compact slot array and
+ *  normally a single id comparison.
+ *  The index of a record stays the same until the record is erased, the
+ *  index of an erased record is reused by a later insert.
+ *  The record type must have a public member named id.
+ *  The slots and the records are allocated from the memory resource given at
+ *  construction, a copy of a table allocates from the default resource.
+ */
+template<typename R> class RecordTable
+{
+public:
+  //! The record type
+  typedef R Record;
+  //! The id type
+  typedef std::string Id;
+  //! The id view type used for lookups without a temporary id
+  typedef std::string_view Key;
+  //! The hash type
+  typedef std::size_t Hash;
+  //! The record index type
+  typedef unsigned int Index;
+  //! The size type
+  typedef std::size_t Size;
+
+  //! The index returned when an id is not contained in the table
+  static const Index Npos = std::numeric_limits<Index>::max();
+
+  //! A Constructor that takes the memory resource to allocate from
+  RecordTable(MemoryResource* resource = std::pmr::get_default_resource()) :
+    slots_(resource), records_(resource), live_(resource), free_(resource)
+  {}
+
+  //! Hash an id
+  static Hash hash(const Key& id) { return detail::hash(id); }
+
+  //! Find the index of a record by id or Npos when it is not contained
+  Index find(const Key& id) const
+  {
+    const Size slot = this->slot(id, hash(id));
+    return slot == NoSlot ? Npos : this->slots_[slot].index;
+  }
+
+  //! Insert a record for an id or find the existing one
+  /*! Returns the index of the record and true if it was inserted */
+  std::pair<Index, bool> insert(const Key& id)
+  {
+    const Hash h = hash(id);
+    const Size slot = this->slot(id, h);
+    if (slot != NoSlot)
+    {
+      return std::make_pair(this->slots_[slot].index, false);
+    }
+    if (2 * (this->size() + 1) > this->slots_.size())
+    {
+      this->rehash(this->slots_.empty() ?
+        MinimumCapacity : 2 * this->slots_.size());
+    }
+    Index index;
+    if (this->free_.empty())
+    {
+      index = static_cast<Index>(this->records_.size());
+      assert(index != Npos);
+      this->records_.emplace_back();
+      this->live_.push_back(true);
+    }
+    else
+    {
+      index = this->free_.back();
+      this->free_.pop_back();
+      this->live_[index] = true;
+    }
+    this->records_[index].id = Id(id);
+    this->place(h, index);
+    return std::make_pair(index, true);
+  }
+
+  //! Erase the record of an id
+  /*! The record is reset to a default constructed record and its index is
+   *  kept for reuse. Returns true if the id was contained in the table.
+   */
+  bool erase(const Key& id)
+  {
+    Size i = this->slot(id, hash(id));
+    if (i == NoSlot)
+    {
+      return false;
+    }
+    const Index index = this->slots_[i].index;
+    /* Backward shift the following slots of the probe sequence instead of
+     * leaving a tombstone so lookups never probe over erased records */
+    const Size mask = this->slots_.size() - 1;
+    for (Size j = (i + 1) & mask; this->slots_[j].index != Npos;
+      j = (j + 1) & mask)
+    {
+      const Size home = this->slots_[j].hash & mask;
+      const bool between = i <= j ?
+        (i < home && home <= j) : (i < home || home <= j);
+      if (!between)
+      {
+        this->slots_[i] = this->slots_[j];
+        i = j;
+      }
+    }
+    this->slots_[i].index = Npos;
+    this->records_[index] = Record();
+    this->live_[index] = false;
+    this->free_.push_back(index);
+    return true;
+  }
+
+  //! Make room for a number of records without further rehashing
+  void reserve(const Size& count)
+  {
+    Size capacity = MinimumCapacity;
+    /* Keep the load factor at or below one half for short probes */
+    while (capacity < 2 * count)
+    {
+      capacity *= 2;
+    }
+    if (count > this->records_.size())
+    {
+      this->records_.reserve(count);
+      this->live_.reserve(count);
+    }
+    if (capacity > this->slots_.size())
+    {
+      this->rehash(capacity);
+    }
+  }
+
+  //! Erase every record
+  /*! The records are destroyed but the capacity of the table is kept */
+  void clear()
+  {
+    for (Slot& slot : this->slots_)
+    {
+      slot.index = Npos;
+    }
+    this->records_.clear();
+    this->live_.clear();
+    this->free_.clear();
+  }
+
+  //! Access a record by index
+  Record& at(const Index& index) { return this->records_[index]; }
+  //! Access a constant record by index
+  const Record& at(const Index& index) const { return this->records_[index]; }
+
+  //! Call a function with every record that has not been erased
+  /*! The records are visited in index order */
+  template<typename F> void for_each(F&& f) const
+  {
+    for (Index i = 0; i < this->records_.size(); i++)
+    {
+      if (this->live_[i])
+      {
+        f(this->records_[i]);
+      }
+    }
+  }
+
+  //! Check if an index refers to a record that has not been erased
+  bool live(const Index& index) const
+  {
+    return index < this->live_.size() && this->live_[index];
+  }
+
+  //! The number of records in the table
+  Size size() const { return this->records_.size() - this->free_.size(); }
+  //! Check if the table is empty
+  bool empty() const { return this->size() == 0; }
+
+private:
+  static const Size MinimumCapacity = 16;
+  static const Size NoSlot = std::numeric_limits<Size>::max();
+
+  struct Slot
+  {
+    Hash hash;
+    Index index;
+  };
+
+  typedef std::pmr::vector<Slot> Slots;
+  typedef std::pmr::vector<Record> Records;
+  typedef std::pmr::vector<bool> Live;
+  typedef std::pmr::vector<Index> Free;
+
+  Size slot(const Key& id, const Hash& hash) const
+  {
+    if (this->slots_.empty())
+    {
+      return NoSlot;
+    }
+    const Size mask = this->slots_.size() - 1;
+    for (Size i = hash & mask;; i = (i + 1) & mask)
+    {
+      const Slot& slot = this->slots_[i];
+      if (slot.index == Npos)
+      {
+        return NoSlot;
+      }
+      if (slot.hash == hash && this->records_[slot.index].id == id)
+      {
+        return i;
+      }
+    }
+  }
+
+  void place(const Hash& hash, const Index& index)
+  {
+    const Size mask = this->slots_.size() - 1;
+    Size i = hash & mask;
+    while (this->slots_[i].index != Npos)
+    {
+      i = (i + 1) & mask;
+    }
+    this->slots_[i].hash = hash;
+    this->slots_[i].index = index;
+  }
+
+  void rehash(const Size& capacity)
+  {
+    Slots slots(capacity, Slot{ 0, Npos }, this->slots_.get_allocator());
+    this->slots_.swap(slots);
+    for (const Slot& slot : slots)
+    {
+      if (slot.index != Npos)
+      {
+        this->place(slot.hash, slot.index);
+      }
+    }
+  }
+
+  Slots slots_;
+  Records records_;
+  Live live_;
+  Free free_;
+};
+
+template<typename R>
+const typename RecordTable<R>::Index RecordTable<R>::Npos;
+template<typename R>
+const typename RecordTable<R>::Size RecordTable<R>::MinimumCapacity;
+template<typename R>
+const typename RecordTable<R>::Size RecordTable<R>::NoSlot;
+
+} /* namespace detail */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_TABLE_H_ */
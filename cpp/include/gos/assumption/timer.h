@@ -0,0 +1,132 @@
+#ifndef _GOS_ASSUMPTION_TIMER_H_
+#define _GOS_ASSUMPTION_TIMER_H_
+
+#include <chrono>
+#include <functional>
+
+#include <boost/asio.hpp>
+
+#include <gos/assumption/wheel.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! A timing wheel driven by one asio steady timer
+/*! The wheel is advanced by the ticks elapsed since the last tick each
+ *  resolution, so thousands of timeouts share one asio timer and one heap
+ *  entry instead of one each. The timers that expire in a tick are fired
+ *  as one batch on the thread running the io context, which is also the
+ *  thread that must arm and cancel them. A timeout fires between its delay
+ *  and its delay plus one resolution after it is armed, or after start if
+ *  it is armed before.
+ */
+template<typename P> class WheelTimer
+{
+public:
+  //! The wheel type
+  typedef TimingWheel<P> Wheel;
+  //! The clock type
+  typedef std::chrono::steady_clock Clock;
+  //! The duration type
+  typedef Clock::duration Duration;
+  //! The handle of an armed timer
+  typedef typename Wheel::Handle Handle;
+  //! The batch of payloads of the timers that expired
+  typedef typename Wheel::Batch Batch;
+  //! The type of the function fired with the batches
+  typedef std::function<void(Batch)> Fire;
+
+  //! A Constructor that takes the tick resolution and the fire function
+  WheelTimer(
+    boost::asio::io_context& context,
+    const Duration& resolution,
+    const Fire& fire,
+    const typename Wheel::Size& reserve = 0) :
+    timer_(context),
+    resolution_(resolution),
+    fire_(fire),
+    wheel_(reserve),
+    running_(false)
+  {}
+
+  //! Arm a timer that expires after a delay
+  Handle arm(const Duration& delay, const P& payload)
+  {
+    /* The wheel counts the ticks from the last tick, not from now, so the
+     * time elapsed since it is added and the sum rounded up so a timeout
+     * never fires before its delay */
+    const Duration elapsed = this->running_ ?
+      Clock::now() - this->last_ : Duration::zero();
+    const typename Wheel::Tick ticks = static_cast<typename Wheel::Tick>(
+      (delay + elapsed + this->resolution_ - Duration(1)) /
+        this->resolution_);
+    return this->wheel_.arm(ticks, payload);
+  }
+  //! Cancel an armed timer
+  bool cancel(const Handle& handle) { return this->wheel_.cancel(handle); }
+  //! Check if a timer is armed
+  bool armed(const Handle& handle) const
+  {
+    return this->wheel_.armed(handle);
+  }
+  //! Access to the wheel
+  const Wheel& wheel() const { return this->wheel_; }
+
+  //! Start ticking on the io context
+  void start()
+  {
+    this->running_ = true;
+    this->last_ = Clock::now();
+    this->timer_.expires_at(this->last_ + this->resolution_);
+    this->wait();
+  }
+  //! Stop ticking, armed timers stay armed
+  void stop()
+  {
+    this->running_ = false;
+    this->timer_.cancel();
+  }
+
+private:
+  void wait()
+  {
+    this->timer_.async_wait([this](const boost::system::error_code& error)
+    {
+      if (error || !this->running_)
+      {
+        return;
+      }
+      this->tick();
+    });
+  }
+
+  void tick()
+  {
+    /* Late ticks catch up with the clock instead of drifting */
+    const Clock::time_point now = Clock::now();
+    const typename Wheel::Tick ticks = static_cast<typename Wheel::Tick>(
+      (now - this->last_) / this->resolution_);
+    this->last_ += ticks * this->resolution_;
+    this->wheel_.advance(ticks, this->fire_);
+    if (!this->running_)
+    {
+      return;
+    }
+    this->timer_.expires_at(this->last_ + this->resolution_);
+    this->wait();
+  }
+
+  boost::asio::steady_timer timer_;
+  Duration resolution_;
+  Fire fire_;
+  Wheel wheel_;
+  Clock::time_point last_;
+  bool running_;
+};
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_TIMER_H_ */
@@ -0,0 +1,423 @@
+#ifndef _GOS_ASSUMPTION_TRACE_H_
+#define _GOS_ASSUMPTION_TRACE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace gos
+{
+namespace assumption
+{
+namespace trace
+{
+
+//! The kind of a trace record
+enum class Kind : std::uint16_t
+{
+  //! A state was entered from another
+  Entry,
+  //! An event had no transition from a state
+  NoTransition
+};
+
+//! A binary trace record
+/*! The stages and the event are codes the writer of the records gives a
+ *  meaning to, like the Stage and EventId of the state engine.
+ */
+struct Record
+{
+  //! The steady clock time in nanoseconds
+  std::uint64_t timestamp;
+  //! The number of the thread that wrote the record
+  std::uint32_t thread;
+  Kind kind;
+  std::uint16_t from;
+  std::uint16_t to;
+  std::uint16_t event;
+};
+
+//! A ring of trace records written by one thread and read by another
+/*! Writing never blocks or allocates, a record that doesn't fit is counted
+ *  as dropped instead.
+ */
+class Ring
+{
+public:
+  //! The size type
+  typedef std::size_t Size;
+
+  //! A Constructor that takes the thread number and a power of 2 capacity
+  Ring(const std::uint32_t& thread, const Size& capacity) :
+    thread_(thread),
+    records_(capacity),
+    mask_(capacity - 1),
+    head_(0),
+    tail_(0),
+    drops_(0)
+  {}
+
+  //! The number of the thread writing to the ring
+  const std::uint32_t& thread() const { return this->thread_; }
+  //! Check if every record written has been read
+  bool empty() const
+  {
+    return this->head_.load(std::memory_order_acquire) ==
+      this->tail_.load(std::memory_order_acquire);
+  }
+  //! The number of records dropped because the ring was full
+  std::uint64_t drops() const
+  {
+    return this->drops_.load(std::memory_order_relaxed);
+  }
+
+  //! Write a record, only called by the thread of the ring
+  bool push(const Record& record)
+  {
+    const std::uint64_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) > this->mask_)
+    {
+      this->drops_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    this->records_[head & this->mask_] = record;
+    this->head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  //! Read the records written so far, only called by one reader at a time
+  template<typename F> Size drain(F&& read)
+  {
+    const std::uint64_t tail = this->tail_.load(std::memory_order_relaxed);
+    const std::uint64_t head = this->head_.load(std::memory_order_acquire);
+    for (std::uint64_t i = tail; i != head; i++)
+    {
+      read(this->records_[i & this->mask_]);
+    }
+    this->tail_.store(head, std::memory_order_release);
+    return static_cast<Size>(head - tail);
+  }
+
+private:
+  std::uint32_t thread_;
+  std::vector<Record> records_;
+  Size mask_;
+  alignas(64) std::atomic<std::uint64_t> head_;
+  alignas(64) std::atomic<std::uint64_t> tail_;
+  std::atomic<std::uint64_t> drops_;
+};
+
+//! The rings of the threads that trace
+/*! A thread gets its ring the first time it records, which is the only
+ *  time it takes the lock besides its exit. The ring of a thread that
+ *  exits is freed and given to the next thread that records once its
+ *  records have been drained, along with its thread number, so a pool of
+ *  short lived threads keeps as many rings as threads alive at once. The
+ *  rings live as long as the tracer.
+ */
+class Tracer
+{
+public:
+  //! The size type
+  typedef Ring::Size Size;
+  //! The number of records of a ring
+  static constexpr Size Capacity = 4096;
+
+  //! The tracer the state engines record to
+  static Tracer& instance()
+  {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  //! The steady clock time in nanoseconds
+  static std::uint64_t now()
+  {
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  //! Record to the ring of the calling thread
+  void record(
+    const Kind& kind,
+    const std::uint16_t& from,
+    const std::uint16_t& to,
+    const std::uint16_t& event)
+  {
+    Ring& ring = this->local();
+    ring.push(Record{ now(), ring.thread(), kind, from, to, event });
+  }
+
+  //! The ring of the calling thread
+  Ring& local()
+  {
+    thread_local Owner owner;
+    if (owner.ring == nullptr)
+    {
+      owner.ring = this->acquire();
+      owner.tracer = this;
+    }
+    return *owner.ring;
+  }
+
+  //! Read the records of every ring, ring by ring
+  /*! Only called by one reader at a time, the records of a ring are in
+   *  the order they were written.
+   */
+  template<typename F> Size drain(F&& read)
+  {
+    std::vector<Ring*> rings;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      for (const std::unique_ptr<Ring>& ring : this->rings_)
+      {
+        rings.push_back(ring.get());
+      }
+    }
+    Size result = 0;
+    for (Ring* ring : rings)
+    {
+      result += ring->drain(read);
+    }
+    return result;
+  }
+
+  //! The number of rings, used and free
+  Size rings()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->rings_.size();
+  }
+
+  //! The number of records dropped by every ring
+  std::uint64_t drops()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    std::uint64_t result = 0;
+    for (const std::unique_ptr<Ring>& ring : this->rings_)
+    {
+      result += ring->drops();
+    }
+    return result;
+  }
+
+private:
+  /* Frees the ring of a thread when the thread exits */
+  struct Owner
+  {
+    Owner() : ring(nullptr), tracer(nullptr) {}
+    ~Owner()
+    {
+      if (this->ring != nullptr)
+      {
+        this->tracer->release(this->ring);
+      }
+    }
+    Ring* ring;
+    Tracer* tracer;
+  };
+
+  Tracer() {}
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  /* The drained free ring freed last or a new one */
+  Ring* acquire()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    for (std::size_t i = this->free_.size(); i-- > 0;)
+    {
+      Ring* ring = this->free_[i];
+      if (ring->empty())
+      {
+        this->free_.erase(this->free_.begin() + i);
+        return ring;
+      }
+    }
+    this->rings_.push_back(std::make_unique<Ring>(
+      static_cast<std::uint32_t>(this->rings_.size()), Capacity));
+    return this->rings_.back().get();
+  }
+  void release(Ring* ring)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->free_.push_back(ring);
+  }
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+  std::vector<Ring*> free_;
+};
+
+//! The export format of trace records
+enum class Format
+{
+  //! One line per record
+  Text,
+  //! The Chrome trace event format read by chrome://tracing and Perfetto
+  ChromeJson
+};
+
+//! The names of the codes of the records
+/*! A null name function writes the codes as numbers */
+struct Names
+{
+  const char* (*stage)(const std::uint16_t&);
+  const char* (*event)(const std::uint16_t&);
+};
+
+//! Writes trace records to a stream in a format
+class Writer
+{
+public:
+  Writer(std::ostream& os, const Format& format, const Names& names) :
+    os_(os), format_(format), names_(names), count_(0)
+  {
+    if (this->format_ == Format::ChromeJson)
+    {
+      this->os_ << "{\"traceEvents\":[";
+    }
+  }
+  ~Writer()
+  {
+    if (this->format_ == Format::ChromeJson)
+    {
+      this->os_ << "]}" << std::endl;
+    }
+  }
+
+  void write(const Record& record)
+  {
+    if (this->format_ == Format::Text)
+    {
+      this->os_ << record.timestamp << " " << record.thread << " "
+        << kind(record.kind) << " ";
+      this->name(this->names_.stage, record.from);
+      this->os_ << " -> ";
+      this->name(this->names_.stage, record.to);
+      this->os_ << " on ";
+      this->name(this->names_.event, record.event);
+      this->os_ << "\n";
+    }
+    else
+    {
+      /* Instant events in microseconds on one process */
+      this->os_ << (this->count_ > 0 ? ",\n" : "\n") << "{\"name\":\"";
+      this->name(this->names_.stage, record.to);
+      this->os_ << "\",\"cat\":\"" << kind(record.kind)
+        << "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":" << record.thread
+        << ",\"ts\":" << record.timestamp / 1000 << ".";
+      const unsigned fraction = static_cast<unsigned>(record.timestamp % 1000);
+      this->os_ << fraction / 100 << fraction / 10 % 10 << fraction % 10
+        << ",\"args\":{\"from\":\"";
+      this->name(this->names_.stage, record.from);
+      this->os_ << "\",\"event\":\"";
+      this->name(this->names_.event, record.event);
+      this->os_ << "\"}}";
+    }
+    this->count_++;
+  }
+  void flush() { this->os_.flush(); }
+
+private:
+  static const char* kind(const Kind& kind)
+  {
+    switch (kind)
+    {
+    case Kind::Entry: return "entry";
+    case Kind::NoTransition: return "no transition";
+    }
+    return "";
+  }
+  void name(const char* (*names)(const std::uint16_t&),
+    const std::uint16_t& code)
+  {
+    if (names != nullptr)
+    {
+      this->os_ << names(code);
+    }
+    else
+    {
+      this->os_ << code;
+    }
+  }
+
+  std::ostream& os_;
+  Format format_;
+  Names names_;
+  std::size_t count_;
+};
+
+//! Drains the tracer in the background and writes the records to a stream
+/*! The stream is only written by the drainer thread until the drainer is
+ *  destroyed, which drains the last records and closes the format.
+ */
+class Drainer
+{
+public:
+  Drainer(
+    Tracer& tracer,
+    std::ostream& os,
+    const Format& format,
+    const Names& names,
+    const std::chrono::milliseconds& interval =
+      std::chrono::milliseconds(100)) :
+    tracer_(tracer),
+    writer_(os, format, names),
+    interval_(interval),
+    stopped_(false),
+    thread_([this]() { this->run(); })
+  {}
+  ~Drainer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->stopped_ = true;
+    }
+    this->condition_.notify_one();
+    this->thread_.join();
+    this->drain();
+  }
+
+private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (!this->stopped_)
+    {
+      this->condition_.wait_for(lock, this->interval_);
+      this->drain();
+    }
+  }
+  void drain()
+  {
+    this->tracer_.drain([this](const Record& record)
+    {
+      this->writer_.write(record);
+    });
+    this->writer_.flush();
+  }
+
+  Tracer& tracer_;
+  Writer writer_;
+  std::chrono::milliseconds interval_;
+  bool stopped_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::thread thread_;
+};
+
+} /* namespace trace */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_TRACE_H_ */
@@ -0,0 +1,319 @@
+#ifndef _GOS_ASSUMPTION_UDP_H_
+#define _GOS_ASSUMPTION_UDP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <type_traits>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+#include <gos/assumption/endian.h>
+#include <gos/assumption/schema.h>
+#include <gos/assumption/span.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace udp
+{
+
+//! The header of a sensor datagram
+/*! A datagram is the big endian header followed by count big endian floats
+ *  for the items from first on. The sequence is incremented by one for
+ *  every datagram a sender sends.
+ */
+struct Header
+{
+  std::uint32_t sequence;
+  std::uint16_t first;
+  std::uint16_t count;
+};
+
+typedef schema::Schema<
+  schema::Field<&Header::sequence, schema::Order::Big, 0>,
+  schema::Field<&Header::first, schema::Order::Big, 4>,
+  schema::Field<&Header::count, schema::Order::Big, 6>> HeaderSchema;
+
+//! The number of bytes of a datagram header
+const std::size_t HeaderBytes = HeaderSchema::Bytes;
+
+//! The largest datagram that is not fragmented on an ethernet network
+const std::size_t DatagramCapacity = 1472;
+
+//! Encode a datagram and return its size or zero if it doesn't fit
+inline std::size_t encode(
+  void* data,
+  const std::size_t& size,
+  const Header& header,
+  const float* values)
+{
+  const std::size_t result = HeaderBytes + header.count * sizeof(float);
+  if (result > size)
+  {
+    return 0;
+  }
+  unsigned char* bytes = static_cast<unsigned char*>(data);
+  HeaderSchema::encode(bytes, header);
+  endian::store_big_endian_array(bytes + HeaderBytes, values, header.count);
+  return result;
+}
+
+//! The counters of a receiver
+struct Counters
+{
+  //! The datagrams received
+  std::uint64_t packets;
+  //! The bytes received
+  std::uint64_t bytes;
+  //! The system calls that returned datagrams
+  std::uint64_t batches;
+  //! The datagrams missing from the sequence
+  std::uint64_t drops;
+  //! The datagrams that were truncated, malformed or out of range
+  std::uint64_t errors;
+};
+
+//! A receiver of sensor datagrams that decodes them into an array of items
+/*! The socket is drained in batches, with one recvmmsg call per batch on
+ *  Linux and one receive per datagram elsewhere. The floats are decoded
+ *  straight into the items, which are floats or anything assignable from
+ *  a float like Wrapper<float>. The items are typically the array of an
+ *  ArrayHolder or the values of an id of an Assumption and must outlive
+ *  the receiver. The receiver is not thread safe, it is polled or run
+ *  from one thread of the io context.
+ */
+template<typename I> class Receiver
+{
+public:
+  //! The item type
+  typedef I Item;
+  //! The items the datagrams are decoded into
+  typedef Span<I> Items;
+  //! The size type
+  typedef std::size_t Size;
+  //! The endpoint type
+  typedef boost::asio::ip::udp::endpoint Endpoint;
+
+  //! A Constructor that binds a socket to an endpoint
+  /*! Batch is the most datagrams received by one system call and capacity
+   *  the largest datagram accepted, larger ones count as errors.
+   */
+  Receiver(
+    boost::asio::io_context& context,
+    const Endpoint& endpoint,
+    const Items& items,
+    const Size& batch = 64,
+    const Size& capacity = DatagramCapacity) :
+    socket_(context, endpoint),
+    items_(items),
+    batch_(batch > 0 ? batch : 1),
+    capacity_(capacity),
+    buffer_(batch_ * capacity_),
+    sizes_(batch_),
+    counters_(),
+    expected_(0),
+    sequenced_(false),
+    running_(false)
+  {
+    this->socket_.non_blocking(true);
+#if defined(__linux__)
+    this->messages_.resize(this->batch_);
+    this->vectors_.resize(this->batch_);
+    for (Size i = 0; i < this->batch_; i++)
+    {
+      this->vectors_[i].iov_base = this->buffer_.data() + i * this->capacity_;
+      this->vectors_[i].iov_len = this->capacity_;
+      this->messages_[i].msg_hdr.msg_iov = &this->vectors_[i];
+      this->messages_[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+  }
+
+  //! The endpoint the socket is bound to
+  Endpoint endpoint() const { return this->socket_.local_endpoint(); }
+  //! Access to the socket to set options
+  boost::asio::ip::udp::socket& socket() { return this->socket_; }
+  //! The counters
+  const Counters& counters() const { return this->counters_; }
+
+  //! Receive and decode the datagrams that are waiting on the socket
+  /*! Returns the number of datagrams received */
+  Size poll()
+  {
+    Size result = 0;
+    for (;;)
+    {
+      const Size received = this->receive();
+      result += received;
+      if (received < this->batch_)
+      {
+        return result;
+      }
+    }
+  }
+
+  //! Start receiving datagrams asynchronously on the io context
+  void start()
+  {
+    this->running_ = true;
+    this->wait();
+  }
+
+  //! Stop receiving datagrams asynchronously
+  void stop()
+  {
+    this->running_ = false;
+    boost::system::error_code error;
+    this->socket_.cancel(error);
+  }
+
+private:
+  void wait()
+  {
+    this->socket_.async_wait(
+      boost::asio::ip::udp::socket::wait_read,
+      [this](const boost::system::error_code& error)
+      {
+        if (error || !this->running_)
+        {
+          return;
+        }
+        this->poll();
+        this->wait();
+      });
+  }
+
+  //! Receive one batch and return the number of datagrams
+  Size receive()
+  {
+    Size count = 0;
+#if defined(__linux__)
+    for (Size i = 0; i < this->batch_; i++)
+    {
+      this->messages_[i].msg_hdr.msg_flags = 0;
+    }
+    const int received = ::recvmmsg(
+      this->socket_.native_handle(),
+      this->messages_.data(),
+      static_cast<unsigned int>(this->batch_),
+      MSG_DONTWAIT,
+      nullptr);
+    if (received <= 0)
+    {
+      return 0;
+    }
+    count = static_cast<Size>(received);
+    for (Size i = 0; i < count; i++)
+    {
+      this->sizes_[i] = (this->messages_[i].msg_hdr.msg_flags & MSG_TRUNC) ?
+        this->capacity_ + 1 : this->messages_[i].msg_len;
+    }
+#else
+    for (; count < this->batch_; count++)
+    {
+      boost::system::error_code error;
+      const Size size = this->socket_.receive(boost::asio::buffer(
+        this->buffer_.data() + count * this->capacity_, this->capacity_),
+        0, error);
+      if (error == boost::asio::error::message_size)
+      {
+        this->sizes_[count] = this->capacity_ + 1;
+      }
+      else if (error)
+      {
+        break;
+      }
+      else
+      {
+        this->sizes_[count] = size;
+      }
+    }
+    if (count == 0)
+    {
+      return 0;
+    }
+#endif
+    this->counters_.batches++;
+    for (Size i = 0; i < count; i++)
+    {
+      this->decode(
+        this->buffer_.data() + i * this->capacity_, this->sizes_[i]);
+    }
+    return count;
+  }
+
+  void decode(const unsigned char* bytes, const Size& size)
+  {
+    this->counters_.packets++;
+    this->counters_.bytes += size;
+    Header header;
+    if (size > this->capacity_ || size < HeaderBytes)
+    {
+      this->counters_.errors++;
+      return;
+    }
+    HeaderSchema::decode(bytes, header);
+    /* A datagram that arrived isn't dropped even if it's malformed. A gap
+     * in the sequence is counted as dropped, a late datagram is still
+     * decoded since it's the only copy of its values */
+    if (this->sequenced_ &&
+      static_cast<std::int32_t>(header.sequence - this->expected_) > 0)
+    {
+      this->counters_.drops += header.sequence - this->expected_;
+    }
+    if (!this->sequenced_ ||
+      static_cast<std::int32_t>(header.sequence - this->expected_) >= 0)
+    {
+      this->expected_ = header.sequence + 1;
+      this->sequenced_ = true;
+    }
+    if (size != HeaderBytes + header.count * sizeof(float) ||
+      static_cast<Size>(header.first) + header.count > this->items_.size())
+    {
+      this->counters_.errors++;
+      return;
+    }
+    const unsigned char* values = bytes + HeaderBytes;
+    I* items = this->items_.data() + header.first;
+    if constexpr (std::is_same<I, float>::value)
+    {
+      endian::load_big_endian_array(values, items, header.count);
+    }
+    else
+    {
+      for (Size i = 0; i < header.count; i++)
+      {
+        items[i] = endian::load_big_endian<float>(values + i * sizeof(float));
+      }
+    }
+  }
+
+  boost::asio::ip::udp::socket socket_;
+  Items items_;
+  Size batch_;
+  Size capacity_;
+  std::vector<unsigned char> buffer_;
+  std::vector<Size> sizes_;
+#if defined(__linux__)
+  std::vector<::mmsghdr> messages_;
+  std::vector<::iovec> vectors_;
+#endif
+  Counters counters_;
+  std::uint32_t expected_;
+  bool sequenced_;
+  bool running_;
+};
+
+} /* namespace udp */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_UDP_H_ */
@@ -0,0 +1,352 @@
+#ifndef _GOS_ASSUMPTION_VIEW_H_
+#define _GOS_ASSUMPTION_VIEW_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <gos/assumption/endian.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace endian
+{
+
+//! The byte order of the values in a buffer
+enum class Order
+{
+  Little,
+  Big
+};
+
+namespace detail
+{
+
+//! Decode a value stored in an order at an unaligned position
+template<typename T, Order O> T decode(const unsigned char* pointer)
+{
+  typedef typename Unsigned<sizeof(T)>::Type U;
+  U bits;
+  std::memcpy(&bits, pointer, sizeof(U));
+  if constexpr (sizeof(U) > 1)
+  {
+    if ((O == Order::Little) != NativeLittle)
+    {
+      bits = reverse(bits);
+    }
+  }
+  T value;
+  std::memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+//! Encode a value in an order at an unaligned position
+template<typename T, Order O> void encode(
+  unsigned char* pointer, const T& value)
+{
+  typedef typename Unsigned<sizeof(T)>::Type U;
+  U bits;
+  std::memcpy(&bits, &value, sizeof(T));
+  if constexpr (sizeof(U) > 1)
+  {
+    if ((O == Order::Little) != NativeLittle)
+    {
+      bits = reverse(bits);
+    }
+  }
+  std::memcpy(pointer, &bits, sizeof(U));
+}
+
+} /* namespace detail */
+
+//! A read only view of values of type T stored in a byte order
+/*! The view refers to the bytes of a buffer without copying them and
+ *  decodes a value only when it is accessed, so reading a few fields of a
+ *  large frame costs a few loads. The buffer may be unaligned and must
+ *  outlive the view. A buffer is anything with data and size members, like
+ *  boost::asio::const_buffer and boost::asio::mutable_buffer. Trailing bytes
+ *  that don't make up a whole value are not part of the view.
+ */
+template<typename T, Order O> class View
+{
+public:
+  static_assert(std::is_arithmetic<T>::value,
+    "Only integers and floating point values have a byte order");
+
+  //! The value type
+  typedef T Value;
+  //! The size type
+  typedef std::size_t Size;
+
+  //! A random access iterator decoding the value it points at
+  class Iterator
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef T reference;
+
+    Iterator() : pointer_(nullptr) {}
+    T operator*() const { return detail::decode<T, O>(this->pointer_); }
+    T operator[](const difference_type& n) const
+    {
+      return detail::decode<T, O>(this->pointer_ + n * sizeof(T));
+    }
+    Iterator& operator++() { this->pointer_ += sizeof(T); return *this; }
+    Iterator operator++(int)
+    {
+      Iterator previous = *this;
+      this->pointer_ += sizeof(T);
+      return previous;
+    }
+    Iterator& operator--() { this->pointer_ -= sizeof(T); return *this; }
+    Iterator operator--(int)
+    {
+      Iterator previous = *this;
+      this->pointer_ -= sizeof(T);
+      return previous;
+    }
+    Iterator& operator+=(const difference_type& n)
+    {
+      this->pointer_ += n * sizeof(T);
+      return *this;
+    }
+    Iterator& operator-=(const difference_type& n)
+    {
+      this->pointer_ -= n * sizeof(T);
+      return *this;
+    }
+    friend Iterator operator+(Iterator i, const difference_type& n)
+    {
+      return i += n;
+    }
+    friend Iterator operator+(const difference_type& n, Iterator i)
+    {
+      return i += n;
+    }
+    friend Iterator operator-(Iterator i, const difference_type& n)
+    {
+      return i -= n;
+    }
+    friend difference_type operator-(const Iterator& a, const Iterator& b)
+    {
+      return (a.pointer_ - b.pointer_) /
+        static_cast<difference_type>(sizeof(T));
+    }
+    friend bool operator==(const Iterator& a, const Iterator& b)
+    {
+      return a.pointer_ == b.pointer_;
+    }
+    friend bool operator!=(const Iterator& a, const Iterator& b)
+    {
+      return a.pointer_ != b.pointer_;
+    }
+    friend bool operator<(const Iterator& a, const Iterator& b)
+    {
+      return a.pointer_ < b.pointer_;
+    }
+    friend bool operator>(const Iterator& a, const Iterator& b)
+    {
+      return a.pointer_ > b.pointer_;
+    }
+    friend bool operator<=(const Iterator& a, const Iterator& b)
+    {
+      return a.pointer_ <= b.pointer_;
+    }
+    friend bool operator>=(const Iterator& a, const Iterator& b)
+    {
+      return a.pointer_ >= b.pointer_;
+    }
+  private:
+    friend class View;
+    Iterator(const unsigned char* pointer) : pointer_(pointer) {}
+    const unsigned char* pointer_;
+  };
+
+  View() : data_(nullptr), size_(0) {}
+  //! A Constructor that takes a pointer to the bytes and a number of values
+  View(const void* data, const Size& size) :
+    data_(static_cast<const unsigned char*>(data)), size_(size)
+  {}
+  //! A Constructor that takes a buffer
+  template<typename B> explicit View(const B& buffer) :
+    data_(static_cast<const unsigned char*>(buffer.data())),
+    size_(buffer.size() / sizeof(T))
+  {}
+
+  //! Decode the value at an index
+  T operator[](const Size& index) const
+  {
+    assert(index < this->size_);
+    return detail::decode<T, O>(this->data_ + index * sizeof(T));
+  }
+  //! Decode the value at an index or throw std::out_of_range
+  T at(const Size& index) const
+  {
+    if (index >= this->size_)
+    {
+      throw std::out_of_range("The index is outside of the view");
+    }
+    return (*this)[index];
+  }
+  //! The number of values in the view
+  Size size() const { return this->size_; }
+  //! Check if the view is empty
+  bool empty() const { return this->size_ == 0; }
+  //! Access to the bytes of the view
+  const void* data() const { return this->data_; }
+  Iterator begin() const { return Iterator(this->data_); }
+  Iterator end() const
+  {
+    return Iterator(this->data_ + this->size_ * sizeof(T));
+  }
+  //! A view of a part of this view
+  View subview(const Size& offset, const Size& count) const
+  {
+    assert(offset + count <= this->size_);
+    return View(this->data_ + offset * sizeof(T), count);
+  }
+  //! Decode a range of values into an array with the bulk kernels
+  void copy(T* values, const Size& offset, const Size& count) const
+  {
+    assert(offset + count <= this->size_);
+    const unsigned char* source = this->data_ + offset * sizeof(T);
+    if (O == Order::Big)
+    {
+      load_big_endian_array(source, values, count);
+    }
+    else
+    {
+      load_little_endian_array(source, values, count);
+    }
+  }
+
+private:
+  const unsigned char* data_;
+  Size size_;
+};
+
+//! A view of values of type T stored in a byte order that can be written
+/*! Values are encoded into the buffer when they are assigned. The buffer
+ *  must be writable, like boost::asio::mutable_buffer.
+ */
+template<typename T, Order O> class MutableView
+{
+public:
+  //! The value type
+  typedef T Value;
+  //! The size type
+  typedef std::size_t Size;
+
+  //! A reference to a value in the buffer
+  class Reference
+  {
+  public:
+    operator T() const { return detail::decode<T, O>(this->pointer_); }
+    Reference& operator=(const T& value)
+    {
+      detail::encode<T, O>(this->pointer_, value);
+      return *this;
+    }
+    Reference& operator=(const Reference& reference)
+    {
+      return *this = static_cast<T>(reference);
+    }
+  private:
+    friend class MutableView;
+    Reference(unsigned char* pointer) : pointer_(pointer) {}
+    unsigned char* pointer_;
+  };
+
+  MutableView() : data_(nullptr), size_(0) {}
+  //! A Constructor that takes a pointer to the bytes and a number of values
+  MutableView(void* data, const Size& size) :
+    data_(static_cast<unsigned char*>(data)), size_(size)
+  {}
+  //! A Constructor that takes a writable buffer
+  template<typename B> explicit MutableView(const B& buffer) :
+    data_(static_cast<unsigned char*>(buffer.data())),
+    size_(buffer.size() / sizeof(T))
+  {}
+
+  //! A reference to the value at an index
+  Reference operator[](const Size& index) const
+  {
+    assert(index < this->size_);
+    return Reference(this->data_ + index * sizeof(T));
+  }
+  //! Decode the value at an index
+  T get(const Size& index) const { return (*this)[index]; }
+  //! Encode a value at an index
+  void set(const Size& index, const T& value) const
+  {
+    (*this)[index] = value;
+  }
+  //! The number of values in the view
+  Size size() const { return this->size_; }
+  //! Check if the view is empty
+  bool empty() const { return this->size_ == 0; }
+  //! Access to the bytes of the view
+  void* data() const { return this->data_; }
+  //! A read only view of the same values
+  View<T, O> view() const { return View<T, O>(this->data_, this->size_); }
+  //! Encode an array of values into a range with the bulk kernels
+  void assign(const T* values, const Size& offset, const Size& count) const
+  {
+    assert(offset + count <= this->size_);
+    unsigned char* destination = this->data_ + offset * sizeof(T);
+    if (O == Order::Big)
+    {
+      store_big_endian_array(destination, values, count);
+    }
+    else
+    {
+      store_little_endian_array(destination, values, count);
+    }
+  }
+
+private:
+  unsigned char* data_;
+  Size size_;
+};
+
+//! A view of the big endian values in a buffer
+template<typename T, typename B> View<T, Order::Big> big_view(const B& buffer)
+{
+  return View<T, Order::Big>(buffer);
+}
+
+//! A view of the little endian values in a buffer
+template<typename T, typename B>
+View<T, Order::Little> little_view(const B& buffer)
+{
+  return View<T, Order::Little>(buffer);
+}
+
+//! A writable view of the big endian values in a buffer
+template<typename T, typename B>
+MutableView<T, Order::Big> big_mutable_view(const B& buffer)
+{
+  return MutableView<T, Order::Big>(buffer);
+}
+
+//! A writable view of the little endian values in a buffer
+template<typename T, typename B>
+MutableView<T, Order::Little> little_mutable_view(const B& buffer)
+{
+  return MutableView<T, Order::Little>(buffer);
+}
+
+} /* namespace endian */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_VIEW_H_ */
@@ -0,0 +1,287 @@
+#ifndef _GOS_ASSUMPTION_WHEEL_H_
+#define _GOS_ASSUMPTION_WHEEL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <vector>
+
+#include <gos/assumption/span.h>
+
+namespace gos
+{
+namespace assumption
+{
+
+//! A hierarchical timing wheel of payloads that expire after some ticks
+/*! The wheel has Levels levels of Slots slots each. A timer is kept in a
+ *  doubly linked list of the slot of the level that covers its delay and
+ *  moves down a level each time the level above turns, so arming and
+ *  cancelling a timer are constant time and advancing costs one slot visit
+ *  per tick plus the timers that expire or move. The timers are kept in a
+ *  pool that is reused, there are no allocations once the pool has grown
+ *  to the most timers armed at once. Delays beyond the range of the wheel
+ *  are parked in the top level until they are in range.
+ *  The wheel is not thread safe, it is advanced from the thread of the
+ *  tick that drives it.
+ */
+template<typename P> class TimingWheel
+{
+public:
+  //! The payload type
+  typedef P Payload;
+  //! The tick type
+  typedef std::uint64_t Tick;
+  //! The handle of an armed timer
+  typedef std::uint64_t Handle;
+  //! The size type
+  typedef std::size_t Size;
+  //! The payloads of the timers that expired in one advance
+  typedef Span<P> Batch;
+
+  //! The handle that never refers to an armed timer
+  static const Handle NoHandle = std::numeric_limits<Handle>::max();
+  //! The number of bits of a slot index
+  static const unsigned Bits = 8;
+  //! The number of slots of a level
+  static const Size Slots = Size(1) << Bits;
+  //! The number of levels
+  static const Size Levels = 4;
+
+  //! A Constructor that takes the number of timers to reserve
+  TimingWheel(const Size& reserve = 0) : now_(0), armed_(0), free_(Npos)
+  {
+    for (Index& head : this->heads_)
+    {
+      head = Npos;
+    }
+    this->nodes_.reserve(reserve);
+  }
+
+  //! Arm a timer that expires delay ticks from now
+  /*! A delay of zero expires on the next tick like a delay of one */
+  Handle arm(const Tick& delay, const P& payload)
+  {
+    Index index = this->free_;
+    if (index == Npos)
+    {
+      index = static_cast<Index>(this->nodes_.size());
+      this->nodes_.push_back(Node());
+    }
+    else
+    {
+      this->free_ = this->nodes_[index].next;
+    }
+    Node& node = this->nodes_[index];
+    node.payload = payload;
+    node.when = this->now_ + (delay > 0 ? delay : 1);
+    this->link(index);
+    this->armed_++;
+    return (static_cast<Handle>(node.generation) << 32) | index;
+  }
+
+  //! Cancel an armed timer
+  /*! Returns false if the timer already expired or was cancelled */
+  bool cancel(const Handle& handle)
+  {
+    if (!this->armed(handle))
+    {
+      return false;
+    }
+    const Index index = static_cast<Index>(handle & 0xffffffffu);
+    this->unlink(index);
+    this->release(index);
+    return true;
+  }
+
+  //! Check if a timer is armed
+  bool armed(const Handle& handle) const
+  {
+    const Index index = static_cast<Index>(handle & 0xffffffffu);
+    const std::uint32_t generation = static_cast<std::uint32_t>(handle >> 32);
+    if (handle == NoHandle || index >= this->nodes_.size())
+    {
+      return false;
+    }
+    const Node& node = this->nodes_[index];
+    return node.slot != Npos && node.generation == generation;
+  }
+
+  //! Advance the wheel and fire the timers that expire as one batch
+  /*! Fire is called once with a Batch of the payloads in the order they
+   *  expired if any did, the timers are released before so fire may arm
+   *  and cancel timers but not advance the wheel. Returns the number of
+   *  timers that expired.
+   */
+  template<typename F> Size advance(const Tick& ticks, F&& fire)
+  {
+    this->batch_.clear();
+    for (Tick i = 0; i < ticks; i++)
+    {
+      if (this->armed_ == 0)
+      {
+        this->now_ += ticks - i;
+        break;
+      }
+      this->tick();
+    }
+    const Size result = this->batch_.size();
+    if (result > 0)
+    {
+      fire(Batch(this->batch_.data(), result));
+    }
+    return result;
+  }
+
+  //! The ticks the wheel was advanced
+  const Tick& now() const { return this->now_; }
+  //! The number of armed timers
+  Size size() const { return this->armed_; }
+  //! Check if no timer is armed
+  bool empty() const { return this->armed_ == 0; }
+
+private:
+  typedef std::uint32_t Index;
+  static const Index Npos = std::numeric_limits<Index>::max();
+  static const Size Mask = Slots - 1;
+
+  struct Node
+  {
+    Node() :
+      payload(), when(0), next(Npos), previous(Npos), slot(Npos),
+      generation(0)
+    {}
+    P payload;
+    Tick when;
+    Index next;
+    Index previous;
+    Index slot;
+    /* Odd while the timer is armed so stale handles never match */
+    std::uint32_t generation;
+  };
+
+  //! The slot of a timer relative to the current tick
+  Index place(const Tick& when) const
+  {
+    const Tick delta = when > this->now_ ? when - this->now_ : 0;
+    for (Size level = 0; level < Levels; level++)
+    {
+      if (delta < (Tick(1) << (Bits * (level + 1))))
+      {
+        return static_cast<Index>(
+          level * Slots + ((when >> (Bits * level)) & Mask));
+      }
+    }
+    /* Out of range, the timer is placed again when this slot turns */
+    const Size top = Levels - 1;
+    return static_cast<Index>(
+      top * Slots + (((this->now_ >> (Bits * top)) - 1) & Mask));
+  }
+
+  void link(const Index& index)
+  {
+    Node& node = this->nodes_[index];
+    if (node.generation % 2 == 0)
+    {
+      node.generation++;
+    }
+    node.slot = this->place(node.when);
+    node.previous = Npos;
+    node.next = this->heads_[node.slot];
+    if (node.next != Npos)
+    {
+      this->nodes_[node.next].previous = index;
+    }
+    this->heads_[node.slot] = index;
+  }
+
+  void unlink(const Index& index)
+  {
+    Node& node = this->nodes_[index];
+    if (node.previous != Npos)
+    {
+      this->nodes_[node.previous].next = node.next;
+    }
+    else
+    {
+      this->heads_[node.slot] = node.next;
+    }
+    if (node.next != Npos)
+    {
+      this->nodes_[node.next].previous = node.previous;
+    }
+  }
+
+  void release(const Index& index)
+  {
+    Node& node = this->nodes_[index];
+    node.slot = Npos;
+    node.generation++;
+    node.payload = P();
+    node.next = this->free_;
+    this->free_ = index;
+    this->armed_--;
+  }
+
+  void tick()
+  {
+    this->now_++;
+    /* The higher levels turn first so timers moving down more than one
+     * level on the same tick are moved again */
+    for (Size level = Levels - 1; level > 0; level--)
+    {
+      if ((this->now_ & ((Tick(1) << (Bits * level)) - 1)) == 0)
+      {
+        this->cascade(static_cast<Index>(
+          level * Slots + ((this->now_ >> (Bits * level)) & Mask)));
+      }
+    }
+    const Index slot = static_cast<Index>(this->now_ & Mask);
+    Index index = this->heads_[slot];
+    this->heads_[slot] = Npos;
+    while (index != Npos)
+    {
+      const Index next = this->nodes_[index].next;
+      this->batch_.push_back(this->nodes_[index].payload);
+      this->release(index);
+      index = next;
+    }
+  }
+
+  void cascade(const Index& slot)
+  {
+    Index index = this->heads_[slot];
+    this->heads_[slot] = Npos;
+    while (index != Npos)
+    {
+      const Index next = this->nodes_[index].next;
+      this->link(index);
+      index = next;
+    }
+  }
+
+  Tick now_;
+  Size armed_;
+  Index free_;
+  Index heads_[Levels * Slots];
+  std::vector<Node> nodes_;
+  std::vector<P> batch_;
+};
+
+template<typename P> const typename TimingWheel<P>::Handle
+  TimingWheel<P>::NoHandle;
+template<typename P> const unsigned TimingWheel<P>::Bits;
+template<typename P> const typename TimingWheel<P>::Size
+  TimingWheel<P>::Slots;
+template<typename P> const typename TimingWheel<P>::Size
+  TimingWheel<P>::Levels;
+template<typename P> const typename TimingWheel<P>::Index
+  TimingWheel<P>::Npos;
+template<typename P> const typename TimingWheel<P>::Size
+  TimingWheel<P>::Mask;
+
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_WHEEL_H_ */
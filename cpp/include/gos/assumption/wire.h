@@ -0,0 +1,300 @@
+#ifndef _GOS_ASSUMPTION_WIRE_H_
+#define _GOS_ASSUMPTION_WIRE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gos/assumption.h>
+#include <gos/assumption/endian.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace wire
+{
+
+/* The binary encoding of the Group and Item objects exchanged with the Java
+ * side, gos.assumption.BinarySerialization encodes the same bytes. A message
+ * is one group, all the numbers are little endian:
+ *   u32  the size of the rest of the message
+ *   u8   the type, the ordinal of the Java enum, 0 for A and 1 for B
+ *   str  the id of the group
+ *   str  the name of the item
+ *   str  the value of the item of an A group
+ *   i32  the value of the item of a B group
+ * A str is a u32 length and as many UTF-8 bytes, a null string has the
+ * length 0xffffffff. A group without an item ends after its id. The null
+ * strings and the missing item are kept by the flags of the Group and Item
+ * objects so a message decoded and encoded again has the same bytes. */
+
+//! The type of a group
+enum class Type : std::uint8_t
+{
+  A = 0,
+  B = 1
+};
+
+//! The item of a group
+/*! An item of an A group has a text value, an item of a B group a number */
+struct Item
+{
+  StringHolder name;
+  StringHolder text;
+  std::int32_t number = 0;
+  //! Check if the name is a null string, its holder is empty then
+  bool null_name = false;
+  //! Check if the text is a null string, its holder is empty then
+  bool null_text = false;
+};
+
+//! A group and its item
+struct Group
+{
+  Type type = Type::A;
+  StringHolder id;
+  Item item;
+  //! Check if the id is a null string, its holder is empty then
+  bool null_id = false;
+  //! Check if the group has an item, the item is empty if it has not
+  bool has_item = true;
+};
+
+//! The length of a null string
+inline constexpr std::uint32_t Null = 0xffffffff;
+//! The bytes of the size of a message
+inline constexpr std::size_t SizeBytes = sizeof(std::uint32_t);
+
+//! The number of bytes of the message of a group
+inline std::size_t size(const Group& group)
+{
+  const std::size_t id = group.null_id ? 0 : group.id.view().size();
+  const std::size_t result = SizeBytes + 1 + sizeof(std::uint32_t) + id;
+  if (!group.has_item)
+  {
+    return result;
+  }
+  const std::size_t name =
+    group.item.null_name ? 0 : group.item.name.view().size();
+  if (group.type == Type::A)
+  {
+    const std::size_t text =
+      group.item.null_text ? 0 : group.item.text.view().size();
+    return result + 2 * sizeof(std::uint32_t) + name + text;
+  }
+  return result + sizeof(std::uint32_t) + name + sizeof(std::int32_t);
+}
+
+namespace detail
+{
+
+//! Write a string or a null string
+inline unsigned char* put(
+  unsigned char* bytes,
+  const std::string_view& text,
+  const bool& null)
+{
+  if (null)
+  {
+    endian::store_little_endian(bytes, Null);
+    return bytes + sizeof(std::uint32_t);
+  }
+  endian::store_little_endian(bytes, static_cast<std::uint32_t>(text.size()));
+  std::memcpy(bytes + sizeof(std::uint32_t), text.data(), text.size());
+  return bytes + sizeof(std::uint32_t) + text.size();
+}
+
+//! Read a string, a null string is read as empty and flagged
+/*! Returns a null pointer if the string runs past the end */
+inline const unsigned char* get(
+  const unsigned char* bytes,
+  const unsigned char* end,
+  StringHolder& holder,
+  bool& null)
+{
+  if (end - bytes < static_cast<std::ptrdiff_t>(sizeof(std::uint32_t)))
+  {
+    return nullptr;
+  }
+  const std::uint32_t length =
+    endian::load_little_endian<std::uint32_t>(bytes);
+  bytes += sizeof(std::uint32_t);
+  null = length == Null;
+  if (null)
+  {
+    holder.assign(std::string_view());
+    return bytes;
+  }
+  if (static_cast<std::size_t>(end - bytes) < length)
+  {
+    return nullptr;
+  }
+  holder.assign(
+    std::string_view(reinterpret_cast<const char*>(bytes), length));
+  return bytes + length;
+}
+
+} /* namespace detail */
+
+//! Encode the message of a group
+/*! Returns the size of the message or zero if it doesn't fit */
+inline std::size_t encode(
+  void* data,
+  const std::size_t& size,
+  const Group& group)
+{
+  const std::size_t result = wire::size(group);
+  if (result > size)
+  {
+    return 0;
+  }
+  unsigned char* bytes = static_cast<unsigned char*>(data);
+  endian::store_little_endian(
+    bytes, static_cast<std::uint32_t>(result - SizeBytes));
+  bytes[SizeBytes] = static_cast<unsigned char>(group.type);
+  bytes = detail::put(
+    bytes + SizeBytes + 1, group.id.view(), group.null_id);
+  if (!group.has_item)
+  {
+    return result;
+  }
+  bytes = detail::put(bytes, group.item.name.view(), group.item.null_name);
+  if (group.type == Type::A)
+  {
+    detail::put(bytes, group.item.text.view(), group.item.null_text);
+  }
+  else
+  {
+    endian::store_little_endian(bytes, group.item.number);
+  }
+  return result;
+}
+
+//! Append the message of a group to a buffer
+inline void encode(std::vector<unsigned char>& buffer, const Group& group)
+{
+  const std::size_t offset = buffer.size();
+  buffer.resize(offset + wire::size(group));
+  encode(buffer.data() + offset, buffer.size() - offset, group);
+}
+
+//! Decode the message of a group at the start of a buffer
+/*! Returns the size of the message or zero if the buffer holds no complete
+ *  message or the message is malformed.
+ */
+inline std::size_t decode(
+  const void* data,
+  const std::size_t& size,
+  Group& group)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  if (size < SizeBytes + 1)
+  {
+    return 0;
+  }
+  const std::size_t result = SizeBytes +
+    endian::load_little_endian<std::uint32_t>(bytes);
+  if (result > size || result < SizeBytes + 1 ||
+    bytes[SizeBytes] > static_cast<unsigned char>(Type::B))
+  {
+    return 0;
+  }
+  const unsigned char* end = bytes + result;
+  group.type = static_cast<Type>(bytes[SizeBytes]);
+  bytes = detail::get(bytes + SizeBytes + 1, end, group.id, group.null_id);
+  group.has_item = bytes != end;
+  if (!group.has_item)
+  {
+    group.item = Item();
+    return result;
+  }
+  if (bytes == nullptr || (bytes = detail::get(
+    bytes, end, group.item.name, group.item.null_name)) == nullptr)
+  {
+    return 0;
+  }
+  if (group.type == Type::A)
+  {
+    bytes = detail::get(bytes, end, group.item.text, group.item.null_text);
+    group.item.number = 0;
+  }
+  else if (end - bytes >= static_cast<std::ptrdiff_t>(sizeof(std::int32_t)))
+  {
+    group.item.text.assign(std::string_view());
+    group.item.null_text = false;
+    group.item.number = endian::load_little_endian<std::int32_t>(bytes);
+    bytes += sizeof(std::int32_t);
+  }
+  else
+  {
+    bytes = nullptr;
+  }
+  return bytes == end ? result : 0;
+}
+
+//! Decode the messages of a buffer into an Assumption
+/*! Every group id gets one value. The value of a B group is the number of
+ *  its item and its wrapper is set to it, the value of an A group is text
+ *  so it is zero and its wrapper unset, like the value of a group without
+ *  an item. The value and the wrapper of an id that is already contained
+ *  with one value are written in place, the other ids are created in bulk,
+ *  so loading the same ids again allocates nothing. Returns the size of the
+ *  messages decoded, which is less than the size of the buffer if the last
+ *  message is incomplete or a message is malformed.
+ */
+template<typename T, typename W, typename H>
+std::size_t load(
+  const void* data,
+  const std::size_t& size,
+  Assumption<T, W, H>& assumption)
+{
+  typedef Assumption<T, W, H> Target;
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  typename Target::Batch batch;
+  std::vector<std::pair<bool, T>> values;
+  std::size_t result = 0;
+  Group group;
+  for (std::size_t used;
+    (used = decode(bytes + result, size - result, group)) > 0;
+    result += used)
+  {
+    const bool set = group.type == Type::B && group.has_item;
+    const T value = set ? static_cast<T>(group.item.number) : T();
+    const typename Target::Handle handle =
+      assumption.resolve(group.id.view());
+    if (handle != Target::NoHandle && assumption.array_size(handle) == 1)
+    {
+      assumption.value(handle, 0) = value;
+      assumption.wrapper(handle, 0) = set ? W(value) : W();
+      continue;
+    }
+    batch.emplace_back(group.id.view(), 1);
+    values.emplace_back(set, value);
+  }
+  if (batch.empty())
+  {
+    return result;
+  }
+  assumption.create_many(batch);
+  for (std::size_t i = 0; i < batch.size(); i++)
+  {
+    /* A later group of the same id overwrites an earlier one */
+    const typename Target::Handle handle = assumption.resolve(batch[i].first);
+    assumption.value(handle, 0) = values[i].second;
+    assumption.wrapper(handle, 0) =
+      values[i].first ? W(values[i].second) : W();
+  }
+  return result;
+}
+
+} /* namespace wire */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_WIRE_H_ */
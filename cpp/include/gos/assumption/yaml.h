@@ -0,0 +1,774 @@
+#ifndef _GOS_ASSUMPTION_YAML_H_
+#define _GOS_ASSUMPTION_YAML_H_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+
+#include <istream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <gos/assumption/table.h>
+#include <gos/assumption/wire.h>
+
+namespace gos
+{
+namespace assumption
+{
+namespace yaml
+{
+
+//! The item names a reader has seen, each kept once
+class Names
+{
+public:
+  //! The symbol of a name, the index of the name in the table
+  typedef unsigned int Symbol;
+
+  //! The symbol of no name
+  static constexpr Symbol NoSymbol = std::numeric_limits<Symbol>::max();
+
+  //! The symbol of a name, added the first time the name is seen
+  Symbol intern(const std::string_view& name)
+  {
+    return this->table_.insert(name).first;
+  }
+  //! The name of a symbol
+  const std::string& name(const Symbol& symbol) const
+  {
+    return this->table_.at(symbol).id;
+  }
+  //! The number of names
+  std::size_t size() const { return this->table_.size(); }
+
+private:
+  struct Record
+  {
+    std::string id;
+  };
+
+  detail::RecordTable<Record> table_;
+};
+
+//! A streaming reader of the Group documents of gos.assumption.Serialization
+/*! The input is fed in chunks of any size and read a line at a time, only
+ *  the last partial line and the current logical line are kept. The keys
+ *  of a document fill the fields of one group as they are read, so the
+ *  type may come before or after the item like DeserializeType allows,
+ *  and the group is handed to the handler when the document ends. No tree
+ *  of the document is built and once the buffers have grown to the longest
+ *  line and value reading allocates nothing but the new item names.
+ *
+ *  The documents are the block mappings SnakeYAML dumps: an optional
+ *  !!gos.assumption.GroupA or GroupB tag line, the keys id, type and item,
+ *  the item as a flow mapping or an indented block mapping of name and
+ *  value, plain, single quoted and double quoted scalars that may continue
+ *  on more indented lines, and comments. Documents are separated by ---
+ *  or ended by ... lines. A malformed document is skipped up to the next
+ *  document and counted.
+ *
+ *  The handler is called with the group and the symbol of its item name.
+ */
+class Reader
+{
+public:
+  //! The symbol type of the item names
+  typedef Names::Symbol Symbol;
+
+  Reader() :
+    line_(0),
+    pending_line_(0),
+    pending_indent_(0),
+    has_pending_(false),
+    groups_(0),
+    errors_(0)
+  {
+    this->reset();
+  }
+
+  //! Read a chunk of the input
+  template<typename F> void feed(
+    const char* data,
+    const std::size_t& size,
+    F&& handler)
+  {
+    std::string_view rest(data, size);
+    for (std::size_t end; (end = rest.find('\n')) != std::string_view::npos;
+      rest.remove_prefix(end + 1))
+    {
+      if (this->partial_.empty())
+      {
+        this->physical(rest.substr(0, end), handler);
+      }
+      else
+      {
+        this->partial_.append(rest.data(), end);
+        this->physical(this->partial_, handler);
+        this->partial_.clear();
+      }
+    }
+    this->partial_.append(rest.data(), rest.size());
+  }
+  //! End the input, which ends the last document
+  template<typename F> void finish(F&& handler)
+  {
+    if (!this->partial_.empty())
+    {
+      this->physical(this->partial_, handler);
+      this->partial_.clear();
+    }
+    this->end(handler);
+  }
+  //! Read a whole stream
+  template<typename F> void read(std::istream& stream, F&& handler)
+  {
+    char buffer[4096];
+    while (stream)
+    {
+      stream.read(buffer, sizeof(buffer));
+      this->feed(buffer, static_cast<std::size_t>(stream.gcount()), handler);
+    }
+    this->finish(handler);
+  }
+
+  //! The number of groups read
+  const std::uint64_t& groups() const { return this->groups_; }
+  //! The number of malformed documents skipped
+  const std::uint64_t& errors() const { return this->errors_; }
+  //! The last error with its line number
+  const std::string& error() const { return this->error_; }
+  //! The item names
+  const Names& names() const { return this->names_; }
+
+private:
+  static constexpr std::size_t npos = std::string_view::npos;
+
+  /* The lines are assembled into logical lines first, a line continues
+   * the previous one if a quote or a flow mapping is open or it is more
+   * indented than a key with a value */
+  template<typename F> void physical(std::string_view text, F& handler)
+  {
+    this->line_++;
+    if (!text.empty() && text.back() == '\r')
+    {
+      text.remove_suffix(1);
+    }
+    const std::size_t indent = text.find_first_not_of(' ');
+    if (indent == npos || text[indent] == '#')
+    {
+      return;
+    }
+    const std::string_view content = text.substr(indent);
+    /* A document marker ends the document even inside a quote */
+    const bool marker = indent == 0 && (content == "..." ||
+      (content.substr(0, 3) == "---" &&
+        (content.size() == 3 || content[3] == ' ')));
+    if (!marker && this->has_pending_ && (open(this->pending_) ||
+      (indent > this->pending_indent_ && !opener(this->pending_))))
+    {
+      this->pending_ += ' ';
+      this->pending_.append(content.data(), content.size());
+      return;
+    }
+    this->flush();
+    if (marker && content != "...")
+    {
+      this->end(handler);
+      const std::size_t next = content.find_first_not_of(' ', 3);
+      if (next != npos)
+      {
+        this->pending(content.substr(next), 0);
+      }
+      return;
+    }
+    if (marker)
+    {
+      this->end(handler);
+      return;
+    }
+    this->pending(content, indent);
+  }
+
+  void pending(const std::string_view& content, const std::size_t& indent)
+  {
+    this->pending_.assign(content.data(), content.size());
+    this->pending_indent_ = indent;
+    this->pending_line_ = this->line_;
+    this->has_pending_ = true;
+  }
+
+  void flush()
+  {
+    if (this->has_pending_)
+    {
+      this->has_pending_ = false;
+      this->logical(this->pending_, this->pending_indent_);
+    }
+  }
+
+  void logical(const std::string_view& text, const std::size_t& indent)
+  {
+    this->started_ = true;
+    if (this->failed_)
+    {
+      return;
+    }
+    if (indent == 0 && text.substr(0, 2) == "!!")
+    {
+      if (text == "!!gos.assumption.GroupA")
+      {
+        this->type(wire::Type::A);
+      }
+      else if (text == "!!gos.assumption.GroupB")
+      {
+        this->type(wire::Type::B);
+      }
+      else
+      {
+        this->fail("Unknown tag");
+      }
+      return;
+    }
+    std::string_view key;
+    std::string_view value;
+    if (!split(text, key, value))
+    {
+      this->fail("Not a key and a value");
+      return;
+    }
+    if (indent == 0)
+    {
+      this->in_item_ = false;
+      this->document(key, value);
+    }
+    else if (this->in_item_ &&
+      (this->item_indent_ == 0 || this->item_indent_ == indent))
+    {
+      this->item_indent_ = indent;
+      this->item(key, value);
+    }
+    else
+    {
+      this->fail("Unexpected indentation");
+    }
+  }
+
+  void document(const std::string_view& key, const std::string_view& value)
+  {
+    bool null = false;
+    if (key == "id")
+    {
+      if (!this->scalar(value, this->id_, null))
+      {
+        this->fail("Malformed id");
+      }
+    }
+    else if (key == "type")
+    {
+      if (!this->scalar(value, this->scratch_, null) || null)
+      {
+        this->fail("Malformed type");
+      }
+      else if (this->scratch_ == "A")
+      {
+        this->type(wire::Type::A);
+      }
+      else if (this->scratch_ == "B")
+      {
+        this->type(wire::Type::B);
+      }
+      else
+      {
+        this->fail("Unknown type");
+      }
+    }
+    else if (key == "item")
+    {
+      if (value.empty())
+      {
+        this->has_item_ = true;
+        this->in_item_ = true;
+        this->item_indent_ = 0;
+      }
+      else if (value.front() == '{')
+      {
+        this->has_item_ = true;
+        this->flow(value);
+      }
+      else if (this->scalar(value, this->scratch_, null) && null)
+      {
+        this->has_item_ = false;
+      }
+      else
+      {
+        this->fail("Malformed item");
+      }
+    }
+    else
+    {
+      this->fail("Unknown key");
+    }
+  }
+
+  void item(const std::string_view& key, const std::string_view& value)
+  {
+    bool null = false;
+    if (key == "name")
+    {
+      if (!this->scalar(value, this->scratch_, null))
+      {
+        this->fail("Malformed name");
+      }
+      else
+      {
+        this->name_ = null ?
+          Names::NoSymbol : this->names_.intern(this->scratch_);
+      }
+    }
+    else if (key == "value")
+    {
+      if (!this->scalar(value, this->value_, null))
+      {
+        this->fail("Malformed value");
+      }
+      this->has_value_ = !null;
+    }
+    else
+    {
+      this->fail("Unknown item key");
+    }
+  }
+
+  //! Read a flow mapping of the keys of an item
+  void flow(std::string_view text)
+  {
+    const std::size_t close = text.rfind('}');
+    const std::string_view rest =
+      close != npos ? trim(text.substr(close + 1)) : std::string_view();
+    if (close == npos || (!rest.empty() && rest.front() != '#'))
+    {
+      this->fail("Malformed flow mapping");
+      return;
+    }
+    text = text.substr(1, close - 1);
+    while (!this->failed_ && !text.empty())
+    {
+      bool open = false;
+      const std::size_t comma = scan(text, ',', open);
+      const std::string_view entry = trim(text.substr(0, comma));
+      text = comma == npos ? std::string_view() : text.substr(comma + 1);
+      std::string_view key;
+      std::string_view value;
+      if (entry.empty())
+      {
+        continue;
+      }
+      if (!split(entry, key, value))
+      {
+        this->fail("Not a key and a value");
+        return;
+      }
+      this->item(key, value);
+    }
+  }
+
+  void type(const wire::Type& type)
+  {
+    if (this->has_type_ && this->group_.type != type)
+    {
+      this->fail("Conflicting types");
+    }
+    this->group_.type = type;
+    this->has_type_ = true;
+  }
+
+  template<typename F> void end(F& handler)
+  {
+    this->flush();
+    if (!this->started_)
+    {
+      return;
+    }
+    if (!this->failed_ && !this->has_type_)
+    {
+      this->fail("No type");
+    }
+    wire::Group& group = this->group_;
+    group.item.number = 0;
+    if (!this->failed_ && this->has_item_ && this->has_value_ &&
+      group.type == wire::Type::B && !number(this->value_, group.item.number))
+    {
+      this->fail("Malformed number");
+    }
+    if (this->failed_)
+    {
+      this->errors_++;
+      this->reset();
+      return;
+    }
+    group.id.assign(this->id_);
+    group.has_item = this->has_item_;
+    const bool named = this->has_item_ && this->name_ != Names::NoSymbol;
+    group.item.name.assign(
+      named ? std::string_view(this->names_.name(this->name_)) :
+        std::string_view());
+    group.item.text.assign(
+      this->has_item_ && this->has_value_ && group.type == wire::Type::A ?
+        std::string_view(this->value_) : std::string_view());
+    this->groups_++;
+    handler(static_cast<const wire::Group&>(group),
+      named ? this->name_ : Names::NoSymbol);
+    this->reset();
+  }
+
+  void reset()
+  {
+    this->started_ = false;
+    this->failed_ = false;
+    this->has_type_ = false;
+    this->has_item_ = false;
+    this->in_item_ = false;
+    this->has_value_ = false;
+    this->item_indent_ = 0;
+    this->name_ = Names::NoSymbol;
+    this->id_.clear();
+    this->value_.clear();
+  }
+
+  void fail(const char* message)
+  {
+    if (!this->failed_)
+    {
+      this->failed_ = true;
+      this->error_ = "Line " + std::to_string(this->pending_line_) + ": " +
+        message;
+    }
+  }
+
+  //! Read a scalar, a null scalar is read as empty
+  /*! Returns false if a quoted scalar is not closed or followed by more */
+  bool scalar(std::string_view text, std::string& out, bool& null) const
+  {
+    text = trim(text);
+    out.clear();
+    null = false;
+    if (text.empty() || text.front() == '#')
+    {
+      null = true;
+      return true;
+    }
+    if (text.front() == '\'')
+    {
+      std::size_t i = 1;
+      for (; i < text.size(); i++)
+      {
+        if (text[i] == '\'')
+        {
+          if (i + 1 < text.size() && text[i + 1] == '\'')
+          {
+            out += '\'';
+            i++;
+            continue;
+          }
+          break;
+        }
+        out += text[i];
+      }
+      return i < text.size() && trim(strip(text.substr(i + 1))).empty();
+    }
+    if (text.front() == '"')
+    {
+      std::size_t i = 1;
+      for (; i < text.size() && text[i] != '"'; i++)
+      {
+        if (text[i] != '\\')
+        {
+          out += text[i];
+        }
+        else if (++i >= text.size() || !escape(text, i, out))
+        {
+          return false;
+        }
+      }
+      return i < text.size() && trim(strip(text.substr(i + 1))).empty();
+    }
+    text = trim(strip(text));
+    null = text == "~" || text == "null" || text == "Null" || text == "NULL";
+    if (!null)
+    {
+      out.assign(text.data(), text.size());
+    }
+    return true;
+  }
+
+  //! Append the character of the escape at an index, moved to its end
+  static bool escape(
+    const std::string_view& text,
+    std::size_t& i,
+    std::string& out)
+  {
+    switch (text[i])
+    {
+    case '0':
+      out += '\0';
+      return true;
+    case 't':
+      out += '\t';
+      return true;
+    case 'n':
+      out += '\n';
+      return true;
+    case 'r':
+      out += '\r';
+      return true;
+    case '"':
+    case '\\':
+    case '/':
+    case ' ':
+      out += text[i];
+      return true;
+    case 'x':
+      return code(text, i, 2, out);
+    case 'u':
+      return code(text, i, 4, out);
+    case 'U':
+      return code(text, i, 8, out);
+    default:
+      return false;
+    }
+  }
+
+  //! Append a code point of a number of hexadecimal digits as UTF-8
+  static bool code(
+    const std::string_view& text,
+    std::size_t& i,
+    const std::size_t& digits,
+    std::string& out)
+  {
+    std::uint32_t value = 0;
+    const char* first = text.data() + i + 1;
+    if (i + digits >= text.size() ||
+      std::from_chars(first, first + digits, value, 16).ptr !=
+        first + digits || value > 0x10ffff)
+    {
+      return false;
+    }
+    i += digits;
+    if (value < 0x80)
+    {
+      out += static_cast<char>(value);
+    }
+    else if (value < 0x800)
+    {
+      out += static_cast<char>(0xc0 | (value >> 6));
+      out += static_cast<char>(0x80 | (value & 0x3f));
+    }
+    else if (value < 0x10000)
+    {
+      out += static_cast<char>(0xe0 | (value >> 12));
+      out += static_cast<char>(0x80 | ((value >> 6) & 0x3f));
+      out += static_cast<char>(0x80 | (value & 0x3f));
+    }
+    else
+    {
+      out += static_cast<char>(0xf0 | (value >> 18));
+      out += static_cast<char>(0x80 | ((value >> 12) & 0x3f));
+      out += static_cast<char>(0x80 | ((value >> 6) & 0x3f));
+      out += static_cast<char>(0x80 | (value & 0x3f));
+    }
+    return true;
+  }
+
+  //! Read a decimal 32 bit integer
+  static bool number(std::string_view text, std::int32_t& value)
+  {
+    if (!text.empty() && text.front() == '+')
+    {
+      text.remove_prefix(1);
+    }
+    const std::from_chars_result result =
+      std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() &&
+      result.ptr == text.data() + text.size() && !text.empty();
+  }
+
+  static std::string_view trim(std::string_view text)
+  {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+    {
+      text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+    {
+      text.remove_suffix(1);
+    }
+    return text;
+  }
+
+  //! Remove a comment from the end of plain text
+  static std::string_view strip(const std::string_view& text)
+  {
+    for (std::size_t i = 0; (i = text.find('#', i)) != npos; i++)
+    {
+      if (i == 0 || text[i - 1] == ' ')
+      {
+        return text.substr(0, i);
+      }
+    }
+    return text;
+  }
+
+  //! Scan a line outside of quotes and flow mappings
+  /*! Returns the index of the first character c outside of them or npos
+   *  and tells if a quote or a flow mapping is still open where the scan
+   *  stopped. A quote only starts a scalar at the start of a token and a
+   *  comment ends the line.
+   */
+  static std::size_t scan(
+    const std::string_view& text,
+    const char& c,
+    bool& open)
+  {
+    char quote = 0;
+    int depth = 0;
+    std::size_t i = 0;
+    for (; i < text.size(); i++)
+    {
+      /* Most characters are none of the ones looked at */
+      while (quote == 0 && i < text.size() && text[i] != c &&
+        !special(text[i]))
+      {
+        i++;
+      }
+      if (i == text.size())
+      {
+        break;
+      }
+      const char current = text[i];
+      if (quote == '\'')
+      {
+        if (current == '\'' && i + 1 < text.size() && text[i + 1] == '\'')
+        {
+          i++;
+        }
+        else if (current == '\'')
+        {
+          quote = 0;
+        }
+        continue;
+      }
+      if (quote == '"')
+      {
+        if (current == '\\')
+        {
+          i++;
+        }
+        else if (current == '"')
+        {
+          quote = 0;
+        }
+        continue;
+      }
+      const bool start = i == 0 || text[i - 1] == ' ' ||
+        text[i - 1] == '{' || text[i - 1] == ',';
+      if (current == c && depth == 0)
+      {
+        break;
+      }
+      if (current == '#' && (i == 0 || text[i - 1] == ' '))
+      {
+        i = text.size();
+        break;
+      }
+      if ((current == '\'' || current == '"') && start)
+      {
+        quote = current;
+      }
+      else if (current == '{')
+      {
+        depth++;
+      }
+      else if (current == '}')
+      {
+        depth--;
+      }
+    }
+    open = quote != 0 || depth > 0;
+    return i < text.size() ? i : npos;
+  }
+  //! Check if a character may start or end a quote, a mapping or a comment
+  static bool special(const char& c)
+  {
+    return c == '\'' || c == '"' || c == '{' || c == '}' || c == '#';
+  }
+  //! Check if a quote or a flow mapping is open at the end of a line
+  static bool open(const std::string_view& text)
+  {
+    bool result = false;
+    scan(text, '\n', result);
+    return result;
+  }
+
+  //! Check if a line is a key opening a block mapping
+  static bool opener(const std::string_view& text)
+  {
+    const std::string_view rest = trim(strip(text));
+    return !rest.empty() && rest.back() == ':';
+  }
+
+  //! Split a key and its value at the first colon followed by a space
+  static bool split(
+    const std::string_view& text,
+    std::string_view& key,
+    std::string_view& value)
+  {
+    for (std::size_t i = 0; (i = text.find(':', i)) != npos; i++)
+    {
+      if (i + 1 == text.size() || text[i + 1] == ' ')
+      {
+        key = trim(text.substr(0, i));
+        value = trim(text.substr(i + 1));
+        if (value.empty() || value.front() == '#')
+        {
+          value = std::string_view();
+        }
+        return !key.empty();
+      }
+    }
+    return false;
+  }
+
+  std::string partial_;
+  std::string pending_;
+  std::size_t line_;
+  std::size_t pending_line_;
+  std::size_t pending_indent_;
+  bool has_pending_;
+
+  wire::Group group_;
+  std::string id_;
+  std::string value_;
+  std::string scratch_;
+  Names names_;
+  Symbol name_;
+  std::size_t item_indent_;
+  bool started_;
+  bool failed_;
+  bool has_type_;
+  bool has_item_;
+  bool in_item_;
+  bool has_value_;
+
+  std::uint64_t groups_;
+  std::uint64_t errors_;
+  std::string error_;
+};
+
+} /* namespace yaml */
+} /* namespace assumption */
+} /* namespace gos */
+
+#endif /* _GOS_ASSUMPTION_YAML_H_ */
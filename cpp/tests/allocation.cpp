@@ -0,0 +1,329 @@
+#include <cstdlib>
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/wire.h>
+#include <gos/assumption/yaml.h>
+
+/* Replacing the global allocation functions lets the tests count the heap
+ * allocations made between arming and disarming the counter. */
+static std::atomic<bool> allocation_counting(false);
+static std::atomic<size_t> allocation_count(0);
+
+static void* counted_allocation(std::size_t size)
+{
+  if (allocation_counting.load(std::memory_order_relaxed))
+  {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new(std::size_t size) { return counted_allocation(size); }
+void* operator new[](std::size_t size) { return counted_allocation(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+//! Counts the heap allocations made during its lifetime
+class AllocationCounter
+{
+public:
+  AllocationCounter()
+  {
+    allocation_count.store(0);
+    allocation_counting.store(true);
+  }
+  ~AllocationCounter() { allocation_counting.store(false); }
+  size_t count() const { return allocation_count.load(); }
+};
+
+//! A memory resource counting the bytes it has handed out
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  CountingResource() : bytes_(0) {}
+  size_t bytes() const { return this->bytes_; }
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    this->bytes_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(
+    void* pointer, std::size_t bytes, std::size_t alignment) override
+  {
+    this->bytes_ -= bytes;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+  bool do_is_equal(
+    const std::pmr::memory_resource& resource) const noexcept override
+  {
+    return this == &resource;
+  }
+  size_t bytes_;
+};
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+TEST(allocation, lookup)
+{
+  typedef FloatWrapperHolderAssumption::Id Id;
+  typedef FloatWrapperHolderAssumption::Size Size;
+
+  const size_t Count = 1000;
+  const size_t Lookups = 1000000;
+  const Size ArraySize = 4;
+
+  FloatWrapperHolderAssumption assumption;
+  std::vector<Id> hits, misses;
+  for (size_t i = 0; i < Count; i++)
+  {
+    hits.push_back("registered/" + std::to_string(i));
+    misses.push_back("stale/" + std::to_string(i));
+    FloatWrapperHolderAssumption::Array a =
+      std::make_unique<float[]>(ArraySize);
+    FloatWrapperHolderAssumption::WrapperArray wrapper =
+      std::make_unique<FloatWrapper[]>(ArraySize);
+    FloatWrapperHolderAssumption::HolderPtr holder =
+      std::make_unique<FloatHolder>(ArraySize);
+    assumption.insert(hits.back(), a, wrapper, holder);
+  }
+  const FloatWrapperHolderAssumption& constant = assumption;
+
+  size_t found = 0, missed = 0;
+  {
+    AllocationCounter counter;
+    for (size_t i = 0; i < Lookups / 2; i++)
+    {
+      const Id& hit = hits[i % Count];
+      const Id& miss = misses[i % Count];
+      if (i % 2 == 0)
+      {
+        found += assumption.find_value(hit, 1) != nullptr;
+        found += assumption.find_wrapper(hit, 2) != nullptr;
+        found += assumption.find_holder(hit) != nullptr;
+        missed += assumption.find_value(miss, 1) == nullptr;
+        missed += assumption.find_wrapper(miss, 2) == nullptr;
+        missed += assumption.find_holder(miss) == nullptr;
+      }
+      else
+      {
+        found += constant.find_value(hit, 1) != nullptr;
+        found += constant.find_wrapper(hit, 2) != nullptr;
+        found += constant.find_holder(hit) != nullptr;
+        missed += constant.find_value(miss, 1) == nullptr;
+        missed += constant.find_wrapper(miss, 2) == nullptr;
+        missed += constant.find_holder(miss) == nullptr;
+      }
+      found += constant.has(hit);
+      missed += !constant.has(miss);
+    }
+    EXPECT_EQ(0, counter.count());
+  }
+  EXPECT_EQ(4 * Lookups / 2, found);
+  EXPECT_EQ(4 * Lookups / 2, missed);
+
+  // Misses never grow the object
+  EXPECT_EQ(Count, assumption.size());
+  EXPECT_FALSE(assumption.has(misses.front()));
+}
+
+TEST(allocation, views)
+{
+  const size_t Count = 100;
+
+  // Ids too long for the small string buffer, a temporary would allocate
+  FloatWrapperHolderAssumption assumption;
+  std::string text;
+  for (size_t i = 0; i < Count; i++)
+  {
+    const std::string id = "a registered id too long to be small/" +
+      std::to_string(i);
+    assumption.create(id, 4);
+    text += id + ",";
+  }
+
+  size_t found = 0;
+  {
+    AllocationCounter counter;
+    std::string_view rest(text);
+    for (size_t i = 0; i < Count; i++)
+    {
+      const std::string_view id = rest.substr(0, rest.find(','));
+      rest.remove_prefix(id.size() + 1);
+      found += assumption.has(id);
+      assumption.value(id, 1) = 1.0f;
+      assumption.wrapper(id, 2) = FloatWrapper(2.0f);
+      found += assumption.wrapper(id, 2).is_set();
+      assumption.holder(id).get(3) = FloatWrapper(3.0f);
+    }
+    found += assumption.has("a registered id too long to be small/7");
+    EXPECT_EQ(0, counter.count());
+  }
+  EXPECT_EQ(2 * Count + 1, found);
+}
+
+TEST(allocation, resource)
+{
+  typedef FloatWrapperHolderAssumption::Batch Batch;
+  typedef FloatWrapperHolderAssumption::Entry Entry;
+
+  const size_t Count = 100;
+  const FloatWrapperHolderAssumption::Size ArraySize = 8;
+
+  // Short ids fit in the string itself and need no allocation
+  Batch batch;
+  for (size_t i = 0; i < Count; i++)
+  {
+    batch.push_back(Entry("many/" + std::to_string(i), ArraySize));
+  }
+  std::vector<char> buffer(1 << 20);
+
+  {
+    AllocationCounter counter;
+    std::pmr::monotonic_buffer_resource arena(
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    FloatWrapperHolderAssumption assumption(&arena);
+    for (size_t i = 0; i < Count; i++)
+    {
+      assumption.create("one/" + std::to_string(i), ArraySize);
+    }
+    assumption.create_many(batch);
+    EXPECT_EQ(2 * Count, assumption.size());
+    EXPECT_EQ(0.0f, assumption.value("one/7", 7));
+    EXPECT_EQ(0.0f, assumption.holder("many/7").get(7).value());
+
+    assumption.clear();
+    EXPECT_EQ(0, assumption.size());
+    EXPECT_FALSE(assumption.has("one/7"));
+    assumption.create("again", ArraySize);
+    EXPECT_TRUE(assumption.has("again"));
+    EXPECT_EQ(0, counter.count());
+  }
+
+  // Everything taken from a resource is given back to it
+  CountingResource resource;
+  {
+    FloatWrapperHolderAssumption assumption(&resource);
+    assumption.create("one", ArraySize);
+    const size_t created = resource.bytes();
+    EXPECT_LT(0, created);
+    assumption.create("two", ArraySize);
+    assumption.create_many(batch);
+    EXPECT_LT(created, resource.bytes());
+    EXPECT_TRUE(assumption.remove("two"));
+    assumption.clear();
+    EXPECT_EQ(0, assumption.size());
+  }
+  EXPECT_EQ(0, resource.bytes());
+}
+
+TEST(allocation, wire)
+{
+  namespace gaw = gos::assumption::wire;
+
+  std::vector<unsigned char> buffer;
+  for (int i = 0; i < 100; i++)
+  {
+    gaw::Group group;
+    group.type = i % 2 == 0 ? gaw::Type::B : gaw::Type::A;
+    group.id.assign("group" + std::to_string(i));
+    group.item.name.assign("item");
+    group.item.number = 10 * i + 1;
+    gaw::encode(buffer, group);
+  }
+
+  // Loading the same ids again writes their values in place
+  CountingResource resource;
+  {
+    FloatWrapperHolderAssumption assumption(&resource);
+    EXPECT_EQ(buffer.size(),
+      gaw::load(buffer.data(), buffer.size(), assumption));
+    const size_t loaded = resource.bytes();
+    EXPECT_LT(0, loaded);
+    for (int i = 0; i < 10; i++)
+    {
+      EXPECT_EQ(buffer.size(),
+        gaw::load(buffer.data(), buffer.size(), assumption));
+      EXPECT_EQ(loaded, resource.bytes());
+    }
+    EXPECT_EQ(100, assumption.size());
+    EXPECT_EQ(981.0f, assumption.value("group98", 0));
+  }
+  EXPECT_EQ(0, resource.bytes());
+}
+
+TEST(allocation, yaml)
+{
+  namespace gay = gos::assumption::yaml;
+
+  std::string input;
+  for (size_t i = 0; i < 100; i++)
+  {
+    input += "--- !!gos.assumption.GroupB\nid: 'a long group id " +
+      std::to_string(i) + "'\nitem: {name: a long item name " +
+      std::to_string(i % 10) + ", value: " + std::to_string(i) +
+      "}\ntype: B\n";
+  }
+  gay::Reader reader;
+  size_t sum = 0;
+  auto handler = [&sum](const gos::assumption::wire::Group& group,
+    const gay::Names::Symbol& symbol)
+  {
+    sum += group.item.number + symbol;
+  };
+  auto read = [&reader, &input, &handler]()
+  {
+    for (size_t i = 0; i < input.size(); i += 64)
+    {
+      reader.feed(input.data() + i, std::min<size_t>(64, input.size() - i),
+        handler);
+    }
+    reader.finish(handler);
+  };
+  read();
+
+  // The buffers are reused and the repeated names are interned once
+  {
+    AllocationCounter counter;
+    read();
+    EXPECT_EQ(0, counter.count());
+  }
+  EXPECT_EQ(200, reader.groups());
+  EXPECT_EQ(0, reader.errors());
+  EXPECT_EQ(10, reader.names().size());
+  EXPECT_EQ(2 * (99 * 100 / 2 + 10 * (0 + 9) * 10 / 2), sum);
+}
+
+TEST(allocation, counter)
+{
+  AllocationCounter counter;
+  std::unique_ptr<float[]> a = std::make_unique<float[]>(8);
+  EXPECT_EQ(1, counter.count());
+}
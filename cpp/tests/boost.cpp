@@ -1,5 +1,10 @@
 #include <cmath>
+#include <cstdint>
 
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 #ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
@@ -12,6 +17,7 @@
 #endif
 #endif
 
+#include <boost/asio/buffer.hpp>
 #include <boost/optional.hpp>
 
 #ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
@@ -27,6 +33,14 @@
 
 #include <gos/assumption/boost.h>
 #include <gos/assumption.h>
+#include <gos/assumption/endian.h>
+#include <gos/assumption/frame.h>
+#include <gos/assumption/machine.h>
+#include <gos/assumption/pump.h>
+#include <gos/assumption/timer.h>
+#include <gos/assumption/trace.h>
+#include <gos/assumption/udp.h>
+#include <gos/assumption/view.h>
 
 
 #ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
@@ -35,46 +49,9 @@ namespace endian = ::boost::spirit::endian;
 #endif
 
 #ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
-void* store_big_endian_array(void* pointer, const float* values, size_t count)
-{
-  char* local = (char*)pointer;
-  for (size_t i = 0; i < count; i++)
-  {
-    detail::store_big_endian<float, sizeof(float)>(local, values[i]);
-    local += sizeof(float);
-  }
-  return (void*)local;
-}
-#endif
-
-#ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
-void* load_little_endian_array(const void* pointer, float* values, size_t count)
-{
-  char* local = (char*)pointer;
-  for (size_t i = 0; i < count; i++)
-  {
-    *values =
-      detail::load_little_endian<float, sizeof(float)>((const char*)local);
-    local += sizeof(float);
-    values++;
-  }
-  return (void*)local;
-}
-#endif
-
-#ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
-void* load_big_endian_array(const void* pointer, float* values, size_t count)
-{
-  char* local = (char*)pointer;
-  for (size_t i = 0; i < count; i++)
-  {
-    *values =
-      detail::load_big_endian<float, sizeof(float)>((const char*)local);
-    local += sizeof(float);
-    values++;
-  }
-  return (void*)local;
-}
+using gos::assumption::endian::store_big_endian_array;
+using gos::assumption::endian::load_little_endian_array;
+using gos::assumption::endian::load_big_endian_array;
 #endif
 
 TEST(boost_assumption, optional)
@@ -257,11 +234,115 @@ TEST(boost_assumption, spirit_qi_binary)
 }
 #endif
 
+TEST(boost_assumption, endian_view)
+{
+  namespace ge = ::gos::assumption::endian;
+  /* A frame of a header and big endian floats read without a copy */
+  const size_t Count = 16384;
+  std::vector<unsigned char> frame(2 + Count * sizeof(float));
+  ge::store_big_endian<std::uint16_t>(frame.data(), 0x0102);
+  std::vector<float> floats(Count);
+  for (size_t i = 0; i < Count; i++)
+  {
+    floats[i] = static_cast<float>(i) * 0.5f;
+  }
+  ge::store_big_endian_array(frame.data() + 2, floats.data(), Count);
+
+  const boost::asio::const_buffer buffer =
+    boost::asio::buffer(static_cast<const std::vector<unsigned char>&>(frame));
+  EXPECT_EQ(0x0102, ge::big_view<std::uint16_t>(buffer)[0]);
+  const ge::View<float, ge::Order::Big> view =
+    ge::big_view<float>(buffer + 2);
+  EXPECT_EQ(Count, view.size());
+  EXPECT_EQ(static_cast<const void*>(frame.data() + 2), view.data());
+  EXPECT_FLOAT_EQ(floats[0], view[0]);
+  EXPECT_FLOAT_EQ(floats[1234], view[1234]);
+  EXPECT_FLOAT_EQ(floats[Count - 1], view[Count - 1]);
+
+  const boost::asio::mutable_buffer writable = boost::asio::buffer(frame);
+  ge::MutableView<float, ge::Order::Big> values =
+    ge::big_mutable_view<float>(writable + 2);
+  values[1234] = -1.0f;
+  EXPECT_FLOAT_EQ(-1.0f, view[1234]);
+}
+
 TEST(boost_assumption, udp)
 {
-  //boost::asio::io_service service;
+  namespace gu = ::gos::assumption::udp;
+  typedef gos::assumption::Wrapper<float> FloatWrapper;
+  typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+  typedef gu::Receiver<FloatWrapper> Receiver;
+  typedef boost::asio::ip::udp::endpoint Endpoint;
+
+  const size_t Size = 64;
+  FloatHolder holder(Size);
+  boost::asio::io_context context;
+  Receiver receiver(context,
+    Endpoint(boost::asio::ip::address_v4::loopback(), 0),
+    Receiver::Items(holder.pointer(0), holder.size()), 4);
+
+  boost::asio::ip::udp::socket sender(
+    context, Endpoint(boost::asio::ip::udp::v4(), 0));
+  unsigned char datagram[gu::DatagramCapacity];
+  float values[16];
+  auto send = [&](const uint32_t& sequence, const uint16_t& first,
+    const uint16_t& count)
+  {
+    for (uint16_t i = 0; i < count; i++)
+    {
+      values[i] = static_cast<float>(first + i) + 0.5f;
+    }
+    const size_t size = gu::encode(datagram, sizeof(datagram),
+      gu::Header{ sequence, first, count }, values);
+    sender.send_to(boost::asio::buffer(datagram, size), receiver.endpoint());
+  };
+
+  // Ten datagrams with the fifth one missing, more than a batch each poll
+  for (uint32_t sequence = 0; sequence < 10; sequence++)
+  {
+    if (sequence != 4)
+    {
+      send(sequence, static_cast<uint16_t>(sequence * 6), 6);
+    }
+  }
+  // A datagram that ends before its floats and one out of range
+  sender.send_to(boost::asio::buffer(datagram, gu::HeaderBytes + 2),
+    receiver.endpoint());
+  send(10, Size - 2, 4);
+
+  /* Loopback delivers right away but not necessarily before the poll */
+  for (int attempt = 0; attempt < 1000 && receiver.counters().packets < 11;
+    attempt++)
+  {
+    if (receiver.poll() == 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
 
-  //boost::asio::ip::udp::resolver resolver(service);
+  const gu::Counters& counters = receiver.counters();
+  EXPECT_EQ(11u, counters.packets);
+  EXPECT_EQ(1u, counters.drops);
+  EXPECT_EQ(2u, counters.errors);
+  EXPECT_LE(3u, counters.batches);
+  for (size_t i = 0; i < 60; i++)
+  {
+    const float expected = i / 6 == 4 ? 0.0f : static_cast<float>(i) + 0.5f;
+    EXPECT_FLOAT_EQ(expected, holder.get(i).value()) << i;
+  }
+  EXPECT_FLOAT_EQ(0.0f, holder.get(Size - 1).value());
+
+  // Asynchronously on the io context
+  receiver.start();
+  send(11, 0, 1);
+  while (receiver.counters().packets < 12)
+  {
+    context.run_one();
+  }
+  receiver.stop();
+  context.run();
+  EXPECT_EQ(1u, receiver.counters().drops);
+  EXPECT_FLOAT_EQ(0.5f, holder.get(0).value());
 }
 
 #ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
@@ -288,6 +369,446 @@ TEST(boost_assumption, msm_and_mpl)
 }
 #endif
 
+TEST(boost_assumption, wheel_timer)
+{
+  typedef gos::assumption::WheelTimer<int> Timer;
+  typedef Timer::Clock Clock;
+  const Timer::Duration Resolution = std::chrono::milliseconds(1);
+
+  boost::asio::io_context context;
+  std::vector<Clock::time_point> fired(3);
+  size_t count = 0;
+  Timer timer(context, Resolution, [&](const Timer::Batch& batch)
+  {
+    for (const int& payload : batch)
+    {
+      fired[payload] = Clock::now();
+      count++;
+    }
+  });
+  const Clock::time_point start = Clock::now();
+  timer.start();
+  timer.arm(std::chrono::milliseconds(2), 0);
+  timer.arm(std::chrono::milliseconds(5), 1);
+  const Timer::Handle cancelled = timer.arm(std::chrono::milliseconds(3), 2);
+  EXPECT_TRUE(timer.cancel(cancelled));
+  while (count < 2)
+  {
+    context.run_one();
+  }
+  timer.stop();
+  context.run();
+  EXPECT_EQ(2u, count);
+  EXPECT_LE(std::chrono::milliseconds(2), fired[0] - start);
+  EXPECT_LE(std::chrono::milliseconds(5), fired[1] - start);
+  EXPECT_TRUE(timer.wheel().empty());
+}
+
+TEST(boost_assumption, wheel_timer_mid_tick)
+{
+  typedef gos::assumption::WheelTimer<int> Timer;
+  typedef Timer::Clock Clock;
+  const Timer::Duration Resolution = std::chrono::milliseconds(50);
+
+  boost::asio::io_context context;
+  Clock::time_point fired;
+  size_t count = 0;
+  Timer timer(context, Resolution, [&](const Timer::Batch& batch)
+  {
+    fired = Clock::now();
+    count += batch.size();
+  });
+  timer.start();
+  // Armed most of a tick after the last one, it still waits its delay
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  const Clock::time_point armed = Clock::now();
+  timer.arm(Resolution, 0);
+  while (count < 1)
+  {
+    context.run_one();
+  }
+  timer.stop();
+  context.run();
+  EXPECT_EQ(1u, count);
+  EXPECT_LE(Resolution, fired - armed);
+  EXPECT_TRUE(timer.wheel().empty());
+}
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+TEST(boost_assumption, msm_timeout)
+{
+  typedef gos::assumption::WheelTimer<gas::StateEngine*> Timer;
+  typedef gas::StateEngine::stt Table;
+  const int Available = ::boost::msm::back::get_state_id<
+    Table, gas::Engine_::Available>::value;
+  const int Requesting = ::boost::msm::back::get_state_id<
+    Table, gas::Engine_::Requesting>::value;
+  const int InControl = ::boost::msm::back::get_state_id<
+    Table, gas::Engine_::InControl>::value;
+
+  const size_t Count = 100;
+  std::vector<gas::StateEngine> engines(Count);
+  for (gas::StateEngine& engine : engines)
+  {
+    gas::Stage stage;
+    engine.start();
+    engine.process_event(events::Started(__FILE__, __LINE__, stage));
+    engine.process_event(events::NovosDataAvailable());
+    engine.process_event(events::ItgDataAvailable());
+    engine.process_event(events::HoistConstrainstActivityBecomesAvailable());
+    engine.process_event(events::ControlRequested());
+    EXPECT_EQ(Requesting, engine.current_state()[0]);
+  }
+
+  // Half of the requests are granted before their timeout
+  boost::asio::io_context context;
+  Timer timer(context, std::chrono::milliseconds(1),
+    gas::TimeoutDispatcher(), Count);
+  std::vector<Timer::Handle> handles;
+  for (gas::StateEngine& engine : engines)
+  {
+    handles.push_back(timer.arm(std::chrono::milliseconds(2), &engine));
+  }
+  for (size_t i = 0; i < Count; i += 2)
+  {
+    engines[i].process_event(events::Granted());
+    EXPECT_TRUE(timer.cancel(handles[i]));
+  }
+  timer.start();
+  while (!timer.wheel().empty())
+  {
+    context.run_one();
+  }
+  timer.stop();
+  context.run();
+  for (size_t i = 0; i < Count; i++)
+  {
+    EXPECT_EQ(i % 2 == 0 ? InControl : Available,
+      engines[i].current_state()[0]) << i;
+  }
+}
+#endif
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+TEST(boost_assumption, msm_stage)
+{
+  gas::StateEngine engine;
+  EXPECT_EQ(gas::Stage::Undefined, engine.stage());
+  gas::Stage stage;
+  engine.start();
+  EXPECT_EQ(gas::Stage::Starting, engine.stage());
+  EXPECT_EQ(0u, engine.transitions());
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  engine.process_event(events::ItgDataAvailable());
+  EXPECT_EQ(gas::Stage::NoNovosData, engine.stage());
+  EXPECT_EQ(gas::Stage::NoNovosData, engine.GetStage());
+  EXPECT_EQ(2u, engine.transitions());
+  engine.process_event(events::Granted());
+  EXPECT_EQ(2u, engine.transitions());
+
+  /* Another thread polls without visiting the states */
+  std::atomic<bool> done(false);
+  bool valid = true;
+  std::thread monitor([&]()
+  {
+    uint64_t previous = 0;
+    while (!done.load())
+    {
+      const uint64_t transitions = engine.transitions();
+      const gas::Stage polled = engine.stage();
+      valid = valid && transitions >= previous &&
+        (polled == gas::Stage::NoNovosData || polled == gas::Stage::NoData);
+      previous = transitions;
+    }
+  });
+  for (int i = 0; i < 10000; i++)
+  {
+    engine.process_event(events::ItgDataUnavailable());
+    engine.process_event(events::ItgDataAvailable());
+  }
+  done.store(true);
+  monitor.join();
+  EXPECT_TRUE(valid);
+  EXPECT_EQ(20002u, engine.transitions());
+}
+#endif
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+TEST(boost_assumption, msm_frames)
+{
+  gos::assumption::FramePool pool(2, 64);
+  std::vector<gas::StateEngine> engines(8);
+  for (gas::StateEngine& engine : engines)
+  {
+    engine.start();
+    engine.process_event(
+      events::Started(__FILE__, __LINE__, gas::Stage::Undefined));
+  }
+  {
+    gos::assumption::Frame frame = pool.acquire();
+    frame.values<float>(8)[0] = 1.0f;
+    frame.sequence(5);
+    const events::ItgDataAvailable data(frame);
+    frame = gos::assumption::Frame();
+    for (gas::StateEngine& engine : engines)
+    {
+      engine.process_event(data);
+      EXPECT_EQ(gas::Stage::NoNovosData, engine.stage());
+      EXPECT_EQ(5u, engine.itg_sequence());
+    }
+    EXPECT_EQ(1u, data.Data.references());
+  }
+  EXPECT_EQ(2u, pool.available());
+
+  /* The guard rejects a stale frame */
+  gas::StateEngine& engine = engines[0];
+  engine.process_event(events::ItgDataUnavailable());
+  gos::assumption::Frame stale = pool.acquire();
+  stale.sequence(4);
+  engine.process_event(events::ItgDataAvailable(stale));
+  EXPECT_EQ(gas::Stage::NoData, engine.stage());
+  stale.sequence(6);
+  engine.process_event(events::ItgDataAvailable(stale));
+  EXPECT_EQ(gas::Stage::NoNovosData, engine.stage());
+  EXPECT_EQ(6u, engine.itg_sequence());
+}
+#endif
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+TEST(boost_assumption, msm_first_frame)
+{
+  /* The first frame is accepted with the sequence the pool gave it */
+  gos::assumption::FramePool pool(2, 64);
+  gas::StateEngine engine;
+  engine.start();
+  engine.process_event(
+    events::Started(__FILE__, __LINE__, gas::Stage::Undefined));
+  gos::assumption::Frame frame = pool.acquire();
+  EXPECT_EQ(0u, frame.sequence());
+  engine.process_event(events::ItgDataAvailable(frame));
+  EXPECT_EQ(gas::Stage::NoNovosData, engine.stage());
+  EXPECT_EQ(0u, engine.itg_sequence());
+
+  /* After it a frame of the same sequence is stale */
+  engine.process_event(events::ItgDataUnavailable());
+  engine.process_event(events::ItgDataAvailable(frame));
+  EXPECT_EQ(gas::Stage::NoData, engine.stage());
+}
+#endif
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+TEST(boost_assumption, msm_table)
+{
+  /* Every event from every stage reachable gives the same stage on the
+   * boost::msm engine and the table engine */
+  namespace gsm = ::gos::assumption::state_machine;
+  typedef gas::events::EventId Id;
+  typedef std::vector<Id> Path;
+  const size_t Events = gsm::TableEngine::Events;
+
+  std::vector<Path> paths(1);
+  std::vector<bool> reached(gsm::TableEngine::Stages, false);
+  reached[size_t(gas::Stage::Starting)] = true;
+  size_t transitions = 0;
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    for (size_t event = 0; event < Events; event++)
+    {
+      gas::StateEngine msm;
+      gsm::TableEngine table;
+      msm.start();
+      table.start();
+      Path path = paths[i];
+      path.push_back(Id(event));
+      for (const Id& id : path)
+      {
+        gas::process(msm, id);
+        table.process(id);
+        ASSERT_EQ(msm.GetStage(), table.GetStage()) << i << " " << event;
+      }
+      const gas::Stage stage = table.GetStage();
+      if (!reached[size_t(stage)])
+      {
+        reached[size_t(stage)] = true;
+        paths.push_back(path);
+      }
+      transitions++;
+    }
+  }
+  EXPECT_EQ(gsm::TableEngine::Stages - 1, paths.size());
+  EXPECT_EQ(paths.size() * Events, transitions);
+}
+#endif
+
+#ifdef _GOS_ASSUMPTION_BOOST_STATE_MACHINE_
+TEST(boost_assumption, msm_pump)
+{
+  typedef gas::events::EventId Id;
+  const int NoData = ::boost::msm::back::get_state_id<
+    gas::StateEngine::stt, gas::Engine_::NoData>::value;
+  const int NoItgData = ::boost::msm::back::get_state_id<
+    gas::StateEngine::stt, gas::Engine_::NoItgData>::value;
+  const int Available = ::boost::msm::back::get_state_id<
+    gas::StateEngine::stt, gas::Engine_::Available>::value;
+
+  {
+    gas::StateEngine engine;
+    engine.start();
+    gas::EventPump pump(engine, 4, gas::Policy::Reject);
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::Started));
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::NovosDataAvailable));
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::ItgDataAvailable));
+    EXPECT_EQ(gas::Posted::Queued,
+      pump.post(Id::HoistConstrainstActivityBecomesAvailable));
+    EXPECT_EQ(gas::Posted::Rejected, pump.post(Id::ControlRequested));
+    EXPECT_EQ(4u, pump.size());
+    EXPECT_EQ(3u, pump.dispatch(3));
+    EXPECT_EQ(1u, pump.dispatch());
+    EXPECT_EQ(0u, pump.dispatch());
+    EXPECT_EQ(Available, engine.current_state()[0]);
+    const gas::PumpCounters counters = pump.counters();
+    EXPECT_EQ(4u, counters.queued);
+    EXPECT_EQ(1u, counters.rejected);
+    EXPECT_EQ(4u, counters.dispatched);
+    EXPECT_EQ(2u, counters.batches);
+  }
+  {
+    gas::StateEngine engine;
+    engine.start();
+    gas::EventPump pump(engine, 2, gas::Policy::Drop);
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::Started));
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::NovosDataAvailable));
+    EXPECT_EQ(gas::Posted::Dropped, pump.post(Id::ItgDataAvailable));
+    EXPECT_EQ(2u, pump.dispatch());
+    EXPECT_EQ(NoItgData, engine.current_state()[0]);
+    EXPECT_EQ(1u, pump.counters().dropped);
+  }
+  {
+    /* Only the last availability of the NOVOS data is applied */
+    gas::StateEngine engine;
+    engine.start();
+    gas::EventPump pump(engine, 2, gas::Policy::Coalesce);
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::Started));
+    EXPECT_EQ(gas::Posted::Queued, pump.post(Id::NovosDataAvailable));
+    EXPECT_EQ(gas::Posted::Coalesced, pump.post(Id::NovosDataUnavailable));
+    EXPECT_EQ(gas::Posted::Coalesced, pump.post(Id::NovosDataAvailable));
+    EXPECT_EQ(gas::Posted::Coalesced, pump.post(Id::NovosDataUnavailable));
+    EXPECT_EQ(gas::Posted::Dropped, pump.post(Id::ControlRequested));
+    EXPECT_EQ(3u, pump.dispatch());
+    EXPECT_EQ(NoData, engine.current_state()[0]);
+    EXPECT_EQ(3u, pump.counters().coalesced);
+  }
+  {
+    /* Many producers, the engine is only touched by the dispatcher */
+    gas::StateEngine engine;
+    gas::Stage stage;
+    engine.start();
+    engine.process_event(events::Started(__FILE__, __LINE__, stage));
+    gas::EventPump pump(engine, 64, gas::Policy::Reject);
+    const size_t Producers = 4;
+    const size_t Count = 1000;
+    std::vector<std::thread> threads;
+    for (size_t producer = 0; producer < Producers; producer++)
+    {
+      threads.emplace_back([&pump, Count]()
+      {
+        for (size_t i = 0; i < Count; i++)
+        {
+          const Id id = i % 2 == 0 ?
+            Id::NovosDataAvailable : Id::NovosDataUnavailable;
+          while (pump.post(id) != gas::Posted::Queued)
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    size_t dispatched = 0;
+    while (dispatched < Producers * Count)
+    {
+      dispatched += pump.dispatch();
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+    EXPECT_EQ(Producers * Count, pump.counters().dispatched);
+    EXPECT_EQ(0u, pump.size());
+  }
+}
+#endif
+
+#if defined(_GOS_ASSUMPTION_BOOST_STATE_MACHINE_) && \
+  defined(_GOS_ASSUMPTION_TRACE_)
+TEST(boost_assumption, msm_trace)
+{
+  namespace trace = ::gos::assumption::trace;
+  trace::Tracer& tracer = trace::Tracer::instance();
+  tracer.drain([](const trace::Record&) {});
+
+  gas::StateEngine engine;
+  gas::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  engine.process_event(events::NovosDataAvailable());
+  engine.process_event(events::Granted());
+
+  std::vector<trace::Record> records;
+  tracer.drain([&](const trace::Record& record)
+  {
+    records.push_back(record);
+  });
+  ASSERT_EQ(4u, records.size());
+  EXPECT_EQ(trace::Kind::Entry, records[0].kind);
+  EXPECT_EQ(uint16_t(gas::Stage::Undefined), records[0].from);
+  EXPECT_EQ(uint16_t(gas::Stage::Starting), records[0].to);
+  EXPECT_EQ(uint16_t(gas::Stage::Starting), records[1].from);
+  EXPECT_EQ(uint16_t(gas::Stage::NoData), records[1].to);
+  EXPECT_EQ(uint16_t(gas::events::EventId::Started), records[1].event);
+  EXPECT_EQ(uint16_t(gas::Stage::NoItgData), records[2].to);
+  EXPECT_EQ(trace::Kind::NoTransition, records[3].kind);
+  EXPECT_EQ(uint16_t(gas::Stage::NoItgData), records[3].from);
+  EXPECT_EQ(uint16_t(gas::events::EventId::Granted), records[3].event);
+  EXPECT_EQ(gas::Stage::NoItgData, engine.GetStage());
+
+  std::ostringstream text;
+  {
+    trace::Writer writer(text, trace::Format::Text,
+      trace::Names{ gas::stage_name, gas::event_name });
+    writer.write(records[2]);
+  }
+  EXPECT_THAT(text.str(), ::testing::HasSubstr(
+    "entry NoData -> NoItgData on NovosDataAvailable"));
+}
+#endif
+
+#if defined(_GOS_ASSUMPTION_BOOST_STATE_MACHINE_) && \
+  defined(_GOS_ASSUMPTION_HISTOGRAM_)
+TEST(boost_assumption, msm_histogram)
+{
+  namespace gsm = ::gos::assumption::state_machine;
+  const uint16_t Hoist =
+    uint16_t(gas::Stage::HoistConstrainstActivityUnavailable);
+  const uint64_t Dwell = gsm::latencies().dwell(Hoist).count();
+
+  gas::StateEngine engine;
+  gas::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  engine.process_event(events::NovosDataAvailable());
+  engine.process_event(events::ItgDataAvailable());
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  engine.process_event(events::HoistConstrainstActivityBecomesAvailable());
+
+  const gos::assumption::histogram::Snapshot dwell =
+    gsm::latencies().dwell(Hoist);
+  EXPECT_EQ(Dwell + 1, dwell.count());
+  EXPECT_LE(1000000u, dwell.max());
+  EXPECT_LE(1u, gsm::latencies().latency(
+    uint16_t(gas::Stage::NoData), uint16_t(gas::Stage::NoItgData)).count());
+}
+#endif
+
 #ifdef _GOS_ASSUMPTION_BOOST_SYSTEM_
 void print(const boost::system::error_code& /*e*/,
   boost::asio::steady_timer* t, int* count)
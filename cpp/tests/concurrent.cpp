@@ -0,0 +1,241 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/concurrent.h>
+#include <gos/assumption/snapshot.h>
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::ConcurrentAssumption<float, FloatWrapper, FloatHolder>
+  ConcurrentFloatAssumption;
+typedef gos::assumption::SnapshotAssumption<float, FloatWrapper, FloatHolder>
+  SnapshotFloatAssumption;
+
+TEST(concurrent, sharding)
+{
+  ConcurrentFloatAssumption assumption(10);
+  EXPECT_EQ(16, assumption.shards());
+
+  const size_t Count = 1000;
+  ConcurrentFloatAssumption::Batch batch;
+  std::vector<size_t> used(assumption.shards(), 0);
+  for (size_t i = 0; i < Count; i++)
+  {
+    batch.push_back(ConcurrentFloatAssumption::Entry(std::to_string(i), 2));
+    used[assumption.index(batch.back().first)]++;
+  }
+  assumption.create_many(batch);
+  EXPECT_EQ(Count, assumption.size());
+  for (const size_t& count : used)
+  {
+    EXPECT_GT(count, 0);
+  }
+
+  EXPECT_TRUE(assumption.has("7"));
+  EXPECT_FALSE(assumption.has("missing"));
+  EXPECT_TRUE(assumption.set_value("7", 1, 7.5f));
+  EXPECT_FALSE(assumption.set_value("missing", 1, 7.5f));
+  EXPECT_FLOAT_EQ(7.5f, *assumption.value("7", 1));
+  EXPECT_FALSE(assumption.value("missing", 1).has_value());
+  EXPECT_FALSE(assumption.wrapper("7", 1)->is_set());
+  EXPECT_TRUE(assumption.set_wrapper("7", 1, FloatWrapper(2.5f)));
+  EXPECT_FLOAT_EQ(2.5f, assumption.wrapper("7", 1)->value());
+  EXPECT_TRUE(assumption.update("7",
+    [](ConcurrentFloatAssumption::Shard& shard,
+      const ConcurrentFloatAssumption::Handle& handle)
+    {
+      shard.value(handle, 0) = shard.value(handle, 1) * 2.0f;
+    }));
+  EXPECT_FLOAT_EQ(15.0f, *assumption.value("7", 0));
+  EXPECT_TRUE(assumption.remove("7"));
+  EXPECT_FALSE(assumption.has("7"));
+  EXPECT_EQ(Count - 1, assumption.size());
+
+  ConcurrentFloatAssumption single(1);
+  EXPECT_EQ(1, single.shards());
+  single.create("a", 1);
+  EXPECT_TRUE(single.has("a"));
+}
+
+TEST(concurrent, stress)
+{
+  const size_t Threads = 8;
+  const size_t Owned = 200;
+  const size_t Shared = 50;
+  const int Rounds = 20;
+  const ConcurrentFloatAssumption::Size Size = 4;
+
+  ConcurrentFloatAssumption assumption(16);
+  for (size_t i = 0; i < Shared; i++)
+  {
+    assumption.create("shared/" + std::to_string(i), Size);
+  }
+
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < Threads; t++)
+  {
+    threads.emplace_back([&, t]()
+    {
+      const std::string prefix = "thread/" + std::to_string(t) + "/";
+      for (int round = 0; round < Rounds; round++)
+      {
+        /* Ids owned by this thread are created, written, read and removed */
+        for (size_t i = 0; i < Owned; i++)
+        {
+          assumption.create(prefix + std::to_string(i), Size);
+        }
+        for (size_t i = 0; i < Owned; i++)
+        {
+          const float value = static_cast<float>(round * 1000 + i);
+          if (!assumption.set_value(prefix + std::to_string(i), 2, value))
+          {
+            failures++;
+          }
+        }
+        for (size_t i = 0; i < Owned; i++)
+        {
+          std::optional<float> value =
+            assumption.value(prefix + std::to_string(i), 2);
+          if (!value || *value != static_cast<float>(round * 1000 + i))
+          {
+            failures++;
+          }
+        }
+        /* Shared ids are incremented by every thread */
+        for (size_t i = 0; i < Shared; i++)
+        {
+          assumption.update("shared/" + std::to_string(i),
+            [](ConcurrentFloatAssumption::Shard& shard,
+              const ConcurrentFloatAssumption::Handle& handle)
+            {
+              shard.value(handle, 0) += 1.0f;
+            });
+        }
+        for (size_t i = 0; i < Owned; i += 2)
+        {
+          if (!assumption.remove(prefix + std::to_string(i)))
+          {
+            failures++;
+          }
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(0, failures.load());
+  EXPECT_EQ(Shared + Threads * Owned / 2, assumption.size());
+  for (size_t i = 0; i < Shared; i++)
+  {
+    EXPECT_FLOAT_EQ(static_cast<float>(Threads * Rounds),
+      *assumption.value("shared/" + std::to_string(i), 0));
+  }
+}
+
+TEST(concurrent, snapshot)
+{
+  SnapshotFloatAssumption registry(2);
+  SnapshotFloatAssumption::Reader reader = registry.reader();
+  SnapshotFloatAssumption::Reader other = registry.reader();
+  EXPECT_THROW(registry.reader(), std::length_error);
+
+  registry.create("a", 2);
+  {
+    SnapshotFloatAssumption::Snapshot snapshot = reader.snapshot();
+    EXPECT_EQ(1, snapshot.version());
+    EXPECT_TRUE(snapshot.has("a"));
+    const SnapshotFloatAssumption::Handle a = snapshot.resolve("a");
+    EXPECT_FALSE((std::is_convertible<
+      SnapshotFloatAssumption::Index, SnapshotFloatAssumption::Handle>::value));
+    EXPECT_EQ(2, snapshot.item(a).size());
+    EXPECT_FLOAT_EQ(0.0f, *snapshot.find_value("a", 1));
+    snapshot.item(a).values()[1] = 1.5f;
+
+    // A held snapshot keeps its version while new versions are published
+    registry.create("b", 3);
+    EXPECT_TRUE(registry.remove("a"));
+    EXPECT_FALSE(registry.remove("a"));
+    EXPECT_TRUE(snapshot.has("a"));
+    EXPECT_FALSE(snapshot.has("b"));
+    EXPECT_FLOAT_EQ(1.5f, *snapshot.find_value("a", 1));
+    EXPECT_EQ(2, registry.reclaim());
+
+    SnapshotFloatAssumption::Snapshot latest = other.snapshot();
+    EXPECT_EQ(3, latest.version());
+    EXPECT_FALSE(latest.has("a"));
+    EXPECT_TRUE(latest.has("b"));
+    EXPECT_EQ(nullptr, latest.find_wrapper("a", 0));
+    EXPECT_FALSE(latest.find_wrapper("b", 0)->is_set());
+  }
+  EXPECT_EQ(0, registry.reclaim());
+
+  SnapshotFloatAssumption::Batch batch;
+  for (int i = 0; i < 100; i++)
+  {
+    batch.push_back(SnapshotFloatAssumption::Entry(std::to_string(i), 1));
+  }
+  registry.create_many(batch);
+  EXPECT_EQ(101, reader.snapshot().size());
+  EXPECT_EQ(4, reader.snapshot().version());
+}
+
+TEST(concurrent, snapshot_stress)
+{
+  const size_t Readers = 4;
+  const int Versions = 300;
+
+  SnapshotFloatAssumption registry(Readers);
+  registry.create("anchor", 1);
+
+  std::atomic<bool> done(false);
+  std::atomic<size_t> failures(0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < Readers; t++)
+  {
+    threads.emplace_back([&]()
+    {
+      SnapshotFloatAssumption::Reader reader = registry.reader();
+      std::uint64_t last = 0;
+      while (!done.load())
+      {
+        SnapshotFloatAssumption::Snapshot snapshot = reader.snapshot();
+        /* Versions only move forward and every version holds the anchor
+         * and exactly the ids created before it */
+        if (snapshot.version() < last || !snapshot.has("anchor"))
+        {
+          failures++;
+        }
+        last = snapshot.version();
+        const size_t created = static_cast<size_t>(last) - 1;
+        if (snapshot.size() != created + 1 ||
+          (created > 0 && !snapshot.has(std::to_string(created - 1))) ||
+          snapshot.has(std::to_string(created)))
+        {
+          failures++;
+        }
+      }
+    });
+  }
+  for (int i = 0; i < Versions; i++)
+  {
+    registry.create(std::to_string(i), 1);
+  }
+  done.store(true);
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(0, failures.load());
+  EXPECT_EQ(0, registry.reclaim());
+}
@@ -0,0 +1,230 @@
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/endian.h>
+#include <gos/assumption/view.h>
+
+namespace endian = ::gos::assumption::endian;
+
+typedef std::vector<unsigned char> Bytes;
+
+/* The bytes of count values of a width each reversed one byte at a time */
+static Bytes reversed(const Bytes& bytes, const size_t& width)
+{
+  Bytes result(bytes.size());
+  for (size_t i = 0; i + width <= bytes.size(); i += width)
+  {
+    for (size_t j = 0; j < width; j++)
+    {
+      result[i + j] = bytes[i + width - 1 - j];
+    }
+  }
+  return result;
+}
+
+static Bytes pattern(const size_t& size)
+{
+  Bytes bytes(size);
+  for (size_t i = 0; i < size; i++)
+  {
+    bytes[i] = static_cast<unsigned char>(i * 7 + 3);
+  }
+  return bytes;
+}
+
+template<typename T> static void expect_kernel(const endian::Kernel& kernel)
+{
+  const size_t Offsets = 8;
+  for (size_t count = 0; count < 130; count++)
+  {
+    const size_t size = count * sizeof(T);
+    const Bytes source = pattern(size + Offsets);
+    for (size_t offset = 0; offset < Offsets; offset++)
+    {
+      // Unaligned source and destination
+      const Bytes input(
+        source.begin() + offset, source.begin() + offset + size);
+      const Bytes expected = reversed(input, sizeof(T));
+      Bytes destination(size + Offsets, 0);
+      endian::swap<T>(
+        destination.data() + offset, source.data() + offset, count, kernel);
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+        destination.begin() + offset)) << count << " " << offset;
+
+      // In place
+      Bytes inplace = source;
+      endian::swap<T>(
+        inplace.data() + offset, inplace.data() + offset, count, kernel);
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+        inplace.begin() + offset)) << count << " " << offset;
+    }
+  }
+}
+
+TEST(endian, detect)
+{
+  EXPECT_TRUE(endian::supports(endian::Kernel::Scalar));
+  EXPECT_TRUE(endian::supports(endian::kernel()));
+  EXPECT_EQ(endian::kernel(), endian::kernel());
+}
+
+TEST(endian, kernels)
+{
+  const endian::Kernel Kernels[] =
+    { endian::Kernel::Scalar, endian::Kernel::Ssse3, endian::Kernel::Avx2 };
+  for (const endian::Kernel& kernel : Kernels)
+  {
+    if (!endian::supports(kernel))
+    {
+      continue;
+    }
+    expect_kernel<std::uint16_t>(kernel);
+    expect_kernel<std::uint32_t>(kernel);
+    expect_kernel<std::uint64_t>(kernel);
+  }
+}
+
+TEST(endian, order)
+{
+  unsigned char buffer[8];
+
+  endian::store_big_endian<std::uint32_t>(buffer, 0x01020304u);
+  EXPECT_EQ(0x01, buffer[0]);
+  EXPECT_EQ(0x04, buffer[3]);
+  EXPECT_EQ(0x01020304u, endian::load_big_endian<std::uint32_t>(buffer));
+  EXPECT_EQ(0x04030201u, endian::load_little_endian<std::uint32_t>(buffer));
+
+  endian::store_little_endian<std::uint32_t>(buffer, 0x01020304u);
+  EXPECT_EQ(0x04, buffer[0]);
+  EXPECT_EQ(0x01, buffer[3]);
+
+  endian::store_big_endian<std::int16_t>(buffer, -2);
+  EXPECT_EQ(0xff, buffer[0]);
+  EXPECT_EQ(0xfe, buffer[1]);
+  EXPECT_EQ(-2, endian::load_big_endian<std::int16_t>(buffer));
+
+  // IEEE 754 1.0 is 3f800000
+  endian::store_big_endian<float>(buffer, 1.0f);
+  EXPECT_EQ(0x3f, buffer[0]);
+  EXPECT_EQ(0x80, buffer[1]);
+  EXPECT_FLOAT_EQ(1.0f, endian::load_big_endian<float>(buffer));
+
+  endian::store_big_endian<double>(buffer, -2.5);
+  EXPECT_EQ(0xc0, buffer[0]);
+  EXPECT_DOUBLE_EQ(-2.5, endian::load_big_endian<double>(buffer));
+}
+
+TEST(endian, arrays)
+{
+  const size_t Count = 1001;
+  std::vector<float> floats(Count);
+  std::vector<double> doubles(Count);
+  for (size_t i = 0; i < Count; i++)
+  {
+    floats[i] = static_cast<float>(i) * 0.25f - 100.0f;
+    doubles[i] = static_cast<double>(i) * -1.5 + 0.125;
+  }
+
+  // One byte in so the buffer is never aligned
+  std::vector<unsigned char> buffer(1 + Count * sizeof(double));
+  unsigned char* unaligned = buffer.data() + 1;
+
+  void* end = endian::store_big_endian_array(unaligned, floats.data(), Count);
+  EXPECT_EQ(unaligned + Count * sizeof(float), end);
+  for (size_t i = 0; i < Count; i += 100)
+  {
+    EXPECT_FLOAT_EQ(floats[i],
+      endian::load_big_endian<float>(unaligned + i * sizeof(float)));
+  }
+  std::vector<float> loaded(Count);
+  end = endian::load_big_endian_array(unaligned, loaded.data(), Count);
+  EXPECT_EQ(unaligned + Count * sizeof(float), end);
+  EXPECT_EQ(floats, loaded);
+
+  // Loading in the other order reverses the bytes of every value
+  endian::load_little_endian_array(unaligned, loaded.data(), Count);
+  Bytes native(Count * sizeof(float));
+  std::memcpy(native.data(), floats.data(), native.size());
+  Bytes other(Count * sizeof(float));
+  std::memcpy(other.data(), loaded.data(), other.size());
+  EXPECT_EQ(reversed(native, sizeof(float)), other);
+
+  endian::store_little_endian_array(unaligned, doubles.data(), Count);
+  std::vector<double> little(Count);
+  endian::load_little_endian_array(unaligned, little.data(), Count);
+  EXPECT_EQ(doubles, little);
+  endian::store_big_endian_array(unaligned, doubles.data(), Count);
+  std::vector<double> big(Count);
+  endian::load_big_endian_array(unaligned, big.data(), Count);
+  EXPECT_EQ(doubles, big);
+}
+
+TEST(endian, view)
+{
+  const size_t Count = 257;
+  std::vector<std::int32_t> values(Count);
+  for (size_t i = 0; i < Count; i++)
+  {
+    values[i] = static_cast<std::int32_t>(i * 11) - 1000;
+  }
+  std::vector<unsigned char> buffer(1 + Count * sizeof(std::int32_t) + 3);
+  unsigned char* unaligned = buffer.data() + 1;
+  endian::store_big_endian_array(unaligned, values.data(), Count);
+
+  typedef endian::View<std::int32_t, endian::Order::Big> View;
+  const View view(unaligned, Count);
+  EXPECT_EQ(Count, view.size());
+  EXPECT_FALSE(view.empty());
+  EXPECT_EQ(values[0], view[0]);
+  EXPECT_EQ(values[Count - 1], view[Count - 1]);
+  EXPECT_EQ(values[100], view.at(100));
+  EXPECT_THROW(view.at(Count), std::out_of_range);
+
+  // Random access iteration
+  EXPECT_EQ(static_cast<std::ptrdiff_t>(Count), view.end() - view.begin());
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), view.begin()));
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0LL),
+    std::accumulate(view.begin(), view.end(), 0LL));
+  View::Iterator found = std::lower_bound(view.begin(), view.end(), 0);
+  EXPECT_EQ(values[found - view.begin()], *found);
+  EXPECT_LE(0, *found);
+  EXPECT_GT(0, found[-1]);
+  EXPECT_EQ(values[10], *(view.begin() + 10));
+  EXPECT_EQ(values[Count - 2], *(view.end() - 2));
+
+  const View part = view.subview(5, 10);
+  EXPECT_EQ(10u, part.size());
+  EXPECT_EQ(values[5], part[0]);
+  std::vector<std::int32_t> copied(10);
+  view.copy(copied.data(), 5, 10);
+  EXPECT_TRUE(std::equal(copied.begin(), copied.end(), values.begin() + 5));
+
+  // The same bytes seen as little endian are reversed
+  const endian::View<std::int32_t, endian::Order::Little> little(
+    unaligned, Count);
+  EXPECT_EQ(endian::load_little_endian<std::int32_t>(unaligned), little[0]);
+
+  // Writes through a mutable view encode in place
+  endian::MutableView<std::int32_t, endian::Order::Big> mutable_view(
+    unaligned, Count);
+  mutable_view[3] = 123456;
+  EXPECT_EQ(123456, view[3]);
+  EXPECT_EQ(123456, endian::load_big_endian<std::int32_t>(
+    unaligned + 3 * sizeof(std::int32_t)));
+  mutable_view[4] = mutable_view[3];
+  EXPECT_EQ(123456, mutable_view.get(4));
+  mutable_view.set(5, -7);
+  EXPECT_EQ(-7, mutable_view.view()[5]);
+  const std::int32_t Assigned[] = { 1, 2, 3 };
+  mutable_view.assign(Assigned, 0, 3);
+  EXPECT_EQ(1, view[0]);
+  EXPECT_EQ(3, view[2]);
+}
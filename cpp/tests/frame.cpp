@@ -0,0 +1,108 @@
+#include <cstdint>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/frame.h>
+
+typedef gos::assumption::Frame Frame;
+typedef gos::assumption::FramePool FramePool;
+
+TEST(frame, pool)
+{
+  FramePool pool(2, 100);
+  EXPECT_EQ(2u, pool.available());
+  Frame first = pool.acquire();
+  ASSERT_TRUE(first);
+  EXPECT_EQ(100u, first.capacity());
+  EXPECT_EQ(0u, first.size());
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first.data()) % 64);
+  Frame second = pool.acquire();
+  EXPECT_TRUE(second);
+  EXPECT_NE(first.data(), second.data());
+  EXPECT_TRUE(pool.acquire().empty());
+  EXPECT_EQ(0u, pool.available());
+
+  first = Frame();
+  EXPECT_EQ(1u, pool.available());
+  Frame third = pool.acquire();
+  EXPECT_TRUE(third);
+  EXPECT_EQ(0u, third.sequence());
+
+  Frame empty;
+  EXPECT_EQ(0u, empty.size());
+  EXPECT_EQ(0u, empty.references());
+}
+
+TEST(frame, references)
+{
+  FramePool pool(1, 64);
+  {
+    Frame frame = pool.acquire();
+    gos::assumption::Span<float> values = frame.values<float>(4);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      values[i] = 0.5f * i;
+    }
+    frame.sequence(7);
+    EXPECT_EQ(16u, frame.size());
+
+    /* Copies share the buffer, moves take the reference */
+    Frame copy = frame;
+    EXPECT_EQ(2u, frame.references());
+    EXPECT_EQ(frame.data(), copy.data());
+    Frame moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(2u, moved.references());
+    const gos::assumption::Span<const float> read = moved.values<float>();
+    ASSERT_EQ(4u, read.size());
+    EXPECT_FLOAT_EQ(1.5f, read[3]);
+    EXPECT_EQ(7u, moved.sequence());
+    EXPECT_EQ(0u, pool.available());
+  }
+  EXPECT_EQ(1u, pool.available());
+}
+
+TEST(frame, threads)
+{
+  /* Readers on many threads release the frames, the producer reuses them */
+  const size_t Readers = 4;
+  const uint64_t Count = 2000;
+  FramePool pool(8, 256);
+  uint64_t sum = 0;
+  std::vector<uint64_t> sums(Readers, 0);
+  for (uint64_t i = 1; i <= Count; i++)
+  {
+    Frame frame = pool.acquire();
+    while (frame.empty())
+    {
+      std::this_thread::yield();
+      frame = pool.acquire();
+    }
+    frame.values<uint64_t>(32)[31] = i;
+    sum += i * Readers;
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < Readers; r++)
+    {
+      threads.emplace_back([frame, r, &sums]()
+      {
+        sums[r] += frame.values<uint64_t>()[31];
+      });
+    }
+    frame = Frame();
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+  }
+  uint64_t total = 0;
+  for (const uint64_t& value : sums)
+  {
+    total += value;
+  }
+  EXPECT_EQ(sum, total);
+  EXPECT_EQ(8u, pool.available());
+}
@@ -6,11 +6,14 @@
 #include <chrono>
 #include <locale>
 #include <string>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
 #include <gos/assumption.h>
+#include <gos/assumption/columnar.h>
+#include <gos/assumption/polymorphic.h>
 
 #define _GOS_ASSUMPTION_TEST_EXPECTED_BOOL_SIZE 1
 #define _GOS_ASSUMPTION_TEST_EXPECTED_FLOAT_SIZE 4
@@ -61,6 +64,9 @@ TEST(assumption, defaulting)
   EXPECT_DOUBLE_EQ(double(), wrapper.value());
 }
 
+/* The concrete wrappers and holders only implement the virtual interfaces
+ * when the fast mode is off */
+#if !defined(_GOS_ASSUMPTION_FAST_)
 // Moving object from one object to another
 TEST(assumption, moving)
 {
@@ -120,6 +126,8 @@ TEST(assumption, entrust)
   EXPECT_TRUE((bool)b);
 }
 
+#endif
+
 TEST(assumption, reference)
 {
   typedef gos::assumption::Wrapper<double> Wrapper;
@@ -153,6 +161,19 @@ void CreateUnique(
   assumption.unique(assumptionarray, wrapperarray, holder);
 }
 
+void InsertItems(
+  FloatWrapperHolderAssumption& assumption,
+  const FloatWrapperHolderAssumption::Id& id,
+  const FloatWrapperHolderAssumption::Size& size)
+{
+  FloatWrapperHolderAssumption::Array a = std::make_unique<float[]>(size);
+  FloatWrapperHolderAssumption::WrapperArray wrapper =
+    std::make_unique<FloatWrapper[]>(size);
+  FloatWrapperHolderAssumption::HolderPtr holder =
+    std::make_unique<FloatHolder>(size);
+  assumption.insert(id, a, wrapper, holder);
+}
+
 TEST(assumption, unique)
 {
   typedef float Value;
@@ -227,6 +248,381 @@ TEST(assumption, unique)
   EXPECT_EQ(float(), w.value());  // Should be equal to 0.0f
 }
 
+TEST(assumption, insert)
+{
+  typedef FloatWrapperHolderAssumption::Array Array;
+  typedef FloatWrapperHolderAssumption::WrapperArray WrapperArray;
+  typedef FloatWrapperHolderAssumption::HolderPtr HolderPtr;
+  typedef FloatWrapperHolderAssumption::Id Id;
+
+  const size_t Count = 1000;
+  const FloatWrapperHolderAssumption::Size Size = 4;
+
+  FloatWrapperHolderAssumption assumption;
+  for (size_t i = 0; i < Count; i++)
+  {
+    Array a = std::make_unique<float[]>(Size);
+    WrapperArray wrapper = std::make_unique<FloatWrapper[]>(Size);
+    HolderPtr holder = std::make_unique<FloatHolder>(Size);
+    /* Non-zero so the wrapper is set with every set check */
+    a[1] = static_cast<float>(i + 1);
+    wrapper[2] = FloatWrapper(static_cast<float>(i + 1));
+    assumption.insert(std::to_string(i), a, wrapper, holder);
+    EXPECT_FALSE((bool)a);
+    EXPECT_FALSE((bool)wrapper);
+    EXPECT_FALSE((bool)holder);
+  }
+  EXPECT_EQ(Count, assumption.size());
+
+  for (size_t i = 0; i < Count; i++)
+  {
+    const Id id = std::to_string(i);
+    EXPECT_TRUE(assumption.has(id));
+    EXPECT_FLOAT_EQ(static_cast<float>(i + 1), assumption.value(id, 1));
+    EXPECT_TRUE(assumption.wrapper(id, 2).is_set());
+    EXPECT_FLOAT_EQ(
+      static_cast<float>(i + 1), assumption.wrapper(id, 2).value());
+    EXPECT_FALSE(assumption.wrapper(id, 3).is_set());
+    EXPECT_EQ(Size, assumption.holder(id).size());
+  }
+  EXPECT_FALSE(assumption.has(std::to_string(Count)));
+  EXPECT_FALSE(assumption.has(Id()));
+
+  // Inserting an existing id replaces its items
+  Array a = std::make_unique<float[]>(Size);
+  WrapperArray wrapper = std::make_unique<FloatWrapper[]>(Size);
+  HolderPtr holder = std::make_unique<FloatHolder>(Size);
+  a[1] = -1.0f;
+  assumption.insert("7", a, wrapper, holder);
+  EXPECT_EQ(Count, assumption.size());
+  EXPECT_FLOAT_EQ(-1.0f, assumption.value("7", 1));
+  EXPECT_FALSE(assumption.wrapper("7", 2).is_set());
+}
+
+TEST(assumption, handle)
+{
+  typedef FloatWrapperHolderAssumption::Handle Handle;
+  typedef FloatWrapperHolderAssumption::Id Id;
+
+  const FloatWrapperHolderAssumption::Size Size = 4;
+
+  FloatWrapperHolderAssumption assumption;
+  EXPECT_EQ(FloatWrapperHolderAssumption::NoHandle, assumption.resolve("a"));
+
+  InsertItems(assumption, "a", Size);
+  InsertItems(assumption, "b", Size);
+  InsertItems(assumption, "c", Size);
+
+  // Resolve from a literal, a string and a view into a larger string
+  const Handle a = assumption.resolve("a");
+  const Handle b = assumption.resolve(Id("b"));
+  const std::string text("abc");
+  const Handle c = assumption.resolve(std::string_view(text).substr(2, 1));
+  EXPECT_NE(FloatWrapperHolderAssumption::NoHandle, a);
+  EXPECT_NE(FloatWrapperHolderAssumption::NoHandle, b);
+  EXPECT_NE(FloatWrapperHolderAssumption::NoHandle, c);
+  EXPECT_NE(a, b);
+  EXPECT_NE(b, c);
+
+  // A handle is a type of its own, an index does not convert to one
+  EXPECT_FALSE((std::is_convertible<
+    FloatWrapperHolderAssumption::Index, Handle>::value));
+
+  assumption.value(a, 1) = 1.0f;
+  assumption.wrapper(b, 2) = FloatWrapper(2.0f);
+  EXPECT_FLOAT_EQ(1.0f, assumption.value("a", 1));
+  EXPECT_TRUE(assumption.wrapper("b", 2).is_set());
+  EXPECT_EQ(&assumption.holder("c"), &assumption.holder(c));
+
+  // Handles of other ids stay valid when an id is removed or added
+  float& value = assumption.value(c, 3);
+  EXPECT_TRUE(assumption.remove("b"));
+  EXPECT_FALSE(assumption.remove("b"));
+  EXPECT_FALSE(assumption.has("b"));
+  EXPECT_EQ(FloatWrapperHolderAssumption::NoHandle, assumption.resolve("b"));
+  for (int i = 0; i < 100; i++)
+  {
+    InsertItems(assumption, std::to_string(i), Size);
+  }
+  EXPECT_EQ(102, assumption.size());
+  EXPECT_EQ(a, assumption.resolve("a"));
+  EXPECT_EQ(c, assumption.resolve("c"));
+  EXPECT_EQ(&value, &assumption.value(c, 3));
+  EXPECT_FLOAT_EQ(1.0f, assumption.value(a, 1));
+  for (int i = 0; i < 100; i += 2)
+  {
+    EXPECT_TRUE(assumption.remove(std::to_string(i)));
+  }
+  for (int i = 0; i < 100; i++)
+  {
+    EXPECT_EQ(i % 2 == 1, assumption.has(std::to_string(i)));
+  }
+  EXPECT_EQ(52, assumption.size());
+}
+
+TEST(assumption, create)
+{
+  typedef FloatWrapperHolderAssumption::Batch Batch;
+  typedef FloatWrapperHolderAssumption::Entry Entry;
+
+  FloatWrapperHolderAssumption assumption;
+  assumption.create("single", 3);
+  EXPECT_TRUE(assumption.has("single"));
+  EXPECT_EQ(3, assumption.holder("single").size());
+  EXPECT_FLOAT_EQ(0.0f, assumption.value("single", 2));
+  EXPECT_FALSE(assumption.wrapper("single", 2).is_set());
+
+  const size_t Count = 10000;
+  Batch batch;
+  for (size_t i = 0; i < Count; i++)
+  {
+    batch.push_back(Entry(std::to_string(i), 1 + i % 5));
+  }
+  assumption.create_many(batch);
+  EXPECT_EQ(Count + 1, assumption.size());
+
+  // The arrays of a batch come from one block and do not overlap
+  for (size_t i = 0; i < Count; i++)
+  {
+    const std::string id = std::to_string(i);
+    const FloatWrapperHolderAssumption::Size size = 1 + i % 5;
+    EXPECT_EQ(size, assumption.holder(id).size());
+    for (FloatWrapperHolderAssumption::Index j = 0; j < size; j++)
+    {
+      EXPECT_FLOAT_EQ(0.0f, assumption.value(id, j));
+      EXPECT_FALSE(assumption.wrapper(id, j).is_set());
+      assumption.value(id, j) = static_cast<float>(i * 10 + j);
+    }
+  }
+  for (size_t i = 0; i < Count; i++)
+  {
+    const std::string id = std::to_string(i);
+    for (FloatWrapperHolderAssumption::Index j = 0; j < 1 + i % 5; j++)
+    {
+      EXPECT_FLOAT_EQ(static_cast<float>(i * 10 + j), assumption.value(id, j));
+    }
+  }
+  EXPECT_EQ(
+    &assumption.value("0", 0) + 1, &assumption.value("1", 0));
+
+  // Removing an id from a block leaves the other ids untouched
+  EXPECT_TRUE(assumption.remove("1"));
+  EXPECT_FLOAT_EQ(20.0f, assumption.value("2", 0));
+  assumption.create("1", 2);
+  EXPECT_FLOAT_EQ(0.0f, assumption.value("1", 0));
+
+  // The unique id can be created in a populated object
+  FloatWrapperHolderAssumption::Array a;
+  FloatWrapperHolderAssumption::WrapperArray wrapper;
+  FloatWrapperHolderAssumption::HolderPtr holder;
+  assumption.unique(a, wrapper, holder);
+  EXPECT_TRUE(assumption.has(assumption.UniqueId));
+  EXPECT_EQ(Count + 2, assumption.size());
+}
+
+TEST(assumption, columnar)
+{
+  typedef gos::assumption::ColumnarAssumption<float> Columns;
+  typedef Columns::Handle Handle;
+  typedef gos::assumption::Span<float> Span;
+
+  // A handle is a type of its own, an index does not convert to one
+  EXPECT_FALSE((std::is_convertible<Columns::Index, Handle>::value));
+
+  Columns columns;
+  Columns::Batch batch;
+  for (int i = 0; i < 100; i++)
+  {
+    batch.push_back(Columns::Entry(std::to_string(i), 3));
+  }
+  columns.create_many(batch);
+  columns.create("extra", 70);
+  EXPECT_EQ(101, columns.size());
+  EXPECT_EQ(370, columns.arena().size());
+  EXPECT_EQ(6, columns.bitmap().size());
+
+  const Handle h = columns.resolve("42");
+  ASSERT_NE(Columns::NoHandle, h);
+  EXPECT_EQ(42 * 3, columns.offset(h));
+  EXPECT_FALSE(columns.is_set(h, 1));
+  EXPECT_FALSE(columns.wrapper(h, 1).is_set());
+  columns.set(h, 1, 4.2f);
+  EXPECT_TRUE(columns.is_set(h, 1));
+  EXPECT_FALSE(columns.is_set(h, 0));
+  EXPECT_TRUE(columns.wrapper(h, 1).is_set());
+  EXPECT_FLOAT_EQ(4.2f, columns.wrapper(h, 1).value());
+
+  // The slice of an id is a span into the arena
+  Span span = columns.values("42");
+  EXPECT_EQ(3, span.size());
+  EXPECT_FLOAT_EQ(4.2f, span[1]);
+  EXPECT_EQ(columns.arena().data() + 42 * 3, span.data());
+  span[2] = 1.0f;
+  EXPECT_FLOAT_EQ(1.0f, columns.arena()[42 * 3 + 2]);
+  EXPECT_TRUE(columns.values("missing").empty());
+
+  // Set flags beyond the first bitmap word
+  const Handle extra = columns.resolve("extra");
+  columns.set(extra, 69, 6.9f);
+  EXPECT_TRUE(columns.is_set(extra, 69));
+  EXPECT_EQ(Columns::Word(1) << (369 % 64), columns.bitmap()[5]);
+
+  float sum = 0.0f;
+  for (const float& value : columns.arena())
+  {
+    sum += value;
+  }
+  EXPECT_FLOAT_EQ(4.2f + 1.0f + 6.9f, sum);
+
+  columns.reset(h, 1);
+  EXPECT_FALSE(columns.is_set(h, 1));
+  EXPECT_FLOAT_EQ(0.0f, columns.values(h)[1]);
+
+  EXPECT_TRUE(columns.remove("extra"));
+  EXPECT_FALSE(columns.has("extra"));
+  EXPECT_EQ(0, columns.bitmap()[5]);
+  EXPECT_FLOAT_EQ(0.0f, columns.arena()[369]);
+  EXPECT_EQ(h, columns.resolve("42"));
+}
+
+TEST(assumption, columnar_churn)
+{
+  typedef gos::assumption::ColumnarAssumption<float> Columns;
+
+  const int Count = 100;
+  Columns columns;
+  for (int i = 0; i < Count; i++)
+  {
+    columns.create(std::to_string(i), 4);
+  }
+  const size_t arena = columns.arena().size();
+  EXPECT_EQ(4u * Count, arena);
+
+  // Removed slices are reused zeroed and unset, created again ids keep theirs
+  for (int round = 0; round < 100; round++)
+  {
+    for (int i = 0; i < Count; i += 2)
+    {
+      const Columns::Handle h = columns.resolve(std::to_string(i));
+      columns.set(h, 3, 1.0f);
+      EXPECT_TRUE(columns.remove(std::to_string(i)));
+    }
+    for (int i = 0; i < Count; i += 2)
+    {
+      columns.create(std::to_string(i), 4);
+      const Columns::Handle h = columns.resolve(std::to_string(i));
+      EXPECT_FALSE(columns.is_set(h, 3));
+      EXPECT_FLOAT_EQ(0.0f, columns.values(h)[3]);
+    }
+    for (int i = 1; i < Count; i += 2)
+    {
+      columns.create(std::to_string(i), 4);
+    }
+  }
+  EXPECT_EQ(arena, columns.arena().size());
+  EXPECT_EQ(0u, columns.available());
+
+  // A smaller size keeps the slice and frees its tail, merged when adjacent
+  const size_t offset = columns.offset(columns.resolve("10"));
+  columns.create("10", 1);
+  EXPECT_EQ(offset, columns.offset(columns.resolve("10")));
+  EXPECT_EQ(3u, columns.available());
+  EXPECT_TRUE(columns.remove("11"));
+  EXPECT_EQ(7u, columns.available());
+  columns.create("11", 7);
+  EXPECT_EQ(offset + 1, columns.offset(columns.resolve("11")));
+  EXPECT_EQ(0u, columns.available());
+
+  // Sizes that change with every round stay bounded
+  for (int round = 0; round < 100; round++)
+  {
+    for (int i = 0; i < Count; i++)
+    {
+      columns.remove(std::to_string((i * 7 + round) % Count));
+      columns.create(std::to_string((i * 7 + round) % Count),
+        static_cast<Columns::Size>(1 + (i + round) % 4));
+    }
+  }
+  EXPECT_EQ(Count, columns.size());
+  EXPECT_GE(2 * arena, columns.arena().size());
+}
+
+TEST(assumption, static_interfaces)
+{
+  typedef gos::assumption::Holder<FloatWrapper> WrapperHolder;
+  using gos::interfaces::IsWrapper;
+  using gos::interfaces::IsHolder;
+  using gos::interfaces::IsArrayHolder;
+  using gos::interfaces::IsAssumption;
+
+  EXPECT_TRUE((IsWrapper<FloatWrapper, float>::value));
+  EXPECT_TRUE((IsHolder<WrapperHolder, FloatWrapper>::value));
+  EXPECT_TRUE((IsArrayHolder<FloatHolder, FloatWrapper>::value));
+  EXPECT_TRUE((IsAssumption<
+    FloatWrapperHolderAssumption, float, FloatWrapper, FloatHolder>::value));
+  EXPECT_FALSE((IsWrapper<FloatHolder, float>::value));
+  EXPECT_FALSE((IsArrayHolder<FloatWrapper, FloatWrapper>::value));
+  EXPECT_FALSE((IsAssumption<
+    FloatWrapperHolderAssumption, double, FloatWrapper, FloatHolder>::value));
+
+#if defined(_GOS_ASSUMPTION_FAST_)
+  // No virtual tables so a wrapper is as small as its members
+  EXPECT_TRUE(std::is_final<FloatWrapper>::value);
+  EXPECT_TRUE(std::is_final<FloatHolder>::value);
+  EXPECT_TRUE(std::is_final<FloatWrapperHolderAssumption>::value);
+  EXPECT_FALSE(std::is_polymorphic<FloatWrapper>::value);
+  EXPECT_FALSE(std::is_polymorphic<WrapperHolder>::value);
+  EXPECT_FALSE(std::is_polymorphic<FloatHolder>::value);
+  EXPECT_EQ(sizeof(FloatWrapper*), sizeof(WrapperHolder));
+#else
+  EXPECT_TRUE(std::is_polymorphic<FloatWrapper>::value);
+  EXPECT_TRUE(std::is_polymorphic<FloatHolder>::value);
+#endif
+}
+
+TEST(assumption, polymorphic)
+{
+  typedef gos::interfaces::Assumption<float, FloatWrapper, FloatHolder>
+    Interface;
+  typedef gos::assumption::PolymorphicAssumption<
+    float, FloatWrapper, FloatHolder> PolymorphicAssumption;
+  typedef gos::assumption::PolymorphicWrapper<float> PolymorphicWrapper;
+  typedef gos::assumption::PolymorphicArrayHolder<FloatWrapper>
+    PolymorphicArrayHolder;
+  typedef gos::assumption::PolymorphicHolder<double> PolymorphicHolder;
+
+  const FloatWrapperHolderAssumption::Size Size = 4;
+
+  FloatWrapperHolderAssumption assumption;
+  assumption.create("id", Size);
+  assumption.wrapper("id", 1) = FloatWrapper(1.5f);
+
+  PolymorphicAssumption adapter(assumption);
+  Interface& interface = adapter;
+  EXPECT_TRUE(interface.has("id"));
+  EXPECT_FALSE(interface.has("other"));
+  interface.value("id", 2) = 2.5f;
+  EXPECT_FLOAT_EQ(2.5f, assumption.value("id", 2));
+
+  PolymorphicWrapper wrapper(interface.wrapper("id", 1));
+  const gos::interfaces::Wrapper<float>& w = wrapper;
+  EXPECT_TRUE(w.is_set());
+  EXPECT_FLOAT_EQ(1.5f, w.value());
+
+  PolymorphicArrayHolder holder(interface.holder(interface.resolve("id")));
+  gos::interfaces::ArrayHolder<FloatWrapper>& h = holder;
+  EXPECT_EQ(Size, h.size());
+  h.get(3) = FloatWrapper(3.5f);
+  EXPECT_FLOAT_EQ(3.5f, assumption.holder("id").get(3).value());
+
+  double value = 1.0;
+  gos::assumption::Holder<double> concrete(value);
+  PolymorphicHolder polymorphic(concrete);
+  gos::interfaces::ReferencableHolder<double>& r = polymorphic;
+  r.reference() = 2.0;
+  EXPECT_DOUBLE_EQ(2.0, value);
+}
+
 TEST(assumption, uniquearray)
 {
   typedef float Value;
@@ -0,0 +1,104 @@
+#include <cstdint>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/histogram.h>
+
+namespace gah = ::gos::assumption::histogram;
+
+namespace
+{
+
+const char* name(const uint16_t& stage)
+{
+  static const char* Names[] = { "A", "B", "C" };
+  return Names[stage];
+}
+
+} /* namespace */
+
+TEST(histogram, buckets)
+{
+  /* Every value is in a bucket whose upper value is within 1/32 above */
+  uint64_t previous = 0;
+  for (uint64_t value = 0; value < (uint64_t(1) << 41); value += value / 7 + 1)
+  {
+    const size_t index = gah::bucket(value);
+    ASSERT_LT(index, gah::Buckets);
+    EXPECT_LE(previous, index);
+    previous = index;
+    if (value < (uint64_t(1) << gah::RangeBits))
+    {
+      EXPECT_LE(value, gah::upper(index)) << value;
+      EXPECT_LE(gah::upper(index) - value, value / 32) << value;
+    }
+  }
+  for (size_t index = 0; index < gah::Buckets; index++)
+  {
+    EXPECT_EQ(index, gah::bucket(gah::upper(index))) << index;
+  }
+  EXPECT_EQ(gah::Buckets - 1, gah::bucket(uint64_t(1) << 50));
+}
+
+TEST(histogram, percentiles)
+{
+  gah::Histogram histogram;
+  for (uint64_t value = 1; value <= 10000; value++)
+  {
+    histogram.record(value);
+  }
+  const gah::Snapshot snapshot = histogram.snapshot();
+  EXPECT_EQ(10000u, snapshot.count());
+  EXPECT_EQ(10000u, snapshot.max());
+  EXPECT_DOUBLE_EQ(5000.5, snapshot.mean());
+  EXPECT_NEAR(5000, snapshot.percentile(0.5), 5000 / 32);
+  EXPECT_NEAR(9900, snapshot.percentile(0.99), 9900 / 32);
+  EXPECT_EQ(10000u, snapshot.percentile(1.0));
+  EXPECT_EQ(1u, snapshot.percentile(0.0));
+  EXPECT_EQ(0u, gah::Snapshot().percentile(0.5));
+}
+
+TEST(histogram, threads)
+{
+  gah::Latencies latencies(3);
+  const size_t Threads = 4;
+  const uint64_t Count = 10000;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < Threads; t++)
+  {
+    threads.emplace_back([&latencies, t, Count]()
+    {
+      for (uint64_t i = 0; i < Count; i++)
+      {
+        latencies.record(0, uint16_t(1 + t % 2), 100 * (t + 1));
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(2 * Count, latencies.latency(0, 1).count());
+  EXPECT_EQ(2 * Count, latencies.latency(0, 2).count());
+  EXPECT_EQ(0u, latencies.latency(1, 0).count());
+  const gah::Snapshot dwell = latencies.dwell(0);
+  EXPECT_EQ(Threads * Count, dwell.count());
+  EXPECT_EQ(400u, dwell.max());
+  EXPECT_DOUBLE_EQ(250.0, dwell.mean());
+  EXPECT_EQ(0u, latencies.dwell(1).count());
+
+  /* Codes out of range are ignored */
+  latencies.record(3, 0, 1);
+  EXPECT_EQ(0u, latencies.latency(3, 0).count());
+
+  std::ostringstream text;
+  latencies.dump(text, name);
+  EXPECT_THAT(text.str(), ::testing::HasSubstr("A->B 20000 "));
+  EXPECT_THAT(text.str(), ::testing::HasSubstr("A->C 20000 "));
+  EXPECT_THAT(text.str(), ::testing::HasSubstr("\nA 40000 250 "));
+}
@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/image.h>
+
+namespace gai = ::gos::assumption::image;
+
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+namespace
+{
+
+std::string image_path(const char* name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/* Ids of sizes 0 to 99 with every third wrapper set */
+void fill(FloatWrapperHolderAssumption& assumption)
+{
+  FloatWrapperHolderAssumption::Batch batch;
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    batch.emplace_back("id" + std::to_string(i), i);
+  }
+  assumption.create_many(batch);
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    const FloatWrapperHolderAssumption::Handle handle =
+      assumption.resolve("id" + std::to_string(i));
+    for (unsigned int j = 0; j < i; j++)
+    {
+      assumption.value(handle, j) = 0.5f * i + j;
+      if (j % 3 == 0)
+      {
+        assumption.wrapper(handle, j) = FloatWrapper(1.0f * i - j);
+      }
+    }
+  }
+}
+
+void corrupt(const std::string& path, const std::streamoff& at)
+{
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(at);
+  const char byte = 0x55;
+  file.write(&byte, 1);
+}
+
+} /* namespace */
+
+TEST(image, mapped)
+{
+  const std::string path = image_path("gos_assumption_image_mapped");
+  FloatWrapperHolderAssumption assumption;
+  fill(assumption);
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+  gai::Image<float> image;
+  ASSERT_EQ(gai::Status::Ok, image.open(path));
+  EXPECT_EQ(100u, image.size());
+  EXPECT_EQ(4950u, image.count());
+  EXPECT_EQ(gai::Image<float>::NoHandle, image.resolve("missing"));
+  EXPECT_FALSE((std::is_convertible<
+    gai::Image<float>::Index, gai::Image<float>::Handle>::value));
+  EXPECT_TRUE(image.values("missing").empty());
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    const std::string id = "id" + std::to_string(i);
+    const gai::Image<float>::Handle handle = image.resolve(id);
+    ASSERT_NE(gai::Image<float>::NoHandle, handle);
+    EXPECT_EQ(id, image.id(handle));
+    const gos::assumption::Span<const float> values = image.values(handle);
+    ASSERT_EQ(i, values.size());
+    for (unsigned int j = 0; j < i; j++)
+    {
+      EXPECT_EQ(0.5f * i + j, values[j]);
+      EXPECT_EQ(j % 3 == 0, image.is_set(handle, j));
+      EXPECT_EQ(
+        assumption.wrapper(id, j).value(), image.wrapper(handle, j).value());
+    }
+  }
+  image.close();
+  EXPECT_FALSE(image.is_open());
+  std::filesystem::remove(path);
+}
+
+TEST(image, load)
+{
+  const std::string path = image_path("gos_assumption_image_load");
+  FloatWrapperHolderAssumption assumption;
+  fill(assumption);
+  std::unique_ptr<float[]> a = std::make_unique<float[]>(assumption.ArraySize);
+  std::unique_ptr<FloatWrapper[]> wrappers =
+    std::make_unique<FloatWrapper[]>(assumption.ArraySize);
+  std::unique_ptr<FloatHolder> holder =
+    std::make_unique<FloatHolder>(assumption.ArraySize);
+  a[7] = 7.0f;
+  wrappers[7] = FloatWrapper(7.0f);
+  assumption.insert("inserted", a, wrappers, holder);
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+
+  gai::Image<float> image;
+  ASSERT_EQ(gai::Status::Ok, image.open(path));
+  FloatWrapperHolderAssumption restored;
+  restored.create("kept", 2);
+  ASSERT_EQ(gai::Status::Ok, gai::load(image, restored));
+  EXPECT_EQ(assumption.size() + 1, restored.size());
+  EXPECT_TRUE(restored.has("kept"));
+  assumption.for_each([&restored](const std::string& id,
+    const float* values, const FloatWrapper* wrappers, const unsigned int& size)
+  {
+    ASSERT_TRUE(restored.has(id));
+    EXPECT_EQ(size, restored.holder(id).size());
+    for (unsigned int j = 0; j < size; j++)
+    {
+      EXPECT_EQ(values[j], restored.value(id, j));
+      EXPECT_TRUE(wrappers[j] == restored.wrapper(id, j));
+    }
+  });
+  EXPECT_EQ(7.0f, restored.value("inserted", 7));
+  std::filesystem::remove(path);
+}
+
+TEST(image, rejected)
+{
+  const std::string path = image_path("gos_assumption_image_rejected");
+  FloatWrapperHolderAssumption assumption;
+  fill(assumption);
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  const std::uintmax_t size = std::filesystem::file_size(path);
+
+  gai::Image<float> image;
+  EXPECT_EQ(gai::Status::Unreadable, image.open(path + ".missing"));
+  EXPECT_EQ(gai::Status::Layout, gai::Image<double>().open(path));
+  EXPECT_EQ(gai::Status::Layout, gai::Image<std::int32_t>().open(path));
+
+  /* A byte of the values, of the header and a truncated file */
+  corrupt(path, static_cast<std::streamoff>(size / 2));
+  EXPECT_EQ(gai::Status::Corrupt, image.open(path));
+  EXPECT_FALSE(image.is_open());
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  corrupt(path, offsetof(gai::Header, reserved));
+  EXPECT_EQ(gai::Status::Corrupt, image.open(path));
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  corrupt(path, offsetof(gai::Header, version));
+  EXPECT_EQ(gai::Status::Version, image.open(path));
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  corrupt(path, 0);
+  EXPECT_EQ(gai::Status::Format, image.open(path));
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  std::filesystem::resize_file(path, size - 1);
+  EXPECT_EQ(gai::Status::Truncated, image.open(path));
+  std::filesystem::resize_file(path, 16);
+  EXPECT_EQ(gai::Status::Truncated, image.open(path));
+
+  EXPECT_EQ(gai::Status::Unwritable,
+    gai::save(assumption, image_path("missing/directory/image")));
+  std::filesystem::remove(path);
+}
+
+TEST(image, empty)
+{
+  const std::string path = image_path("gos_assumption_image_empty");
+  FloatWrapperHolderAssumption assumption;
+  ASSERT_EQ(gai::Status::Ok, gai::save(assumption, path));
+  gai::Image<float> image;
+  ASSERT_EQ(gai::Status::Ok, image.open(path));
+  EXPECT_EQ(0u, image.size());
+  EXPECT_FALSE(image.has("id"));
+  std::filesystem::remove(path);
+}
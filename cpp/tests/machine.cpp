@@ -0,0 +1,286 @@
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/machine.h>
+#ifdef _GOS_ASSUMPTION_TRACE_
+#include <gos/assumption/trace.h>
+#endif
+
+namespace gsm = ::gos::assumption::state_machine;
+namespace events = ::gos::assumption::state_machine::events;
+
+namespace
+{
+
+/* Start an engine and make every activity available */
+void available(gsm::TableEngine& engine)
+{
+  gsm::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  engine.process_event(events::NovosDataAvailable());
+  engine.process_event(events::ItgDataAvailable());
+  engine.process_event(events::HoistConstrainstActivityBecomesAvailable());
+}
+
+} /* namespace */
+
+TEST(machine, start)
+{
+  gsm::TableEngine engine;
+  EXPECT_EQ(gsm::Stage::Undefined, engine.GetStage());
+  engine.start();
+  EXPECT_EQ(gsm::Stage::Starting, engine.GetStage());
+  gsm::Stage stage;
+  EXPECT_TRUE(engine.process_event(
+    events::Started(__FILE__, __LINE__, stage)));
+  EXPECT_EQ(gsm::Stage::NoData, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::ItgDataAvailable()));
+  EXPECT_EQ(gsm::Stage::NoNovosData, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::NovosDataAvailable()));
+  EXPECT_EQ(gsm::Stage::HoistConstrainstActivityUnavailable,
+    engine.GetStage());
+  EXPECT_TRUE(engine.process_event(
+    events::HoistConstrainstActivityBecomesAvailable()));
+  EXPECT_EQ(gsm::Stage::ActivitiesAvailable, engine.GetStage());
+  engine.stop();
+}
+
+TEST(machine, control)
+{
+  gsm::TableEngine engine;
+  available(engine);
+  EXPECT_TRUE(engine.process_event(events::ControlRequested()));
+  EXPECT_EQ(gsm::Stage::RequestingControl, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::Timeout()));
+  EXPECT_EQ(gsm::Stage::ActivitiesAvailable, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::ControlRequested()));
+  EXPECT_TRUE(engine.process_event(events::Granted()));
+  EXPECT_EQ(gsm::Stage::InControl, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::ControlRelinquished()));
+  EXPECT_EQ(gsm::Stage::RelinquishingControl, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::ControlLost()));
+  EXPECT_EQ(gsm::Stage::ActivitiesAvailable, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::ControlRequested()));
+  EXPECT_TRUE(engine.process_event(events::Granted()));
+  EXPECT_TRUE(engine.process_event(events::ItgDataUnavailable()));
+  EXPECT_EQ(gsm::Stage::NoItgData, engine.GetStage());
+}
+
+TEST(machine, no_transition)
+{
+  gsm::TableEngine engine;
+  gsm::Stage stage;
+  engine.start();
+  EXPECT_FALSE(engine.process_event(events::Granted()));
+  EXPECT_EQ(gsm::Stage::Starting, engine.GetStage());
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  EXPECT_FALSE(engine.process_event(events::ControlRequested()));
+  EXPECT_FALSE(engine.process(gsm::events::EventId::Unknown));
+  EXPECT_FALSE(engine.process(static_cast<gsm::events::EventId>(1000)));
+  EXPECT_EQ(gsm::Stage::NoData, engine.GetStage());
+}
+
+TEST(machine, exit)
+{
+  gsm::TableEngine engine;
+  gsm::Stage stage;
+  available(engine);
+  EXPECT_TRUE(engine.process_event(events::ControlRequested()));
+  EXPECT_TRUE(engine.process_event(events::Quit()));
+  EXPECT_EQ(gsm::Stage::Exiting, engine.GetStage());
+  EXPECT_FALSE(engine.process_event(events::Quit()));
+  EXPECT_TRUE(engine.process_event(events::Exited()));
+  EXPECT_EQ(gsm::Stage::Out, engine.GetStage());
+  EXPECT_FALSE(engine.process_event(
+    events::Started(__FILE__, __LINE__, stage)));
+}
+
+TEST(machine, published)
+{
+  gsm::TableEngine engine;
+  EXPECT_EQ(gsm::Stage::Undefined, engine.stage());
+  EXPECT_EQ(0u, engine.transitions());
+  available(engine);
+  EXPECT_EQ(gsm::Stage::ActivitiesAvailable, engine.stage());
+  EXPECT_EQ(4u, engine.transitions());
+  engine.process_event(events::Granted());
+  EXPECT_EQ(4u, engine.transitions());
+
+  /* A monitoring thread only ever sees control stages and counts that
+   * grow while the engine cycles through control */
+  const uint64_t Cycles = 20000;
+  std::atomic<bool> done(false);
+  bool valid = true;
+  std::atomic<uint64_t> polls(0);
+  std::thread monitor([&]()
+  {
+    uint64_t previous = 0;
+    while (!done.load())
+    {
+      const uint64_t transitions = engine.transitions();
+      const gsm::Stage stage = engine.stage();
+      valid = valid && transitions >= previous &&
+        stage >= gsm::Stage::ActivitiesAvailable &&
+        stage <= gsm::Stage::InControl;
+      previous = transitions;
+      polls++;
+    }
+  });
+  while (polls.load() == 0)
+  {
+    std::this_thread::yield();
+  }
+  for (uint64_t i = 0; i < Cycles; i++)
+  {
+    engine.process_event(events::ControlRequested());
+    engine.process_event(events::Granted());
+    engine.process_event(events::ControlRelinquished());
+    engine.process_event(events::ControlLost());
+  }
+  done.store(true);
+  monitor.join();
+  EXPECT_TRUE(valid);
+  EXPECT_LT(0u, polls.load());
+  EXPECT_EQ(4 + 4 * Cycles, engine.transitions());
+  EXPECT_EQ(gsm::Stage::ActivitiesAvailable, engine.stage());
+}
+
+TEST(machine, frames)
+{
+  /* One frame is shared by every engine and read in place, a frame older
+   * than the last accepted is stale */
+  gos::assumption::FramePool pool(2, 64);
+  std::vector<gsm::TableEngine> engines(8);
+  gsm::Stage stage;
+  for (gsm::TableEngine& engine : engines)
+  {
+    engine.start();
+    engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  }
+  {
+    gos::assumption::Frame frame = pool.acquire();
+    frame.values<float>(8)[0] = 1.0f;
+    frame.sequence(5);
+    const events::NovosDataAvailable data(frame);
+    frame = gos::assumption::Frame();
+    for (gsm::TableEngine& engine : engines)
+    {
+      EXPECT_TRUE(engine.process_event(data));
+      EXPECT_EQ(5u, engine.novos_sequence());
+    }
+    EXPECT_EQ(1u, data.Data.references());
+    EXPECT_EQ(1u, pool.available());
+  }
+  EXPECT_EQ(2u, pool.available());
+
+  gsm::TableEngine& engine = engines[0];
+  EXPECT_TRUE(engine.process_event(events::NovosDataUnavailable()));
+  gos::assumption::Frame stale = pool.acquire();
+  stale.sequence(5);
+  EXPECT_FALSE(engine.process_event(events::NovosDataAvailable(stale)));
+  EXPECT_EQ(gsm::Stage::NoData, engine.GetStage());
+  EXPECT_TRUE(engine.process_event(events::NovosDataAvailable()));
+  EXPECT_EQ(gsm::Stage::NoItgData, engine.GetStage());
+  EXPECT_EQ(5u, engine.novos_sequence());
+  gos::assumption::Frame fresh = pool.acquire();
+  fresh.sequence(6);
+  EXPECT_TRUE(engine.process_event(events::ItgDataAvailable(fresh)));
+  EXPECT_EQ(6u, engine.itg_sequence());
+}
+
+TEST(machine, first_frame)
+{
+  /* The first frame is accepted with the sequence the pool gave it */
+  gos::assumption::FramePool pool(2, 64);
+  gsm::TableEngine engine;
+  gsm::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  gos::assumption::Frame frame = pool.acquire();
+  EXPECT_EQ(0u, frame.sequence());
+  EXPECT_TRUE(engine.process_event(events::ItgDataAvailable(frame)));
+  EXPECT_EQ(gsm::Stage::NoNovosData, engine.GetStage());
+  EXPECT_EQ(0u, engine.itg_sequence());
+
+  /* After it a frame of the same sequence is stale */
+  EXPECT_TRUE(engine.process_event(events::ItgDataUnavailable()));
+  EXPECT_FALSE(engine.process_event(events::ItgDataAvailable(frame)));
+  EXPECT_EQ(gsm::Stage::NoData, engine.GetStage());
+}
+
+#ifdef _GOS_ASSUMPTION_TRACE_
+TEST(machine, trace)
+{
+  namespace trace = ::gos::assumption::trace;
+  trace::Tracer& tracer = trace::Tracer::instance();
+  tracer.drain([](const trace::Record&) {});
+
+  gsm::TableEngine engine;
+  gsm::Stage stage;
+  engine.start();
+  engine.process_event(events::Started(__FILE__, __LINE__, stage));
+  engine.process_event(events::NovosDataAvailable());
+  engine.process_event(events::Granted());
+
+  std::vector<trace::Record> records;
+  tracer.drain([&](const trace::Record& record)
+  {
+    records.push_back(record);
+  });
+  ASSERT_EQ(4u, records.size());
+  EXPECT_EQ(trace::Kind::Entry, records[0].kind);
+  EXPECT_EQ(uint16_t(gsm::Stage::Undefined), records[0].from);
+  EXPECT_EQ(uint16_t(gsm::Stage::Starting), records[0].to);
+  EXPECT_EQ(uint16_t(gsm::Stage::Starting), records[1].from);
+  EXPECT_EQ(uint16_t(gsm::Stage::NoData), records[1].to);
+  EXPECT_EQ(uint16_t(events::EventId::Started), records[1].event);
+  EXPECT_EQ(uint16_t(gsm::Stage::NoItgData), records[2].to);
+  EXPECT_EQ(trace::Kind::NoTransition, records[3].kind);
+  EXPECT_EQ(uint16_t(gsm::Stage::NoItgData), records[3].from);
+  EXPECT_EQ(uint16_t(events::EventId::Granted), records[3].event);
+}
+#endif
+
+#ifdef _GOS_ASSUMPTION_HISTOGRAM_
+TEST(machine, histogram)
+{
+  const uint16_t Requesting = uint16_t(gsm::Stage::RequestingControl);
+  const uint16_t InControl = uint16_t(gsm::Stage::InControl);
+  const uint16_t Available = uint16_t(gsm::Stage::ActivitiesAvailable);
+  const uint64_t Granted =
+    gsm::latencies().latency(Requesting, InControl).count();
+  const uint64_t Timeout =
+    gsm::latencies().latency(Requesting, Available).count();
+
+  gsm::TableEngine engine;
+  available(engine);
+  engine.process_event(events::ControlRequested());
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  engine.process_event(events::Granted());
+  engine.process_event(events::ControlLost());
+  engine.process_event(events::ControlRequested());
+  engine.process_event(events::Timeout());
+
+  const gos::assumption::histogram::Snapshot granted =
+    gsm::latencies().latency(Requesting, InControl);
+  EXPECT_EQ(Granted + 1, granted.count());
+  EXPECT_LE(2000000u, granted.max());
+  EXPECT_EQ(Timeout + 1,
+    gsm::latencies().latency(Requesting, Available).count());
+  EXPECT_LE(2u, gsm::latencies().dwell(Requesting).count());
+
+  std::ostringstream text;
+  gsm::latencies().dump(text, gsm::stage_name);
+  EXPECT_THAT(text.str(),
+    ::testing::HasSubstr("RequestingControl->InControl "));
+}
+#endif
@@ -0,0 +1,82 @@
+#include <cstdint>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/queue.h>
+
+typedef gos::assumption::MpscQueue<uint64_t> Queue;
+
+TEST(queue, capacity)
+{
+  Queue queue(5);
+  EXPECT_EQ(8u, queue.capacity());
+  for (uint64_t i = 0; i < 8; i++)
+  {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(8));
+  EXPECT_EQ(8u, queue.size());
+
+  std::vector<uint64_t> popped;
+  auto read = [&](const uint64_t& value) { popped.push_back(value); };
+  EXPECT_EQ(3u, queue.pop(read, 3));
+  EXPECT_EQ(5u, queue.size());
+  EXPECT_TRUE(queue.push(8));
+  EXPECT_EQ(6u, queue.pop(read, 100));
+  EXPECT_EQ(0u, queue.pop(read, 100));
+  ASSERT_EQ(9u, popped.size());
+  for (uint64_t i = 0; i < 9; i++)
+  {
+    EXPECT_EQ(i, popped[i]);
+  }
+}
+
+TEST(queue, producers)
+{
+  const uint64_t Producers = 4;
+  const uint64_t Count = 100000;
+  Queue queue(256);
+
+  std::vector<std::thread> threads;
+  for (uint64_t producer = 0; producer < Producers; producer++)
+  {
+    threads.emplace_back([&queue, producer, Count]()
+    {
+      for (uint64_t i = 0; i < Count; i++)
+      {
+        while (!queue.push((producer << 32) | i))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  /* The values of every producer are popped in the order they were pushed */
+  std::vector<uint64_t> next(Producers, 0);
+  uint64_t popped = 0;
+  bool ordered = true;
+  while (popped < Producers * Count)
+  {
+    popped += queue.pop([&](const uint64_t& value)
+    {
+      const uint64_t producer = value >> 32;
+      ordered = ordered && (value & 0xffffffffu) == next[producer];
+      next[producer]++;
+    }, 64);
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(0u, queue.size());
+  for (const uint64_t& count : next)
+  {
+    EXPECT_EQ(Count, count);
+  }
+}
@@ -0,0 +1,158 @@
+#include <cstdint>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/runtime.h>
+
+namespace gsm = ::gos::assumption::state_machine;
+typedef gsm::events::EventId Id;
+
+namespace
+{
+
+/* Post an event, retrying while the shard is full */
+void post(gsm::Runtime& runtime, const gsm::Runtime::Instance& instance,
+  const Id& id)
+{
+  while (!runtime.post(instance, id))
+  {
+    std::this_thread::yield();
+  }
+}
+
+/* Wait for the workers to dispatch a number of events */
+void wait(const gsm::Runtime& runtime, const uint64_t& processed)
+{
+  while (runtime.processed() < processed)
+  {
+    std::this_thread::yield();
+  }
+}
+
+} /* namespace */
+
+TEST(runtime, shards)
+{
+  gsm::Runtime runtime(10, 4, 16);
+  EXPECT_EQ(10u, runtime.instances());
+  EXPECT_EQ(4u, runtime.shards());
+  EXPECT_EQ(1u, runtime.shard(5));
+  EXPECT_EQ(3u, runtime.shard(7));
+  for (gsm::Runtime::Instance i = 0; i < 10; i++)
+  {
+    EXPECT_EQ(gsm::Stage::Starting, runtime.stage(i));
+  }
+
+  /* Only instance 5 gets data, the events wait in the queue until start */
+  EXPECT_TRUE(runtime.post(5, Id::Started));
+  EXPECT_TRUE(runtime.post(5, Id::NovosDataAvailable));
+  EXPECT_TRUE(runtime.post(6, Id::Granted));
+  runtime.start();
+  wait(runtime, 3);
+  runtime.stop();
+  EXPECT_EQ(3u, runtime.processed());
+  EXPECT_EQ(2u, runtime.transitions());
+  EXPECT_EQ(gsm::Stage::NoItgData, runtime.stage(5));
+  EXPECT_EQ(gsm::Stage::Starting, runtime.stage(6));
+  EXPECT_EQ(gsm::Stage::Starting, runtime.stage(4));
+}
+
+TEST(runtime, full)
+{
+  gsm::Runtime runtime(2, 1, 4);
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_TRUE(runtime.post(0, Id::Started));
+  }
+  EXPECT_FALSE(runtime.post(1, Id::Started));
+  runtime.start();
+  wait(runtime, 4);
+  EXPECT_TRUE(runtime.post(1, Id::Started));
+  runtime.stop();
+  EXPECT_EQ(5u, runtime.processed());
+  EXPECT_EQ(2u, runtime.transitions());
+  EXPECT_EQ(gsm::Stage::NoData, runtime.stage(1));
+}
+
+TEST(runtime, bounds)
+{
+  /* An instance past the last one is rejected instead of being posted to
+   * an engine that does not exist */
+  gsm::Runtime runtime(5, 2, 16);
+  EXPECT_FALSE(runtime.post(5, Id::Started));
+  EXPECT_FALSE(runtime.post(1000, Id::Started));
+  EXPECT_TRUE(runtime.post(4, Id::Started));
+
+  /* No shards is one shard */
+  gsm::Runtime single(3, 0, 16);
+  EXPECT_EQ(1u, single.shards());
+  EXPECT_EQ(0u, single.shard(2));
+  EXPECT_TRUE(single.post(2, Id::Started));
+  single.start();
+  wait(single, 1);
+  single.stop();
+  EXPECT_EQ(1u, single.processed());
+  EXPECT_EQ(gsm::Stage::Starting, single.stage(0));
+}
+
+TEST(runtime, producers)
+{
+  /* Every producer owns a block of instances spread over every shard and
+   * cycles them through control, the events of an instance stay ordered */
+  const gsm::Runtime::Instance Instances = 1000;
+  const size_t Producers = 4;
+  const size_t Cycles = 50;
+  gsm::Runtime runtime(Instances, 3, 256);
+  runtime.start();
+  std::vector<std::thread> threads;
+  for (size_t producer = 0; producer < Producers; producer++)
+  {
+    threads.emplace_back([&runtime, producer, Instances, Cycles]()
+    {
+      const gsm::Runtime::Instance First =
+        static_cast<gsm::Runtime::Instance>(producer * Instances / Producers);
+      const gsm::Runtime::Instance Last =
+        static_cast<gsm::Runtime::Instance>(
+          (producer + 1) * Instances / Producers);
+      for (gsm::Runtime::Instance i = First; i < Last; i++)
+      {
+        post(runtime, i, Id::Started);
+        post(runtime, i, Id::NovosDataAvailable);
+        post(runtime, i, Id::ItgDataAvailable);
+        post(runtime, i, Id::HoistConstrainstActivityBecomesAvailable);
+      }
+      for (size_t cycle = 0; cycle < Cycles; cycle++)
+      {
+        for (gsm::Runtime::Instance i = First; i < Last; i++)
+        {
+          post(runtime, i, Id::ControlRequested);
+          post(runtime, i, Id::Granted);
+          post(runtime, i, Id::ControlRelinquished);
+          post(runtime, i, Id::ControlLost);
+        }
+      }
+      for (gsm::Runtime::Instance i = First; i < Last; i += 2)
+      {
+        post(runtime, i, Id::ControlRequested);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  const uint64_t Events = Instances * (4 + 4 * Cycles) + Instances / 2;
+  wait(runtime, Events);
+  runtime.stop();
+  EXPECT_EQ(Events, runtime.transitions());
+  for (gsm::Runtime::Instance i = 0; i < Instances; i++)
+  {
+    EXPECT_EQ(i % 2 == 0 ?
+      gsm::Stage::RequestingControl : gsm::Stage::ActivitiesAvailable,
+      runtime.stage(i)) << i;
+  }
+}
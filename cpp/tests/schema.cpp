@@ -0,0 +1,140 @@
+#include <cstdint>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/endian.h>
+#include <gos/assumption/schema.h>
+
+namespace endian = ::gos::assumption::endian;
+namespace gs = ::gos::assumption::schema;
+
+namespace
+{
+
+struct Sample
+{
+  std::uint16_t id;
+  float value;
+  std::int32_t count;
+};
+
+/* A gap of two bytes between the id and the little endian count */
+typedef gs::Schema<
+  gs::Field<&Sample::id, gs::Order::Big, 0>,
+  gs::Field<&Sample::value, gs::Order::Big, 4>,
+  gs::Field<&Sample::count, gs::Order::Little, 8>> SampleSchema;
+
+} /* namespace */
+
+TEST(schema, layout)
+{
+  EXPECT_EQ(3u, SampleSchema::Fields);
+  EXPECT_EQ(12u, SampleSchema::Bytes);
+}
+
+TEST(schema, record)
+{
+  unsigned char buffer[1 + SampleSchema::Bytes] = {};
+  unsigned char* unaligned = buffer + 1;
+  endian::store_big_endian<std::uint16_t>(unaligned, 0x0102);
+  endian::store_big_endian<float>(unaligned + 4, 2.5f);
+  endian::store_little_endian<std::int32_t>(unaligned + 8, -42);
+
+  Sample sample = {};
+  SampleSchema::decode(unaligned, sample);
+  EXPECT_EQ(0x0102, sample.id);
+  EXPECT_FLOAT_EQ(2.5f, sample.value);
+  EXPECT_EQ(-42, sample.count);
+
+  unsigned char encoded[1 + SampleSchema::Bytes] = {};
+  SampleSchema::encode(encoded + 1, sample);
+  EXPECT_TRUE(std::equal(buffer, buffer + sizeof(buffer), encoded));
+}
+
+TEST(schema, arrays)
+{
+  const size_t Count = 100;
+  const size_t Stride = 16;
+  std::vector<Sample> samples(Count);
+  for (size_t i = 0; i < Count; i++)
+  {
+    samples[i].id = static_cast<std::uint16_t>(i);
+    samples[i].value = static_cast<float>(i) * 0.5f;
+    samples[i].count = static_cast<std::int32_t>(i) - 50;
+  }
+
+  // Records padded to a stride, the last one needs no padding
+  std::vector<unsigned char> frame((Count - 1) * Stride + SampleSchema::Bytes);
+  EXPECT_EQ(Count, SampleSchema::encode(
+    frame.data(), frame.size(), samples.data(), Count, Stride));
+  std::vector<Sample> decoded(Count);
+  EXPECT_EQ(Count, SampleSchema::decode(
+    frame.data(), frame.size(), decoded.data(), Count, Stride));
+  for (size_t i = 0; i < Count; i++)
+  {
+    EXPECT_EQ(samples[i].id, decoded[i].id);
+    EXPECT_FLOAT_EQ(samples[i].value, decoded[i].value);
+    EXPECT_EQ(samples[i].count, decoded[i].count);
+  }
+
+  // Only whole records are decoded
+  EXPECT_EQ(1u, SampleSchema::decode(
+    frame.data(), Stride + SampleSchema::Bytes - 1, decoded.data(), Count,
+    Stride));
+  EXPECT_EQ(0u, SampleSchema::decode(
+    frame.data(), SampleSchema::Bytes - 1, decoded.data(), Count, Stride));
+  EXPECT_EQ(10u, SampleSchema::decode(
+    frame.data(), frame.size(), decoded.data(), 10, Stride));
+
+  // A stride shorter than a record would overlap them, none are coded
+  EXPECT_EQ(0u, SampleSchema::decode(
+    frame.data(), frame.size(), decoded.data(), Count, 0));
+  EXPECT_EQ(0u, SampleSchema::decode(
+    frame.data(), frame.size(), decoded.data(), Count,
+    SampleSchema::Bytes - 1));
+  EXPECT_EQ(0u, SampleSchema::encode(
+    frame.data(), frame.size(), samples.data(), Count, 0));
+  EXPECT_EQ(0u, SampleSchema::encode(
+    frame.data(), frame.size(), samples.data(), Count,
+    SampleSchema::Bytes - 1));
+}
+
+TEST(schema, columns)
+{
+  typedef gos::assumption::ArrayHolder<std::uint16_t> Ids;
+  typedef gos::assumption::ArrayHolder<gos::assumption::Wrapper<float>>
+    Values;
+  typedef gos::assumption::ArrayHolder<std::int32_t> Counts;
+
+  const size_t Count = 20;
+  std::vector<Sample> samples(Count);
+  for (size_t i = 0; i < Count; i++)
+  {
+    samples[i].id = static_cast<std::uint16_t>(i + 1);
+    samples[i].value = static_cast<float>(i) + 0.25f;
+    samples[i].count = static_cast<std::int32_t>(i * 3);
+  }
+  std::vector<unsigned char> frame(Count * SampleSchema::Bytes);
+  SampleSchema::encode(frame.data(), frame.size(), samples.data(), Count);
+
+  // The smallest column limits the records decoded
+  Ids ids(Count);
+  Values values(Count);
+  Counts counts(Count - 5);
+  EXPECT_EQ(Count - 5, SampleSchema::decode_columns(
+    frame.data(), frame.size(), SampleSchema::Bytes, ids, values, counts));
+  for (size_t i = 0; i < Count - 5; i++)
+  {
+    EXPECT_EQ(samples[i].id, ids.get(i));
+    EXPECT_TRUE(values.get(i).is_set());
+    EXPECT_FLOAT_EQ(samples[i].value, values.get(i).value());
+    EXPECT_EQ(samples[i].count, counts.get(i));
+  }
+  EXPECT_EQ(0, ids.get(Count - 1));
+  EXPECT_EQ(0u, SampleSchema::decode_columns(
+    frame.data(), frame.size(), 0, ids, values, counts));
+}
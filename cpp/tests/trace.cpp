@@ -0,0 +1,185 @@
+#include <cstdint>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/trace.h>
+
+namespace trace = ::gos::assumption::trace;
+
+namespace
+{
+
+const char* name(const std::uint16_t& code)
+{
+  static const char* Names[] = { "zero", "one", "two" };
+  return Names[code % 3];
+}
+
+std::vector<trace::Record> drain(trace::Tracer& tracer)
+{
+  std::vector<trace::Record> records;
+  tracer.drain([&](const trace::Record& record)
+  {
+    records.push_back(record);
+  });
+  return records;
+}
+
+} /* namespace */
+
+TEST(trace, ring)
+{
+  trace::Ring ring(7, 4);
+  for (std::uint16_t i = 0; i < 6; i++)
+  {
+    EXPECT_EQ(i < 4, ring.push(trace::Record{
+      i, ring.thread(), trace::Kind::Entry, i, i, i }));
+  }
+  EXPECT_EQ(2u, ring.drops());
+  std::vector<std::uint64_t> timestamps;
+  EXPECT_EQ(4u, ring.drain([&](const trace::Record& record)
+  {
+    timestamps.push_back(record.timestamp);
+    EXPECT_EQ(7u, record.thread);
+  }));
+  EXPECT_THAT(timestamps, ::testing::ElementsAre(0, 1, 2, 3));
+  EXPECT_TRUE(ring.push(trace::Record{}));
+  EXPECT_EQ(1u, ring.drain([](const trace::Record&) {}));
+}
+
+TEST(trace, threads)
+{
+  trace::Tracer& tracer = trace::Tracer::instance();
+  drain(tracer);
+  const std::uint16_t Records = 1000;
+  std::vector<std::thread> threads;
+  for (std::uint16_t t = 0; t < 4; t++)
+  {
+    threads.emplace_back([&tracer, t]()
+    {
+      for (std::uint16_t i = 0; i < Records; i++)
+      {
+        tracer.record(trace::Kind::Entry, t, i, 0);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Every thread has a ring and its records are in order
+  const std::vector<trace::Record> records = drain(tracer);
+  EXPECT_EQ(4u * Records, records.size());
+  std::vector<std::uint16_t> next(4, 0);
+  std::vector<std::uint32_t> threads_of(4, 0xffffffffu);
+  for (const trace::Record& record : records)
+  {
+    ASSERT_LT(record.from, 4);
+    EXPECT_EQ(next[record.from]++, record.to);
+    if (threads_of[record.from] == 0xffffffffu)
+    {
+      threads_of[record.from] = record.thread;
+    }
+    EXPECT_EQ(threads_of[record.from], record.thread);
+  }
+  EXPECT_TRUE(drain(tracer).empty());
+}
+
+TEST(trace, reuse)
+{
+  trace::Tracer& tracer = trace::Tracer::instance();
+  drain(tracer);
+  auto record = [&tracer](const std::uint16_t& code)
+  {
+    std::thread([&tracer, code]()
+    {
+      tracer.record(trace::Kind::Entry, code, code, code);
+    }).join();
+  };
+
+  // The ring of a thread that exits goes to the next one once drained
+  record(0);
+  const size_t rings = tracer.rings();
+  std::vector<trace::Record> records = drain(tracer);
+  ASSERT_EQ(1u, records.size());
+  const std::uint32_t thread = records[0].thread;
+  for (std::uint16_t i = 1; i < 100; i++)
+  {
+    record(i);
+    records = drain(tracer);
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ(i, records[0].from);
+    EXPECT_EQ(thread, records[0].thread);
+  }
+  EXPECT_EQ(rings, tracer.rings());
+
+  // A ring still holding records is not given to another thread
+  record(1);
+  record(2);
+  records = drain(tracer);
+  ASSERT_EQ(2u, records.size());
+  EXPECT_NE(records[0].thread, records[1].thread);
+  const size_t used = tracer.rings();
+  record(3);
+  EXPECT_EQ(used, tracer.rings());
+  EXPECT_EQ(1u, drain(tracer).size());
+}
+
+TEST(trace, writer)
+{
+  const trace::Record Records[] = {
+    { 1234567, 3, trace::Kind::Entry, 1, 2, 0 },
+    { 2000005, 3, trace::Kind::NoTransition, 2, 2, 1 }
+  };
+  std::ostringstream text;
+  {
+    trace::Writer writer(text, trace::Format::Text,
+      trace::Names{ name, nullptr });
+    for (const trace::Record& record : Records)
+    {
+      writer.write(record);
+    }
+  }
+  EXPECT_EQ(
+    "1234567 3 entry one -> two on 0\n"
+    "2000005 3 no transition two -> two on 1\n", text.str());
+
+  std::ostringstream json;
+  {
+    trace::Writer writer(json, trace::Format::ChromeJson,
+      trace::Names{ name, name });
+    for (const trace::Record& record : Records)
+    {
+      writer.write(record);
+    }
+  }
+  EXPECT_EQ("{\"traceEvents\":[\n"
+    "{\"name\":\"two\",\"cat\":\"entry\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,"
+    "\"tid\":3,\"ts\":1234.567,\"args\":{\"from\":\"one\",\"event\":\"zero\"}"
+    "},\n"
+    "{\"name\":\"two\",\"cat\":\"no transition\",\"ph\":\"i\",\"s\":\"t\","
+    "\"pid\":1,\"tid\":3,\"ts\":2000.005,\"args\":{\"from\":\"two\","
+    "\"event\":\"one\"}}]}\n", json.str());
+}
+
+TEST(trace, drainer)
+{
+  trace::Tracer& tracer = trace::Tracer::instance();
+  drain(tracer);
+  std::ostringstream text;
+  {
+    trace::Drainer drainer(tracer, text, trace::Format::Text,
+      trace::Names{ name, name }, std::chrono::milliseconds(1));
+    tracer.record(trace::Kind::Entry, 0, 1, 2);
+    tracer.record(trace::Kind::Entry, 1, 2, 0);
+  }
+  EXPECT_THAT(text.str(), ::testing::HasSubstr("entry zero -> one on two\n"));
+  EXPECT_THAT(text.str(), ::testing::HasSubstr("entry one -> two on zero\n"));
+}
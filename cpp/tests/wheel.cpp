@@ -0,0 +1,140 @@
+#include <cstdint>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/wheel.h>
+
+typedef gos::assumption::TimingWheel<int> Wheel;
+typedef std::vector<int> Fired;
+
+namespace
+{
+
+/* Advance one tick at a time and record the tick every payload fires on */
+void run(Wheel& wheel, const Wheel::Tick& ticks, std::vector<Wheel::Tick>& at)
+{
+  for (Wheel::Tick i = 0; i < ticks; i++)
+  {
+    wheel.advance(1, [&](const Wheel::Batch& batch)
+    {
+      for (const int& payload : batch)
+      {
+        at[payload] = wheel.now();
+      }
+    });
+  }
+}
+
+} /* namespace */
+
+TEST(wheel, expire)
+{
+  Wheel wheel;
+  EXPECT_TRUE(wheel.empty());
+  const Wheel::Tick Delays[] =
+    { 0, 1, 2, 255, 256, 257, 300, 65535, 65536, 70000, 1u << 20 };
+  const size_t Count = sizeof(Delays) / sizeof(Delays[0]);
+  for (size_t i = 0; i < Count; i++)
+  {
+    wheel.arm(Delays[i], static_cast<int>(i));
+  }
+  EXPECT_EQ(Count, wheel.size());
+  std::vector<Wheel::Tick> at(Count, 0);
+  run(wheel, (1u << 20) + 1, at);
+  EXPECT_TRUE(wheel.empty());
+  for (size_t i = 0; i < Count; i++)
+  {
+    EXPECT_EQ(Delays[i] > 0 ? Delays[i] : 1, at[i]) << Delays[i];
+  }
+}
+
+TEST(wheel, offset)
+{
+  // Timers armed when the lower levels are part way through a turn
+  Wheel wheel;
+  Fired fired;
+  wheel.advance(1000, [&](const Wheel::Batch&) {});
+  EXPECT_EQ(1000u, wheel.now());
+  std::vector<Wheel::Tick> at(3, 0);
+  wheel.arm(50, 0);
+  wheel.arm(600, 1);
+  wheel.arm(100000, 2);
+  run(wheel, 100000, at);
+  EXPECT_EQ(1050u, at[0]);
+  EXPECT_EQ(1600u, at[1]);
+  EXPECT_EQ(101000u, at[2]);
+}
+
+TEST(wheel, cancel)
+{
+  Wheel wheel;
+  const Wheel::Handle a = wheel.arm(10, 1);
+  const Wheel::Handle b = wheel.arm(10, 2);
+  const Wheel::Handle c = wheel.arm(1000, 3);
+  EXPECT_TRUE(wheel.armed(a));
+  EXPECT_TRUE(wheel.cancel(b));
+  EXPECT_FALSE(wheel.armed(b));
+  EXPECT_FALSE(wheel.cancel(b));
+  EXPECT_FALSE(wheel.cancel(Wheel::NoHandle));
+  EXPECT_TRUE(wheel.cancel(c));
+  EXPECT_EQ(1u, wheel.size());
+
+  // The released timer is reused without matching the stale handle
+  const Wheel::Handle d = wheel.arm(5, 4);
+  EXPECT_FALSE(wheel.armed(b) && wheel.armed(c));
+  EXPECT_NE(b, d);
+  EXPECT_NE(c, d);
+
+  Fired fired;
+  EXPECT_EQ(2u, wheel.advance(20, [&](const Wheel::Batch& batch)
+  {
+    fired.insert(fired.end(), batch.begin(), batch.end());
+  }));
+  EXPECT_THAT(fired, ::testing::ElementsAre(4, 1));
+  EXPECT_FALSE(wheel.armed(a));
+  EXPECT_FALSE(wheel.cancel(a));
+}
+
+TEST(wheel, batch)
+{
+  // Every timer that expires in one advance fires in one batch
+  Wheel wheel(1000);
+  for (int i = 0; i < 1000; i++)
+  {
+    wheel.arm(static_cast<Wheel::Tick>(i % 50 + 1), i);
+  }
+  size_t batches = 0;
+  size_t count = 0;
+  wheel.advance(50, [&](const Wheel::Batch& batch)
+  {
+    batches++;
+    count += batch.size();
+  });
+  EXPECT_EQ(1u, batches);
+  EXPECT_EQ(1000u, count);
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(wheel, rearm)
+{
+  // A periodic timer armed again from its fire function
+  Wheel wheel;
+  Fired fired;
+  wheel.arm(3, 7);
+  for (int i = 0; i < 10; i++)
+  {
+    wheel.advance(3, [&](const Wheel::Batch& batch)
+    {
+      for (const int& payload : batch)
+      {
+        fired.push_back(payload);
+        wheel.arm(3, payload);
+      }
+    });
+  }
+  EXPECT_EQ(10u, fired.size());
+  EXPECT_EQ(1u, wheel.size());
+}
@@ -0,0 +1,217 @@
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption.h>
+#include <gos/assumption/wire.h>
+
+namespace gaw = ::gos::assumption::wire;
+
+typedef gos::assumption::StringHolder StringHolder;
+typedef gos::assumption::Wrapper<float> FloatWrapper;
+typedef gos::assumption::ArrayHolder<FloatWrapper> FloatHolder;
+typedef gos::assumption::Assumption<float, FloatWrapper, FloatHolder>
+  FloatWrapperHolderAssumption;
+
+namespace
+{
+
+gaw::Group make_group(
+  const gaw::Type& type,
+  const std::string& id,
+  const std::string& name,
+  const std::string& text,
+  const std::int32_t& number)
+{
+  gaw::Group group;
+  group.type = type;
+  group.id = StringHolder(id);
+  group.item.name = StringHolder(name);
+  group.item.text = StringHolder(text);
+  group.item.number = number;
+  return group;
+}
+
+/* The bytes gos.assumption.BinarySerializationTest expects as well */
+const std::vector<unsigned char> GroupABytes = {
+  0x17, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x00, '1', '2', '3',
+  0x01, 0x00, 0x00, 0x00, 'A',
+  0x06, 0x00, 0x00, 0x00, 'I', 't', 'e', 'm', ' ', 'A' };
+const std::vector<unsigned char> GroupBBytes = {
+  0x11, 0x00, 0x00, 0x00, 0x01,
+  0x03, 0x00, 0x00, 0x00, '3', '4', '5',
+  0x01, 0x00, 0x00, 0x00, 'B',
+  0x5d, 0x00, 0x00, 0x00 };
+
+} /* namespace */
+
+TEST(wire, encode)
+{
+  std::vector<unsigned char> buffer;
+  gaw::encode(buffer, make_group(gaw::Type::A, "123", "A", "Item A", 0));
+  EXPECT_EQ(GroupABytes, buffer);
+  buffer.clear();
+  gaw::encode(buffer, make_group(gaw::Type::B, "345", "B", "", 93));
+  EXPECT_EQ(GroupBBytes, buffer);
+
+  unsigned char small[8];
+  EXPECT_EQ(0u, gaw::encode(small, sizeof(small),
+    make_group(gaw::Type::B, "345", "B", "", 93)));
+}
+
+TEST(wire, decode)
+{
+  std::vector<unsigned char> buffer(GroupABytes);
+  buffer.insert(buffer.end(), GroupBBytes.begin(), GroupBBytes.end());
+  gaw::Group group;
+  size_t used = gaw::decode(buffer.data(), buffer.size(), group);
+  ASSERT_EQ(GroupABytes.size(), used);
+  EXPECT_EQ(gaw::Type::A, group.type);
+  EXPECT_EQ("123", group.id.text());
+  EXPECT_EQ("A", group.item.name.text());
+  EXPECT_EQ("Item A", group.item.text.text());
+  used = gaw::decode(buffer.data() + used, buffer.size() - used, group);
+  ASSERT_EQ(GroupBBytes.size(), used);
+  EXPECT_EQ(gaw::Type::B, group.type);
+  EXPECT_EQ("345", group.id.text());
+  EXPECT_EQ("B", group.item.name.text());
+  EXPECT_EQ("", group.item.text.text());
+  EXPECT_EQ(93, group.item.number);
+
+  /* A group without an item and a null string from the Java side */
+  const std::vector<unsigned char> bare = {
+    0x09, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00, 0x00, 0x00, 'b', 'a', 'r', 'e' };
+  ASSERT_EQ(bare.size(), gaw::decode(bare.data(), bare.size(), group));
+  EXPECT_EQ("bare", group.id.text());
+  EXPECT_FALSE(group.has_item);
+  EXPECT_EQ("", group.item.name.text());
+  EXPECT_EQ(0, group.item.number);
+  const std::vector<unsigned char> null = {
+    0x0d, 0x00, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00 };
+  ASSERT_EQ(null.size(), gaw::decode(null.data(), null.size(), group));
+  EXPECT_TRUE(group.null_id);
+  EXPECT_EQ("", group.id.text());
+  EXPECT_TRUE(group.has_item);
+  EXPECT_FALSE(group.item.null_name);
+  EXPECT_EQ(7, group.item.number);
+}
+
+TEST(wire, null)
+{
+  /* The bytes of new GroupB("bare", null) in BinarySerializationTest */
+  const std::vector<unsigned char> bare = {
+    0x09, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00, 0x00, 0x00, 'b', 'a', 'r', 'e' };
+  gaw::Group group = make_group(gaw::Type::B, "bare", "", "", 0);
+  group.has_item = false;
+  std::vector<unsigned char> buffer;
+  gaw::encode(buffer, group);
+  EXPECT_EQ(bare, buffer);
+
+  /* The bytes of new GroupA(null, new ItemA("\u00e6", null)) */
+  const std::vector<unsigned char> null = {
+    0x0f, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0x02, 0x00, 0x00, 0x00, 0xc3, 0xa6, 0xff, 0xff, 0xff, 0xff };
+  group = make_group(gaw::Type::A, "", "\xc3\xa6", "", 0);
+  group.null_id = true;
+  group.item.null_text = true;
+  buffer.clear();
+  gaw::encode(buffer, group);
+  EXPECT_EQ(null, buffer);
+
+  /* Both decode to the same flags and encode to the same bytes again */
+  for (const std::vector<unsigned char>& bytes : { bare, null })
+  {
+    gaw::Group decoded;
+    ASSERT_EQ(bytes.size(), gaw::decode(bytes.data(), bytes.size(), decoded));
+    EXPECT_EQ(bytes.size(), gaw::size(decoded));
+    buffer.clear();
+    gaw::encode(buffer, decoded);
+    EXPECT_EQ(bytes, buffer);
+  }
+  gaw::Group decoded;
+  ASSERT_EQ(null.size(), gaw::decode(null.data(), null.size(), decoded));
+  EXPECT_TRUE(decoded.null_id);
+  EXPECT_FALSE(decoded.item.null_name);
+  EXPECT_EQ("\xc3\xa6", decoded.item.name.text());
+  EXPECT_TRUE(decoded.item.null_text);
+}
+
+TEST(wire, malformed)
+{
+  gaw::Group group;
+  for (size_t size = 0; size < GroupABytes.size(); size++)
+  {
+    EXPECT_EQ(0u, gaw::decode(GroupABytes.data(), size, group));
+  }
+  std::vector<unsigned char> bytes(GroupBBytes);
+  bytes[4] = 2;
+  EXPECT_EQ(0u, gaw::decode(bytes.data(), bytes.size(), group));
+  bytes = GroupBBytes;
+  bytes[12] = 0x02;
+  EXPECT_EQ(0u, gaw::decode(bytes.data(), bytes.size(), group));
+  bytes = GroupBBytes;
+  bytes[0] = 0x10;
+  EXPECT_EQ(0u, gaw::decode(bytes.data(), bytes.size(), group));
+}
+
+TEST(wire, load)
+{
+  std::vector<unsigned char> buffer;
+  for (int i = 0; i < 10; i++)
+  {
+    gaw::encode(buffer, make_group(i % 2 == 0 ? gaw::Type::B : gaw::Type::A,
+      "group" + std::to_string(i), "item", "text", 10 * i + 1));
+  }
+  const size_t complete = buffer.size();
+  buffer.push_back(0x20);
+  FloatWrapperHolderAssumption assumption;
+  EXPECT_EQ(complete, gaw::load(buffer.data(), buffer.size(), assumption));
+  EXPECT_EQ(10u, assumption.size());
+  for (int i = 0; i < 10; i++)
+  {
+    const std::string id = "group" + std::to_string(i);
+    ASSERT_TRUE(assumption.has(id));
+    EXPECT_EQ(i % 2 == 0, assumption.wrapper(id, 0).is_set());
+    EXPECT_EQ(i % 2 == 0 ? 10.0f * i + 1 : 0.0f, assumption.value(id, 0));
+  }
+
+  /* The values of the ids loaded again are replaced in place, an id with
+   * another size is created again with one value */
+  assumption.create("group4", 4);
+  buffer.clear();
+  gaw::encode(buffer, make_group(gaw::Type::A, "group2", "item", "text", 0));
+  gaw::encode(buffer, make_group(gaw::Type::B, "group3", "item", "", 7));
+  gaw::encode(buffer, make_group(gaw::Type::B, "group4", "item", "", 8));
+  gaw::encode(buffer, make_group(gaw::Type::B, "new", "item", "", 9));
+  gaw::encode(buffer, make_group(gaw::Type::A, "new", "item", "text", 0));
+  EXPECT_EQ(buffer.size(), gaw::load(buffer.data(), buffer.size(), assumption));
+  EXPECT_EQ(11u, assumption.size());
+  EXPECT_FALSE(assumption.wrapper("group2", 0).is_set());
+  EXPECT_EQ(0.0f, assumption.value("group2", 0));
+  EXPECT_TRUE(assumption.wrapper("group3", 0).is_set());
+  EXPECT_EQ(7.0f, assumption.value("group3", 0));
+  EXPECT_EQ(1u, assumption.array_size(assumption.resolve("group4")));
+  EXPECT_EQ(8.0f, assumption.value("group4", 0));
+  EXPECT_FALSE(assumption.wrapper("new", 0).is_set());
+  EXPECT_EQ(0.0f, assumption.value("new", 0));
+}
+
+TEST(wire, roundtrip)
+{
+  const gaw::Group group = make_group(
+    gaw::Type::A, std::string(300, 'x'), "\xc3\xa6\xc3\xb8", "", 0);
+  std::vector<unsigned char> buffer;
+  gaw::encode(buffer, group);
+  EXPECT_EQ(gaw::size(group), buffer.size());
+  gaw::Group decoded;
+  ASSERT_EQ(buffer.size(), gaw::decode(buffer.data(), buffer.size(), decoded));
+  EXPECT_EQ(group.id.view(), decoded.id.view());
+  EXPECT_EQ(group.item.name.text(), decoded.item.name.text());
+  EXPECT_EQ("", decoded.item.text.text());
+}
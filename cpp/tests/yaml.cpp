@@ -0,0 +1,213 @@
+#include <cstdint>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <gos/assumption/yaml.h>
+
+namespace gaw = ::gos::assumption::wire;
+namespace gay = ::gos::assumption::yaml;
+
+namespace
+{
+
+//! A group as the handler saw it
+struct Read
+{
+  gaw::Type type;
+  std::string id;
+  std::string name;
+  std::string text;
+  std::int32_t number;
+  gay::Names::Symbol symbol;
+};
+
+std::vector<Read> read(gay::Reader& reader, const std::string& input)
+{
+  std::vector<Read> result;
+  auto handler = [&result](const gaw::Group& group,
+    const gay::Names::Symbol& symbol)
+  {
+    result.push_back(Read{ group.type, group.id.text(),
+      group.item.name.text(), group.item.text.text(), group.item.number,
+      symbol });
+  };
+  reader.feed(input.data(), input.size(), handler);
+  reader.finish(handler);
+  return result;
+}
+
+} /* namespace */
+
+TEST(yaml, serialized)
+{
+  /* The documents gos.assumption.SerializationTest dumps and reads */
+  gay::Reader reader;
+  const std::vector<Read> groups = read(reader,
+    "!!gos.assumption.GroupA\n"
+    "id: '123'\n"
+    "item: {name: A, value: Item A}\n"
+    "type: A\n"
+    "---\n"
+    "id: '345'\n"
+    "item: {name: B, value: 93}\n"
+    "type: B\n"
+    "---\n"
+    "id: 11\n"
+    "type: A\n"
+    "item:\n"
+    "  name: A\n"
+    "  value: 93\n");
+  EXPECT_EQ(0u, reader.errors()) << reader.error();
+  ASSERT_EQ(3u, groups.size());
+  EXPECT_EQ(gaw::Type::A, groups[0].type);
+  EXPECT_EQ("123", groups[0].id);
+  EXPECT_EQ("A", groups[0].name);
+  EXPECT_EQ("Item A", groups[0].text);
+  EXPECT_EQ(gaw::Type::B, groups[1].type);
+  EXPECT_EQ("345", groups[1].id);
+  EXPECT_EQ("B", groups[1].name);
+  EXPECT_EQ("", groups[1].text);
+  EXPECT_EQ(93, groups[1].number);
+  EXPECT_EQ(gaw::Type::A, groups[2].type);
+  EXPECT_EQ("11", groups[2].id);
+  EXPECT_EQ("93", groups[2].text);
+  EXPECT_EQ(0, groups[2].number);
+
+  /* The names are interned */
+  EXPECT_EQ(2u, reader.names().size());
+  EXPECT_EQ(groups[0].symbol, groups[2].symbol);
+  EXPECT_NE(groups[0].symbol, groups[1].symbol);
+  EXPECT_EQ("B", reader.names().name(groups[1].symbol));
+  EXPECT_EQ(3u, reader.groups());
+}
+
+TEST(yaml, chunks)
+{
+  /* Feeding a byte at a time reads the same groups as a whole */
+  std::string input;
+  for (int i = 0; i < 20; i++)
+  {
+    input += "--- !!gos.assumption.GroupB\r\nid: g" + std::to_string(i) +
+      "\r\nitem: {name: n" + std::to_string(i % 3) + ", value: -" +
+      std::to_string(i) + "}\r\ntype: B\r\n";
+  }
+  gay::Reader whole;
+  const std::vector<Read> expected = read(whole, input);
+  ASSERT_EQ(20u, expected.size());
+
+  gay::Reader reader;
+  std::vector<Read> groups;
+  auto handler = [&groups](const gaw::Group& group,
+    const gay::Names::Symbol& symbol)
+  {
+    groups.push_back(Read{ group.type, group.id.text(),
+      group.item.name.text(), group.item.text.text(), group.item.number,
+      symbol });
+  };
+  for (const char& c : input)
+  {
+    reader.feed(&c, 1, handler);
+  }
+  reader.finish(handler);
+  ASSERT_EQ(expected.size(), groups.size());
+  for (size_t i = 0; i < groups.size(); i++)
+  {
+    EXPECT_EQ("g" + std::to_string(i), groups[i].id);
+    EXPECT_EQ(expected[i].name, groups[i].name);
+    EXPECT_EQ(-static_cast<int>(i), groups[i].number);
+  }
+  EXPECT_EQ(3u, reader.names().size());
+}
+
+TEST(yaml, scalars)
+{
+  gay::Reader reader;
+  const std::vector<Read> groups = read(reader,
+    "# A comment\n"
+    "type: A # The type\n"
+    "id: 'it''s # not a comment'\n"
+    "item: {name: \"a, b\\t\\u00e6\", value: 'folded\n"
+    "  over lines'}\n"
+    "...\n"
+    "type: B\n"
+    "id: a plain id\n"
+    "  continued\n"
+    "item: {name: ~, value: +7}\n"
+    "---\n"
+    "type: A\n"
+    "id: null\n"
+    "item: null\n");
+  EXPECT_EQ(0u, reader.errors()) << reader.error();
+  ASSERT_EQ(3u, groups.size());
+  EXPECT_EQ("it's # not a comment", groups[0].id);
+  EXPECT_EQ("a, b\t\xc3\xa6", groups[0].name);
+  EXPECT_EQ("folded over lines", groups[0].text);
+  EXPECT_EQ("a plain id continued", groups[1].id);
+  EXPECT_EQ("", groups[1].name);
+  EXPECT_EQ(gay::Names::NoSymbol, groups[1].symbol);
+  EXPECT_EQ(7, groups[1].number);
+  EXPECT_EQ("", groups[2].id);
+  EXPECT_EQ("", groups[2].name);
+}
+
+TEST(yaml, malformed)
+{
+  /* A malformed document is skipped and the next one is read */
+  gay::Reader reader;
+  const std::vector<Read> groups = read(reader,
+    "id: 1\n"
+    "type: C\n"
+    "---\n"
+    "id: 2\n"
+    "item: {name: B, value: 93}\n"
+    "---\n"
+    "type: B\n"
+    "item: {name: B, value: ninety}\n"
+    "---\n"
+    "type: B\n"
+    "colour: red\n"
+    "---\n"
+    "!!gos.assumption.GroupA\n"
+    "type: B\n"
+    "---\n"
+    "type: A\n"
+    "id: 'open\n"
+    "---\n"
+    "id: 3\n"
+    "type: B\n");
+  EXPECT_EQ(6u, reader.errors());
+  ASSERT_EQ(1u, groups.size());
+  EXPECT_EQ("3", groups[0].id);
+  EXPECT_EQ(1u, reader.groups());
+
+  gay::Reader other;
+  read(other, "type: A\nitem:\n  name: A\n    value: 1\n  other: 2\n");
+  EXPECT_EQ(1u, other.errors());
+  EXPECT_EQ("Line 5: Unknown item key", other.error());
+}
+
+TEST(yaml, stream)
+{
+  std::ostringstream output;
+  for (int i = 0; i < 1000; i++)
+  {
+    output << "---\nid: '" << i << "'\nitem: {name: item" << i % 10 <<
+      ", value: " << i << "}\ntype: B\n";
+  }
+  std::istringstream input(output.str());
+  gay::Reader reader;
+  std::int64_t sum = 0;
+  reader.read(input, [&sum](const gaw::Group& group,
+    const gay::Names::Symbol&)
+  {
+    sum += group.item.number;
+  });
+  EXPECT_EQ(1000u, reader.groups());
+  EXPECT_EQ(999 * 1000 / 2, sum);
+  EXPECT_EQ(10u, reader.names().size());
+}
@@ -0,0 +1,166 @@
+package gos.assumption;
+
+import java.io.OutputStream;
+import java.nio.BufferUnderflowException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * The compact binary encoding of groups shared with the C++ side, see
+ * gos/assumption/wire.h. A message is one group, all the numbers are little
+ * endian: the size of the rest of the message as an int, the ordinal of the
+ * type as a byte, the id, the name of the item and the value of the item, a
+ * string for an A group and an int for a B group. A string is its length as
+ * an int and its UTF-8 bytes, a null string has the length -1. A group
+ * without an item ends after its id.
+ */
+public class BinarySerialization {
+
+	private static final int Null = -1;
+	private static final int SizeBytes = 4;
+
+	public byte[] Serialize(Group group) throws Exception {
+		Type type = group.getType();
+		if (type == null) {
+			throw new Exception("Unable to serialize group without a type");
+		}
+		byte[] id = Encode(group.getId());
+		Item item;
+		switch (type) {
+		case A:
+			if (!(group instanceof GroupA)) {
+				throw new Exception("Group is not a instance of GroupA");
+			}
+			item = ((GroupA) group).getItem();
+			break;
+		case B:
+			if (!(group instanceof GroupB)) {
+				throw new Exception("Group is not a instance of GroupB");
+			}
+			item = ((GroupB) group).getItem();
+			break;
+		default:
+			throw new Exception(
+			    "Unable to serialize group of type " + type.toString());
+		}
+		byte[] name = null;
+		byte[] value = null;
+		int size = 1 + Length(id);
+		if (item != null) {
+			name = Encode(item.getName());
+			size += Length(name);
+			if (type == Type.A) {
+				value = Encode(((ItemA) item).getValue());
+				size += Length(value);
+			} else {
+				size += 4;
+			}
+		}
+		ByteBuffer buffer = ByteBuffer.allocate(SizeBytes + size)
+		    .order(ByteOrder.LITTLE_ENDIAN);
+		buffer.putInt(size);
+		buffer.put((byte) type.ordinal());
+		Put(buffer, id);
+		if (item != null) {
+			Put(buffer, name);
+			if (type == Type.A) {
+				Put(buffer, value);
+			} else {
+				buffer.putInt(((ItemB) item).getValue());
+			}
+		}
+		return buffer.array();
+	}
+
+	public void Serialize(Group group, OutputStream stream) throws Exception {
+		stream.write(Serialize(group));
+	}
+
+	public Group Deserialize(byte[] input) throws Exception {
+		ByteBuffer buffer = ByteBuffer.wrap(input);
+		Group group = Deserialize(buffer);
+		if (buffer.hasRemaining()) {
+			throw new Exception("Bytes after the group");
+		}
+		return group;
+	}
+
+	/**
+	 * Deserialize the message at the position of a buffer and move the
+	 * position after it.
+	 */
+	public Group Deserialize(ByteBuffer buffer) throws Exception {
+		ByteOrder order = buffer.order();
+		buffer.order(ByteOrder.LITTLE_ENDIAN);
+		try {
+			int size = buffer.getInt();
+			if (size < 1 || size > buffer.remaining()) {
+				throw new Exception("Truncated group");
+			}
+			ByteBuffer message = buffer.slice().order(ByteOrder.LITTLE_ENDIAN);
+			message.limit(size);
+			buffer.position(buffer.position() + size);
+			int ordinal = message.get();
+			if (ordinal < 0 || ordinal >= Type.values().length) {
+				throw new Exception(
+				    "Unable to deserialize group of type " + ordinal);
+			}
+			Type type = Type.values()[ordinal];
+			String id = Get(message);
+			Group group;
+			if (type == Type.A) {
+				ItemA item = null;
+				if (message.hasRemaining()) {
+					item = new ItemA(Get(message), Get(message));
+				}
+				group = new GroupA(id, item);
+			} else {
+				ItemB item = null;
+				if (message.hasRemaining()) {
+					item = new ItemB(Get(message), message.getInt());
+				}
+				group = new GroupB(id, item);
+			}
+			if (message.hasRemaining()) {
+				throw new Exception("Bytes after the item");
+			}
+			return group;
+		} catch (BufferUnderflowException exception) {
+			throw new Exception("Truncated group", exception);
+		} finally {
+			buffer.order(order);
+		}
+	}
+
+	private static byte[] Encode(String text) {
+		return text != null ? text.getBytes(StandardCharsets.UTF_8) : null;
+	}
+
+	private static int Length(byte[] bytes) {
+		return 4 + (bytes != null ? bytes.length : 0);
+	}
+
+	private static void Put(ByteBuffer buffer, byte[] bytes) {
+		if (bytes == null) {
+			buffer.putInt(Null);
+		} else {
+			buffer.putInt(bytes.length);
+			buffer.put(bytes);
+		}
+	}
+
+	private static String Get(ByteBuffer buffer) throws Exception {
+		int length = buffer.getInt();
+		if (length == Null) {
+			return null;
+		}
+		if (length < 0 || length > buffer.remaining()) {
+			throw new Exception("Truncated string");
+		}
+		byte[] bytes = new byte[length];
+		buffer.get(bytes);
+		return new String(bytes, StandardCharsets.UTF_8);
+	}
+
+}
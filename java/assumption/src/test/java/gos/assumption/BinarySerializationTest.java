@@ -0,0 +1,127 @@
+package gos.assumption;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+public class BinarySerializationTest {
+
+  /* The bytes the C++ tests in cpp/tests/wire.cpp expect as well */
+  private static final byte[] GroupABytes = {
+    0x17, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, '1', '2', '3',
+    0x01, 0x00, 0x00, 0x00, 'A',
+    0x06, 0x00, 0x00, 0x00, 'I', 't', 'e', 'm', ' ', 'A' };
+  private static final byte[] GroupBBytes = {
+    0x11, 0x00, 0x00, 0x00, 0x01,
+    0x03, 0x00, 0x00, 0x00, '3', '4', '5',
+    0x01, 0x00, 0x00, 0x00, 'B',
+    0x5d, 0x00, 0x00, 0x00 };
+
+  @Test
+  public void testSerialize() throws Exception {
+  	BinarySerialization serialization;
+  	ByteArrayOutputStream stream;
+    
+    serialization = new BinarySerialization();
+    assertArrayEquals(GroupABytes,
+        serialization.Serialize(new GroupA("123", new ItemA("A", "Item A"))));
+    
+    stream = new ByteArrayOutputStream();
+    serialization.Serialize(new GroupB("345", new ItemB("B", 93)), stream);
+    assertArrayEquals(GroupBBytes, stream.toByteArray());
+  }
+
+  @Test
+  public void testDeserialize() throws Exception {
+  	BinarySerialization serialization;
+  	Group group;
+  	GroupA groupa;
+  	GroupB groupb;
+  	ByteBuffer buffer;
+    
+    serialization = new BinarySerialization();
+    buffer = ByteBuffer.allocate(GroupABytes.length + GroupBBytes.length);
+    buffer.put(GroupABytes).put(GroupBBytes).flip();
+    
+    group = serialization.Deserialize(buffer);
+    assertEquals(Type.A, group.getType());
+    assertEquals("123", group.getId());
+    assertTrue(group instanceof GroupA);
+    groupa = (GroupA)group;
+    assertEquals("A", groupa.getItem().getName());
+    assertEquals("Item A", groupa.getItem().getValue());
+    
+    group = serialization.Deserialize(buffer);
+    assertEquals(Type.B, group.getType());
+    assertEquals("345", group.getId());
+    assertTrue(group instanceof GroupB);
+    groupb = (GroupB)group;
+    assertEquals("B", groupb.getItem().getName());
+    assertEquals(93, groupb.getItem().getValue());
+    assertEquals(0, buffer.remaining());
+  }
+
+  @Test
+  public void testNull() throws Exception {
+  	BinarySerialization serialization;
+  	GroupA groupa;
+  	GroupB groupb;
+    
+    serialization = new BinarySerialization();
+    groupb = (GroupB)serialization.Deserialize(
+        serialization.Serialize(new GroupB("bare", null)));
+    assertEquals("bare", groupb.getId());
+    assertNull(groupb.getItem());
+    
+    groupa = (GroupA)serialization.Deserialize(
+        serialization.Serialize(new GroupA(null, new ItemA("\u00e6", null))));
+    assertNull(groupa.getId());
+    assertEquals("\u00e6", groupa.getItem().getName());
+    assertNull(groupa.getItem().getValue());
+    
+    assertThrows(Exception.class, () -> serialization.Serialize(new Group()));
+  }
+
+  @Test
+  public void testMalformed() throws Exception {
+  	BinarySerialization serialization;
+  	byte[] bytes;
+    
+    serialization = new BinarySerialization();
+    for (int size = 0; size < GroupABytes.length; size++) {
+      final byte[] truncated = Arrays.copyOf(GroupABytes, size);
+      assertThrows(Exception.class,
+          () -> serialization.Deserialize(truncated));
+    }
+    final byte[] type = GroupBBytes.clone();
+    type[4] = 2;
+    assertThrows(Exception.class, () -> serialization.Deserialize(type));
+    bytes = Arrays.copyOf(GroupBBytes, GroupBBytes.length + 1);
+    final byte[] trailing = bytes;
+    assertThrows(Exception.class, () -> serialization.Deserialize(trailing));
+  }
+
+  @Test
+  public void testCompact() throws Exception {
+  	Serialization yaml;
+  	BinarySerialization binary;
+  	Group group;
+    
+    yaml = new Serialization();
+    binary = new BinarySerialization();
+    group = new GroupB("345", new ItemB("B", 93));
+    assertTrue(binary.Serialize(group).length <
+        yaml.Serialize(group).getBytes(StandardCharsets.UTF_8).length);
+  }
+
+}